@@ -0,0 +1,333 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 分配计数只在 *_alloc 版本中启用（见 bench/CMakeLists.txt），计时版本不替换 malloc / operator new
+#ifdef HARNESS_ENABLE_ALLOC_COUNTER
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#endif
+#include "harness/alloc_counter.h"
+#include "harness/arrow_export.h"
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 查询结果转换为 Arrow 列存的性能测试：
+ *   row_N   —— 逐行 next + is_null(i) + 按列类型分支调用 get_value<T>(i)，
+ *              每 N 行转换为 Arrow 布局的列（有效位图、BOOLEAN 按位、DATE 转天数、字符串偏移和字节区）
+ *   arrow_N —— harness/arrow_export.h 的 ArrowArrayStream，每次 get_next 取得 N 行的 ArrowArray
+ * 两种方式都按 Arrow 的缓冲区逐列遍历并计算相同的校验和（模拟下游消费），校验和不一致时退出并返回 1。
+ * 输出 rows/s、cells/s、相对 row_N 的加速比；读取阶段每行的分配次数（allocs/row，见 harness/alloc_counter.h）
+ * 只在 bench_arrow_export_alloc 中输出，bench_arrow_export 不统计分配，耗时和加速比以该版本为准。
+ *
+ * 参数：
+ *   --rows=1000000 --tags=2 --fields=10 --type=MIXED --tag-cardinality=100
+ *   --null-rate=0.1             FIELD 列空值比例
+ *   --batch-rows=1024,8192      每批行数（逗号分隔时依次测试）
+ *   --repeat=3                  每种方式重复次数
+ */
+
+// 一列的 Arrow 缓冲区：validity 为空表示无空值，BOOLEAN 的 values 按位存放
+struct ArrowColumnView {
+    TSDataType type;
+    const uint8_t* validity;
+    const void* values;      // 定长值或变长列的 int32 偏移
+    const char* data;        // 变长列的字节区
+};
+
+// 一次读取的统计
+struct ArrowScanResult {
+    int64_t rows = 0;
+    int64_t cells = 0;
+    uint64_t checksum = 0;
+    double scan_s = 0;
+    harness::AllocStats allocs;
+};
+
+// 按 Arrow 布局遍历一列并累加校验和
+void consume_column(const ArrowColumnView& column, int64_t length, uint64_t& checksum) {
+    for (int64_t r = 0; r < length; r++) {
+        if (column.validity != nullptr && !((column.validity[r >> 3] >> (r & 7)) & 1)) {
+            continue;
+        }
+        switch (column.type) {
+            case BOOLEAN:
+                harness::checksum_mix(checksum,
+                                      (static_cast<const uint8_t*>(column.values)[r >> 3] >> (r & 7)) & 1);
+                break;
+            case DATE:
+            case INT32:
+                harness::checksum_mix(checksum, static_cast<const int32_t*>(column.values)[r]);
+                break;
+            case TIMESTAMP:
+            case INT64:
+                harness::checksum_mix(checksum, static_cast<const int64_t*>(column.values)[r]);
+                break;
+            case FLOAT:
+                harness::checksum_mix(checksum, static_cast<const float*>(column.values)[r]);
+                break;
+            case DOUBLE:
+                harness::checksum_mix(checksum, static_cast<const double*>(column.values)[r]);
+                break;
+            default: {
+                const int32_t* offsets = static_cast<const int32_t*>(column.values);
+                harness::checksum_mix(checksum, offsets[r + 1] - offsets[r]);
+                if (offsets[r + 1] > offsets[r]) {
+                    harness::checksum_mix(checksum, column.data[offsets[r]]);
+                }
+                break;
+            }
+        }
+    }
+}
+
+// 逐行转换得到的一列（Arrow 布局）
+struct RowBuiltColumn {
+    vector<uint8_t> validity;
+    vector<uint8_t> values;
+    vector<int32_t> offsets;
+    vector<char> data;
+};
+
+// 逐行调用 get_value<T> 转换为 Arrow 布局，每 batch_rows 行遍历一次
+int scan_rows(TableResultSet* ret, uint32_t batch_rows, ArrowScanResult& result) {
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    vector<TSDataType> types;
+    for (uint32_t i = 1; i <= column_count; i++) {
+        types.push_back(metadata->get_column_type(i));
+    }
+    vector<RowBuiltColumn> columns(column_count);
+    auto flush = [&](uint32_t rows) {
+        for (uint32_t c = 0; c < column_count; c++) {
+            RowBuiltColumn& column = columns[c];
+            consume_column({types[c], column.validity.data(),
+                            column.offsets.empty() ? static_cast<const void*>(column.values.data())
+                                                   : column.offsets.data(),
+                            column.data.data()},
+                           rows, result.checksum);
+            column.validity.clear();
+            column.values.clear();
+            column.data.clear();
+            column.offsets.assign(column.offsets.empty() ? 0 : 1, 0);
+        }
+        result.rows += rows;
+        result.cells += static_cast<int64_t>(rows) * (column_count - 1);
+    };
+    for (uint32_t c = 0; c < column_count; c++) {
+        if (harness::ColumnBatch::value_width(types[c]) == 0) {
+            columns[c].offsets.push_back(0);
+        }
+    }
+    bool has_next = false;
+    int code = E_OK;
+    uint32_t row = 0;
+    while ((code = ret->next(has_next)) == E_OK && has_next) {
+        for (uint32_t i = 1; i <= column_count; i++) {
+            RowBuiltColumn& column = columns[i - 1];
+            if (row % 8 == 0) {
+                column.validity.push_back(0);
+                if (types[i - 1] == BOOLEAN) {
+                    column.values.push_back(0);
+                }
+            }
+            bool is_null = ret->is_null(i);
+            if (!is_null) {
+                column.validity.back() |= static_cast<uint8_t>(1u << (row & 7));
+            }
+            switch (types[i - 1]) {
+                case BOOLEAN:
+                    if (!is_null && ret->get_value<bool>(i)) {
+                        column.values.back() |= static_cast<uint8_t>(1u << (row & 7));
+                    }
+                    break;
+                case DATE: {
+                    int32_t days = is_null ? 0 : harness::date_to_epoch_days(ret->get_value<int32_t>(i));
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&days);
+                    column.values.insert(column.values.end(), bytes, bytes + sizeof(days));
+                    break;
+                }
+                case INT32: {
+                    int32_t value = is_null ? 0 : ret->get_value<int32_t>(i);
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                    column.values.insert(column.values.end(), bytes, bytes + sizeof(value));
+                    break;
+                }
+                case TIMESTAMP:
+                case INT64: {
+                    int64_t value = is_null ? 0 : ret->get_value<int64_t>(i);
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                    column.values.insert(column.values.end(), bytes, bytes + sizeof(value));
+                    break;
+                }
+                case FLOAT: {
+                    float value = is_null ? 0 : ret->get_value<float>(i);
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                    column.values.insert(column.values.end(), bytes, bytes + sizeof(value));
+                    break;
+                }
+                case DOUBLE: {
+                    double value = is_null ? 0 : ret->get_value<double>(i);
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                    column.values.insert(column.values.end(), bytes, bytes + sizeof(value));
+                    break;
+                }
+                default: {
+                    if (!is_null) {
+                        common::String* value = ret->get_value<common::String*>(i);
+                        column.data.insert(column.data.end(), value->buf_, value->buf_ + value->len_);
+                    }
+                    column.offsets.push_back(static_cast<int32_t>(column.data.size()));
+                    break;
+                }
+            }
+        }
+        if (++row == batch_rows) {
+            flush(row);
+            row = 0;
+        }
+    }
+    if (row > 0) {
+        flush(row);
+    }
+    return code;
+}
+
+// 从 ArrowArrayStream 逐批取得 ArrowArray 并遍历
+int scan_arrow(TableResultSet* ret, uint32_t batch_rows, ArrowScanResult& result) {
+    ArrowArrayStream stream;
+    harness::export_arrow_stream(ret, batch_rows, &stream);
+    ArrowSchema schema;
+    int code = stream.get_schema(&stream, &schema);
+    if (code != 0) {
+        stream.release(&stream);
+        return code;
+    }
+    vector<TSDataType> types;
+    auto metadata = ret->get_metadata();
+    for (uint32_t i = 1; i <= metadata->get_column_count(); i++) {
+        types.push_back(metadata->get_column_type(i));
+    }
+    while (true) {
+        ArrowArray array;
+        if ((code = stream.get_next(&stream, &array)) != 0 || array.release == nullptr) {
+            break;
+        }
+        for (int64_t c = 0; c < array.n_children; c++) {
+            const ArrowArray* child = array.children[c];
+            consume_column({types[c], static_cast<const uint8_t*>(child->buffers[0]),
+                            child->buffers[1],
+                            child->n_buffers > 2 ? static_cast<const char*>(child->buffers[2]) : nullptr},
+                           child->length, result.checksum);
+        }
+        result.rows += array.length;
+        result.cells += array.length * (array.n_children - 1);
+        array.release(&array);
+    }
+    schema.release(&schema);
+    stream.release(&stream);
+    return code;
+}
+
+// 打开文件并按指定方式读取全表
+int run_scan(const string& file_path, const string& table_name, const vector<string>& columns,
+             bool arrow, uint32_t batch_rows, ArrowScanResult& result) {
+    TsFileReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    ret = reader.query(table_name, columns, INT64_MIN, INT64_MAX, temp_ret);
+    if (ret == E_OK) {
+        auto* table_ret = dynamic_cast<TableResultSet*>(temp_ret);
+        harness::AllocStats before = harness::AllocCounter::snapshot();
+        harness::Stopwatch watch;
+        ret = arrow ? scan_arrow(table_ret, batch_rows, result)
+                    : scan_rows(table_ret, batch_rows, result);
+        result.scan_s = watch.elapsed_s();
+        result.allocs = harness::AllocCounter::snapshot().since(before);
+        table_ret->close();
+    }
+    reader.close();
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 1000000);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "MIXED");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    config.null_rate = args.get_double("null-rate", 0.1);
+    vector<int64_t> batch_rows_list = args.get_int_list("batch-rows", {1024, 8192});
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string file_path = harness::resolve_data_path("bench_arrow_export.tsfile");
+    harness::TableDatasetStats write_stats;
+    int ret = harness::write_table_dataset(file_path, config, write_stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::dataset_schema(config).column_names;
+
+    bool alloc_columns = harness::AllocCounter::installed();
+    printf("rows=%lld columns=%zu type=%s null_rate=%.2f alloc_counter=%s\n",
+           (long long)config.rows, columns.size(), config.type_name.c_str(), config.null_rate,
+           alloc_columns ? "on" : "off");
+    printf("%-12s %-6s %10s %14s %14s %10s", "mode", "round", "scan_s", "rows/s", "cells/s",
+           "speedup");
+    if (alloc_columns) {
+        printf(" %12s", "allocs/row");
+    }
+    printf("\n");
+    for (int64_t batch_rows : batch_rows_list) {
+        uint32_t rows = static_cast<uint32_t>(max<int64_t>(1, batch_rows));
+        double row_rate = 0;
+        uint64_t expected_checksum = 0;
+        for (bool arrow : {false, true}) {
+            string mode = (arrow ? "arrow_" : "row_") + to_string(rows);
+            for (int64_t round = 0; round < repeat; round++) {
+                ArrowScanResult result;
+                ret = run_scan(file_path, config.table_name, columns, arrow, rows, result);
+                if (ret != E_OK) {
+                    cerr << mode << " scan failed, error code: " << ret << endl;
+                    return ret;
+                }
+                double rate = harness::per_second(result.rows, result.scan_s);
+                if (!arrow) {
+                    row_rate = max(row_rate, rate);
+                    expected_checksum = result.checksum;
+                } else if (result.checksum != expected_checksum) {
+                    cerr << mode << ": checksum mismatch" << endl;
+                    return 1;
+                }
+                printf("%-12s %-6lld %10.3f %14.0f %14.0f %10.2f", mode.c_str(), (long long)round,
+                       result.scan_s, rate, harness::per_second(result.cells, result.scan_s),
+                       row_rate > 0 ? rate / row_rate : 0);
+                if (alloc_columns) {
+                    printf(" %12.3f", result.allocs.allocations /
+                                          static_cast<double>(max<int64_t>(1, result.rows)));
+                }
+                printf("\n");
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "common/db_common.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "writer/tsfile_table_writer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "harness/async_writer.h"
+#include "harness/bench_util.h"
+#include "harness/table_dataset.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 单生产线程写入：同步写入与异步写入（AsyncTableWriter）对比
+ *   sync      —— 填充 tablet 后在同一线程调用 write_table
+ *   async_N   —— 填充后提交到深度为 N 的队列，由后台线程写入，填充与写入重叠
+ *
+ * 参数：
+ *   --rows=4000000 --tags=2 --fields=10 --type=INT64 --tag-cardinality=100 --tablet-rows=1024
+ *   --queue-depth=1,2,4         异步写入的队列深度（逗号分隔时依次测试）
+ *   --repeat=3                  每种方式重复次数
+ */
+
+// 一次写入的统计
+struct WriteResult {
+    double elapsed_s = 0;   // 从开始填充到 close 完成
+    double fill_s = 0;      // 生产线程填充 tablet 的耗时
+    double wait_s = 0;      // 生产线程等待（同步：write_table；异步：队列满和取得 tablet）
+    uint64_t file_bytes = 0;
+};
+
+int run_write(const string& file_path, const harness::TableDatasetConfig& config,
+              int64_t queue_depth, WriteResult& result) {
+    harness::TableDatasetSchema dataset = harness::dataset_schema(config);
+    vector<TSDataType> field_types = harness::dataset_field_types(config);
+    harness::DatasetValuePool pool = harness::dataset_value_pool(config);
+
+    WriteFile file;
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    mode_t mode = 0666;
+    int ret = file.create(file_path, flags, mode);
+    if (ret != E_OK) {
+        return ret;
+    }
+    auto* schema = new TableSchema(config.table_name, dataset.column_schemas);
+    auto* writer = new TsFileTableWriter(&file, schema, config.memory_threshold);
+    auto make_tablet = [&](int64_t rows) {
+        return unique_ptr<Tablet>(new Tablet(config.table_name, dataset.column_names,
+                                             dataset.data_types, dataset.column_categories,
+                                             static_cast<int>(rows)));
+    };
+    auto factory = [&]() { return make_tablet(config.tablet_rows); };
+
+    harness::Stopwatch total;
+    harness::Stopwatch watch;
+    if (queue_depth == 0) {
+        for (int64_t start = 0; start < config.rows && ret == E_OK; start += config.tablet_rows) {
+            int64_t rows = min(config.tablet_rows, config.rows - start);
+            unique_ptr<Tablet> tablet = make_tablet(rows);
+            watch.reset();
+            ret = harness::dataset_fill_tablet(*tablet, config, pool, field_types, start, rows);
+            result.fill_s += watch.elapsed_s();
+            if (ret == E_OK) {
+                watch.reset();
+                ret = writer->write_table(*tablet);
+                result.wait_s += watch.elapsed_s();
+            }
+        }
+        if (ret == E_OK) {
+            ret = writer->flush();
+        }
+    } else {
+        harness::AsyncTableWriter async_writer(writer, factory, static_cast<size_t>(queue_depth));
+        for (int64_t start = 0; start < config.rows && ret == E_OK; start += config.tablet_rows) {
+            int64_t rows = min(config.tablet_rows, config.rows - start);
+            // 最后一个不满的 tablet 按实际行数创建
+            unique_ptr<Tablet> tablet =
+                rows == config.tablet_rows ? async_writer.acquire() : make_tablet(rows);
+            watch.reset();
+            ret = harness::dataset_fill_tablet(*tablet, config, pool, field_types, start, rows);
+            result.fill_s += watch.elapsed_s();
+            if (ret == E_OK) {
+                // 写入错误由 close 返回，不逐个等待 future
+                async_writer.submit(std::move(tablet));
+            }
+        }
+        if (ret == E_OK) {
+            ret = async_writer.flush().get();
+        }
+        int close_ret = async_writer.close();
+        ret = ret == E_OK ? close_ret : ret;
+        harness::AsyncWriterStats stats = async_writer.stats();
+        result.wait_s = stats.submit_wait_s + stats.acquire_wait_s;
+    }
+    if (ret == E_OK) {
+        ret = writer->close();
+    }
+    result.elapsed_s = total.elapsed_s();
+    delete writer;
+    delete schema;
+    result.file_bytes = harness::file_size_bytes(file_path);
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 4000000);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    vector<int64_t> depths = args.get_int_list("queue-depth", {1, 2, 4});
+    int64_t repeat = args.get_int("repeat", 3);
+    string file_path = harness::resolve_data_path("bench_async_write.tsfile");
+
+    printf("rows=%lld tags=%lld fields=%lld type=%s tablet_rows=%lld\n", (long long)config.rows,
+           (long long)config.tag_count, (long long)config.field_count, config.type_name.c_str(),
+           (long long)config.tablet_rows);
+    printf("%-10s %-6s %10s %10s %10s %14s %10s %10s\n", "mode", "round", "elapsed_s", "fill_s",
+           "wait_s", "rows/s", "file_mb", "speedup");
+    // 同步写入作为基准
+    double sync_rate = 0;
+    vector<int64_t> modes = {0};
+    modes.insert(modes.end(), depths.begin(), depths.end());
+    for (int64_t depth : modes) {
+        string mode = depth == 0 ? "sync" : "async_" + to_string(depth);
+        for (int64_t round = 0; round < repeat; round++) {
+            WriteResult result;
+            int ret = run_write(file_path, config, depth, result);
+            if (ret != E_OK) {
+                cerr << mode << " write failed, error code: " << ret << endl;
+                return ret;
+            }
+            double rate = harness::per_second(config.rows, result.elapsed_s);
+            if (depth == 0) {
+                sync_rate = max(sync_rate, rate);
+            }
+            printf("%-10s %-6lld %10.3f %10.3f %10.3f %14.0f %10.2f %10.2f\n", mode.c_str(),
+                   (long long)round, result.elapsed_s, result.fill_s, result.wait_s, rate,
+                   harness::to_mb(result.file_bytes), sync_rate > 0 ? rate / sync_rate : 0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,311 @@
+#include "common/db_common.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "reader/tsfile_reader.h"
+#include "writer/tsfile_table_writer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/data_generator.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 编码方式 × 压缩方式矩阵性能测试：对每种数据类型、每种数据形态，依次以每组
+ * （编码，压缩）写入一个单 FIELD 列的表并读回，输出每个点占用的字节数、编码 MB/s 和解码 MB/s
+ *
+ * bytes/point 按文件大小计算，包含时间列和元数据（各组合相同），用于比较组合之间的相对大小；
+ * MB/s 按原始数据大小（定长类型按类型宽度，变长类型按字符串长度）计算，
+ * 编码耗时为 write_table + flush + close，解码耗时为 query + 按列批量读取全部数据。
+ * 写入或读取返回错误时该组合输出为 unsupported 及错误码。
+ *
+ * 参数：
+ *   --types=INT32,INT64,FLOAT,DOUBLE,BOOLEAN,STRING   数据类型
+ *   --shapes=COUNTER,RANDOM_WALK,PERIODIC,LOW_CARDINALITY   数据形态，见 data_generator.h
+ *   --encodings=                每种类型测试的编码方式，不指定时按类型选择候选编码
+ *   --compressions=UNCOMPRESSED,SNAPPY,GZIP,LZO,LZ4   压缩方式
+ *   --points=1000000            每组写入的点数（所有设备合计）
+ *   --devices=10                设备数量，每个设备连续写入 points / devices 个点
+ *   --tablet-rows=1024          每个 tablet 的行数
+ *   --seed=42                   数据生成器的随机种子
+ *   --json=path                 同时以 JSON 数组输出结果到指定文件
+ */
+
+// 一组（类型，形态，编码，压缩）的结果
+struct CodecResult {
+    string type;
+    string shape;
+    string encoding;
+    string compression;
+    int code = E_OK;
+    int64_t points = 0;
+    uint64_t raw_bytes = 0;
+    uint64_t file_bytes = 0;
+    double encode_s = 0;
+    double decode_s = 0;
+};
+
+// 按数据类型选择候选编码
+vector<TSEncoding> candidate_encodings(TSDataType type) {
+    switch (type) {
+        case TSDataType::INT32:
+        case TSDataType::INT64:
+        case TSDataType::DATE:
+        case TSDataType::TIMESTAMP:
+            return {TSEncoding::PLAIN, TSEncoding::TS_2DIFF, TSEncoding::GORILLA,
+                    TSEncoding::ZIGZAG, TSEncoding::RLE};
+        case TSDataType::FLOAT:
+        case TSDataType::DOUBLE:
+            return {TSEncoding::PLAIN, TSEncoding::TS_2DIFF, TSEncoding::GORILLA};
+        case TSDataType::BOOLEAN:
+            return {TSEncoding::PLAIN, TSEncoding::RLE};
+        default:
+            return {TSEncoding::PLAIN, TSEncoding::DICTIONARY};
+    }
+}
+
+// 原始数据中一个值的字节数，变长类型返回 0
+uint64_t raw_value_width(TSDataType type) {
+    switch (type) {
+        case TSDataType::BOOLEAN:
+            return 1;
+        case TSDataType::INT32:
+        case TSDataType::DATE:
+        case TSDataType::FLOAT:
+            return 4;
+        case TSDataType::INT64:
+        case TSDataType::TIMESTAMP:
+        case TSDataType::DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// 以指定编码和压缩写入数据，记录编码耗时、原始数据大小和文件大小
+int write_codec(const string& file_path, TSDataType type, const harness::ColumnGenSpec& spec,
+                TSEncoding encoding, CompressionType compression, int64_t points,
+                int64_t devices, int64_t tablet_rows, uint64_t seed, CodecResult& result) {
+    string table_name = "codec_table";
+    vector<string> column_names = {"device", "value"};
+    vector<TSDataType> data_types = {TSDataType::STRING, type};
+    vector<ColumnCategory> column_categories = {ColumnCategory::TAG, ColumnCategory::FIELD};
+    vector<ColumnSchema> column_schemas = {
+        ColumnSchema(column_names[0], data_types[0], ColumnCategory::TAG),
+        ColumnSchema(column_names[1], type, compression, encoding, ColumnCategory::FIELD),
+    };
+
+    WriteFile file;
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    mode_t mode = 0666;
+    int ret = file.create(file_path, flags, mode);
+    if (ret != E_OK) {
+        return ret;
+    }
+    auto* schema = new TableSchema(table_name, column_schemas);
+    auto* writer = new TsFileTableWriter(&file, schema);
+    uint64_t width = raw_value_width(type);
+    int64_t per_device = points / devices;
+
+    for (int64_t d = 0; d < devices && ret == E_OK; d++) {
+        // 每个设备一个生成器，设备内的序列连续
+        harness::ColumnGenerator generator(type, spec, seed + static_cast<uint64_t>(d));
+        string device = "device_" + to_string(d);
+        for (int64_t start = 0; start < per_device && ret == E_OK; start += tablet_rows) {
+            int64_t rows = min(tablet_rows, per_device - start);
+            Tablet tablet(table_name, column_names, data_types, column_categories,
+                          static_cast<int>(rows));
+            for (int64_t r = 0; r < rows && ret == E_OK; r++) {
+                uint32_t row = static_cast<uint32_t>(r);
+                ret = tablet.add_timestamp(row, start + r);
+                if (ret == E_OK) {
+                    ret = tablet.add_value(row, 0u, device.c_str());
+                }
+                if (ret == E_OK) {
+                    ret = generator.fill(tablet, row, 1u);
+                }
+                result.raw_bytes += width > 0 ? width : generator.text_value().size();
+            }
+            harness::Stopwatch watch;
+            if (ret == E_OK) {
+                ret = writer->write_table(tablet);
+            }
+            result.encode_s += watch.elapsed_s();
+        }
+    }
+    harness::Stopwatch watch;
+    if (ret == E_OK) {
+        ret = writer->flush();
+    }
+    if (ret == E_OK) {
+        ret = writer->close();
+    }
+    result.encode_s += watch.elapsed_s();
+    delete writer;
+    delete schema;
+    result.points = per_device * devices;
+    result.file_bytes = harness::file_size_bytes(file_path);
+    return ret;
+}
+
+// 读回全部数据，记录解码耗时并校验点数
+int read_codec(const string& file_path, CodecResult& result) {
+    TsFileReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    harness::Stopwatch watch;
+    ret = reader.query("codec_table", {"device", "value"}, INT64_MIN, INT64_MAX, temp_ret);
+    harness::ScanStats stats;
+    if (ret == E_OK) {
+        auto* table_ret = dynamic_cast<TableResultSet*>(temp_ret);
+        harness::ColumnBatchReader batch_reader(table_ret);
+        harness::ColumnBatch batch = batch_reader.create_batch(4096);
+        while ((ret = batch_reader.next_batch(batch)) == E_OK && batch.row_count() > 0) {
+            harness::scan_column_batch(batch, stats);
+        }
+        table_ret->close();
+    }
+    result.decode_s = watch.elapsed_s();
+    reader.close();
+    if (ret == E_OK && stats.rows != result.points) {
+        cerr << "point count mismatch, expected " << result.points << ", got " << stats.rows
+             << endl;
+        ret = -1;
+    }
+    return ret;
+}
+
+void print_result(const CodecResult& result) {
+    printf("%-10s %-16s %-12s %-13s ", result.type.c_str(), result.shape.c_str(),
+           result.encoding.c_str(), result.compression.c_str());
+    if (result.code != E_OK) {
+        printf("unsupported (error code: %d)\n", result.code);
+        return;
+    }
+    double raw_mb = harness::to_mb(result.raw_bytes);
+    printf("%12.3f %10.3f %12.2f %12.2f\n",
+           static_cast<double>(result.file_bytes) / result.points,
+           static_cast<double>(result.raw_bytes) / result.file_bytes,
+           harness::per_second(raw_mb, result.encode_s),
+           harness::per_second(raw_mb, result.decode_s));
+}
+
+// 以 JSON 数组输出全部结果
+void write_json(const string& path, const vector<CodecResult>& results) {
+    FILE* out = fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        cerr << "open json file failed: " << path << endl;
+        return;
+    }
+    fprintf(out, "[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const CodecResult& r = results[i];
+        double raw_mb = harness::to_mb(r.raw_bytes);
+        fprintf(out,
+                "  {\"type\": \"%s\", \"shape\": \"%s\", \"encoding\": \"%s\", "
+                "\"compression\": \"%s\", \"error_code\": %d, \"points\": %lld, "
+                "\"raw_bytes\": %llu, \"file_bytes\": %llu, \"bytes_per_point\": %.4f, "
+                "\"encode_mb_s\": %.3f, \"decode_mb_s\": %.3f}%s\n",
+                r.type.c_str(), r.shape.c_str(), r.encoding.c_str(), r.compression.c_str(),
+                r.code, (long long)r.points, (unsigned long long)r.raw_bytes,
+                (unsigned long long)r.file_bytes,
+                r.points > 0 ? static_cast<double>(r.file_bytes) / r.points : 0,
+                r.code == E_OK ? harness::per_second(raw_mb, r.encode_s) : 0,
+                r.code == E_OK ? harness::per_second(raw_mb, r.decode_s) : 0,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "]\n");
+    fclose(out);
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    vector<string> type_names =
+        args.get_string_list("types", {"INT32", "INT64", "FLOAT", "DOUBLE", "BOOLEAN", "STRING"});
+    vector<string> shape_names = args.get_string_list(
+        "shapes", {"COUNTER", "RANDOM_WALK", "PERIODIC", "LOW_CARDINALITY"});
+    vector<string> encoding_names = args.get_string_list("encodings", {});
+    vector<string> compression_names =
+        args.get_string_list("compressions", {"UNCOMPRESSED", "SNAPPY", "GZIP", "LZO", "LZ4"});
+    int64_t devices = max<int64_t>(1, args.get_int("devices", 10));
+    int64_t points = max<int64_t>(devices, args.get_int("points", 1000000));
+    int64_t tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    uint64_t seed = static_cast<uint64_t>(args.get_int("seed", 42));
+    string json_path = args.get_string("json", "");
+
+    vector<TSEncoding> encoding_override;
+    for (const auto& name : encoding_names) {
+        TSEncoding encoding = harness::string_to_encoding(name);
+        if (encoding == TSEncoding::INVALID_ENCODING) {
+            cerr << "Unsupported encoding: " << name << endl;
+            return 1;
+        }
+        encoding_override.push_back(encoding);
+    }
+    vector<CompressionType> compressions;
+    for (const auto& name : compression_names) {
+        CompressionType compression = harness::string_to_compression(name);
+        if (compression == CompressionType::INVALID_COMPRESSION) {
+            cerr << "Unsupported compression: " << name << endl;
+            return 1;
+        }
+        compressions.push_back(compression);
+    }
+
+    string file_path = harness::resolve_data_path("bench_codec_matrix.tsfile");
+    printf("points=%lld devices=%lld tablet_rows=%lld seed=%llu\n", (long long)points,
+           (long long)devices, (long long)tablet_rows, (unsigned long long)seed);
+    printf("%-10s %-16s %-12s %-13s %12s %10s %12s %12s\n", "type", "shape", "encoding",
+           "compression", "bytes/point", "ratio", "encode_MB/s", "decode_MB/s");
+    vector<CodecResult> results;
+    for (const auto& type_name : type_names) {
+        TSDataType type = harness::string_to_datatype(type_name);
+        if (type == TSDataType::INVALID_DATATYPE) {
+            cerr << "Unsupported data type: " << type_name << endl;
+            return 1;
+        }
+        for (const auto& shape_name : shape_names) {
+            harness::ColumnGenSpec spec;
+            if (!harness::string_to_shape(shape_name, spec.shape)) {
+                cerr << "Unsupported shape: " << shape_name << endl;
+                return 1;
+            }
+            vector<TSEncoding> encodings =
+                encoding_override.empty() ? candidate_encodings(type) : encoding_override;
+            for (TSEncoding encoding : encodings) {
+                for (CompressionType compression : compressions) {
+                    CodecResult result;
+                    result.type = harness::datatype_to_string(type);
+                    result.shape = shape_name;
+                    result.encoding = harness::encoding_to_string(encoding);
+                    result.compression = harness::compression_to_string(compression);
+                    result.code = write_codec(file_path, type, spec, encoding, compression,
+                                              points, devices, tablet_rows, seed, result);
+                    if (result.code == E_OK) {
+                        result.code = read_codec(file_path, result);
+                    }
+                    print_result(result);
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+    if (!json_path.empty()) {
+        write_json(json_path, results);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <sys/resource.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+#include "harness/mmap_read.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 内存映射读取性能测试：对比读取器默认的 pread 读取与内存映射读取（harness/mmap_read.h，
+ * 按不同 madvise 提示）在冷缓存（每次查询前把文件移出页缓存）和热缓存下的耗时和 CPU 时间。
+ * 查询为全表扫描和数据时间区间中间的窄范围查询（重复的看板查询）。
+ *
+ * 参数：
+ *   --rows=2000000              生成数据的总行数
+ *   --tags=2 --fields=10 --type=INT64 --tag-cardinality=100 --tablet-rows=1024
+ *   --modes=pread,NORMAL,SEQUENTIAL,RANDOM,WILLNEED   读取方式：pread 或内存映射的 madvise 提示
+ *   --cache=cold,warm           缓存状态（逗号分隔）
+ *   --range-percent=100,1       查询时间范围占全部时间区间的百分比（逗号分隔）
+ *   --repeat=3                  每种组合重复次数
+ */
+
+// 一次查询的统计
+struct ReadResult {
+    double wall_s = 0;
+    double cpu_s = 0;          // 用户态 + 内核态
+    long minor_faults = 0;
+    long major_faults = 0;
+    harness::ScanStats scan;
+};
+
+double cpu_seconds(const rusage& usage) {
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec +
+           usage.ru_stime.tv_usec / 1e6;
+}
+
+// 打开文件、查询并逐行读取全部结果
+int run_query(const string& file_path, const string& table_name, const vector<string>& columns,
+              int64_t start_time, int64_t end_time, ReadResult& result) {
+    rusage before;
+    getrusage(RUSAGE_SELF, &before);
+    harness::Stopwatch watch;
+    TsFileReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    ret = reader.query(table_name, columns, start_time, end_time, temp_ret);
+    if (ret == E_OK) {
+        auto* table_ret = dynamic_cast<TableResultSet*>(temp_ret);
+        ret = harness::scan_table_rows(table_ret, result.scan, watch);
+        table_ret->close();
+    }
+    reader.close();
+    result.wall_s = watch.elapsed_s();
+    rusage after;
+    getrusage(RUSAGE_SELF, &after);
+    result.cpu_s = cpu_seconds(after) - cpu_seconds(before);
+    result.minor_faults = after.ru_minflt - before.ru_minflt;
+    result.major_faults = after.ru_majflt - before.ru_majflt;
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 2000000);
+    config.tablet_rows = args.get_int("tablet-rows", 1024);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    vector<string> modes =
+        args.get_string_list("modes", {"pread", "NORMAL", "SEQUENTIAL", "RANDOM", "WILLNEED"});
+    vector<string> caches = args.get_string_list("cache", {"cold", "warm"});
+    vector<int64_t> range_percents = args.get_int_list("range-percent", {100, 1});
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string file_path = harness::resolve_data_path("bench_mmap_read.tsfile");
+    harness::TableDatasetStats stats;
+    int ret = harness::write_table_dataset(file_path, config, stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::dataset_schema(config).column_names;
+    int64_t min_time = harness::dataset_timestamp(config, 0);
+    int64_t max_time = harness::dataset_timestamp(config, config.rows - 1);
+    for (int64_t i = max<int64_t>(0, config.rows - config.tablet_rows); i < config.rows; i++) {
+        max_time = max(max_time, harness::dataset_timestamp(config, i));
+    }
+
+    printf("file=%s size_MB=%.2f rows=%lld\n", file_path.c_str(), harness::to_mb(stats.file_bytes),
+           (long long)config.rows);
+    printf("%-8s %-6s %-12s %-6s %10s %10s %10s %10s %14s %12s\n", "range", "cache", "mode",
+           "round", "wall_ms", "cpu_ms", "minflt", "majflt", "rows/s", "cpu_vs_pread");
+    harness::MmapReadMode& mmap_mode = harness::MmapReadMode::instance();
+    for (int64_t percent : range_percents) {
+        int64_t span = max<int64_t>(1, (max_time - min_time) * percent / 100);
+        int64_t start_time = percent >= 100 ? INT64_MIN : min_time + (max_time - min_time - span) / 2;
+        int64_t end_time = percent >= 100 ? INT64_MAX : start_time + span;
+        for (const string& cache : caches) {
+            double pread_cpu_s = 0;
+            for (const string& mode : modes) {
+                harness::MmapAdvice advice = harness::MmapAdvice::NORMAL;
+                if (mode == "pread") {
+                    mmap_mode.disable();
+                } else if (harness::string_to_advice(mode, advice)) {
+                    mmap_mode.enable(file_path, advice);
+                } else {
+                    cerr << "unknown mode: " << mode << endl;
+                    return 1;
+                }
+                double cpu_sum = 0;
+                for (int64_t round = 0; round < repeat; round++) {
+                    // 冷缓存：每次查询前移出页缓存；热缓存：第一次查询前预热一次
+                    if (cache == "cold") {
+                        if (harness::evict_page_cache(file_path) != E_OK) {
+                            cerr << "evict page cache failed" << endl;
+                            return 1;
+                        }
+                    } else if (round == 0) {
+                        ReadResult warmup;
+                        run_query(file_path, config.table_name, columns, start_time, end_time,
+                                  warmup);
+                    }
+                    ReadResult result;
+                    ret = run_query(file_path, config.table_name, columns, start_time, end_time,
+                                    result);
+                    if (ret != E_OK) {
+                        cerr << "query failed, error code: " << ret << endl;
+                        return ret;
+                    }
+                    cpu_sum += result.cpu_s;
+                    // pread 的平均 CPU 时间 / 当前方式的平均 CPU 时间，未测试 pread 时为 0
+                    double cpu_ratio =
+                        mode == "pread" ? 1
+                                        : pread_cpu_s / max(1e-9, cpu_sum / (round + 1));
+                    printf("%-8s %-6s %-12s %-6lld %10.3f %10.3f %10ld %10ld %14.0f %12.2f\n",
+                           (to_string(percent) + "%").c_str(), cache.c_str(), mode.c_str(),
+                           (long long)round, result.wall_s * 1000, result.cpu_s * 1000,
+                           result.minor_faults, result.major_faults,
+                           harness::per_second(result.scan.rows, result.wall_s), cpu_ratio);
+                }
+                if (mode == "pread") {
+                    pread_cpu_s = cpu_sum / max<int64_t>(1, repeat);
+                }
+            }
+        }
+    }
+    mmap_mode.disable();
+    if (mmap_mode.mapped_files() > 0 && mmap_mode.served_reads() == 0) {
+        cerr << "warning: files were mapped but no pread was served from the mapping" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/parallel_scan.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 表模型并行查询扩展性测试：把全表查询按时间范围切分为多个分区，
+ * 由 ParallelTableScan 的 T 个工作线程并行读取，输出聚合吞吐与线程数的关系
+ *
+ * 参数：
+ *   --threads=1,2,4,8           工作线程数（逗号分隔时依次测试）
+ *   --partitions-per-thread=4   每个线程平均分到的分区数（分区数 = 线程数 × 该值）
+ *   --rows=4000000 --tags=2 --fields=10 --type=INT64 --tag-cardinality=100 --tablet-rows=1024
+ *   --batch-rows=1024           每批行数
+ *   --repeat=3                  每种线程数重复次数
+ */
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 4000000);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    vector<int64_t> thread_list = args.get_int_list("threads", {1, 2, 4, 8});
+    int64_t partitions_per_thread = max<int64_t>(1, args.get_int("partitions-per-thread", 4));
+    uint32_t batch_rows = static_cast<uint32_t>(max<int64_t>(1, args.get_int("batch-rows", 1024)));
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string file_path = harness::resolve_data_path("bench_parallel_scan.tsfile");
+    harness::TableDatasetStats write_stats;
+    int ret = harness::write_table_dataset(file_path, config, write_stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::dataset_schema(config).column_names;
+    // 生成数据的时间区间，最后一轮设备块中的时间戳最大
+    int64_t max_time = 0;
+    int64_t tail = harness::dataset_block_rows(config) * config.tag_cardinality;
+    for (int64_t i = max<int64_t>(0, config.rows - tail); i < config.rows; i++) {
+        max_time = max(max_time, harness::dataset_timestamp(config, i));
+    }
+
+    printf("rows=%lld columns=%zu type=%s time_range=[0,%lld] file_mb=%.2f hardware_threads=%u\n",
+           (long long)config.rows, columns.size(), config.type_name.c_str(), (long long)max_time,
+           harness::to_mb(write_stats.file_bytes), thread::hardware_concurrency());
+    printf("%-8s %-10s %-6s %10s %14s %14s %10s\n", "threads", "partitions", "round", "scan_s",
+           "rows/s", "cells/s", "speedup");
+    double base_rate = 0;
+    for (int64_t threads : thread_list) {
+        threads = max<int64_t>(1, threads);
+        vector<harness::ScanPartition> partitions = harness::split_time_range(
+            0, max_time, static_cast<int>(threads * partitions_per_thread));
+        for (int64_t round = 0; round < repeat; round++) {
+            // 每个分区的统计由读取该分区的线程独占，结束后合并
+            vector<harness::ScanStats> partition_stats(partitions.size());
+            harness::ParallelTableScan scan(file_path, config.table_name, columns, batch_rows);
+            harness::Stopwatch watch;
+            ret = scan.run(partitions, static_cast<int>(threads),
+                           [&](const harness::ScanPartition& partition,
+                               const harness::ColumnBatch& batch) {
+                               harness::scan_column_batch(batch, partition_stats[partition.index]);
+                               return E_OK;
+                           });
+            double scan_s = watch.elapsed_s();
+            if (ret != E_OK) {
+                cerr << "parallel scan failed, error code: " << ret << endl;
+                return ret;
+            }
+            harness::ScanStats total;
+            for (const auto& stats : partition_stats) {
+                total.rows += stats.rows;
+                total.cells += stats.cells;
+            }
+            if (total.rows != config.rows) {
+                cerr << "row count mismatch, expected " << config.rows << ", got " << total.rows
+                     << endl;
+                return 1;
+            }
+            double rate = harness::per_second(total.rows, scan_s);
+            if (base_rate == 0) {
+                base_rate = rate;
+            }
+            printf("%-8lld %-10zu %-6lld %10.3f %14.0f %14.0f %10.2f\n", (long long)threads,
+                   partitions.size(), (long long)round, scan_s, rate,
+                   harness::per_second(total.cells, scan_s), rate / base_rate);
+        }
+    }
+    return 0;
+}
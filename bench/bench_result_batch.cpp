@@ -0,0 +1,109 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 逐行读取与按列批量读取的对比性能测试：
+ *   row   —— next + is_null(i) + 按列类型分支调用 get_value<T>(i)
+ *   batch —— ColumnBatchReader::next_batch 按列填充定长数组和空值位图，再按列遍历
+ *
+ * 参数：
+ *   --rows=1000000 --tags=2 --fields=10 --type=MIXED --tag-cardinality=100
+ *   --batch-rows=256,1024,4096  每批行数（逗号分隔时依次测试）
+ *   --repeat=3                  每种读取方式重复次数
+ */
+
+// 打开文件并按指定方式读取全表，batch_rows 为 0 时逐行读取
+int run_scan(const string& file_path, const string& table_name, const vector<string>& columns,
+             uint32_t batch_rows, harness::ScanStats& stats) {
+    TsFileReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    harness::Stopwatch watch;
+    ret = reader.query(table_name, columns, INT64_MIN, INT64_MAX, temp_ret);
+    if (ret == E_OK) {
+        auto* table_ret = dynamic_cast<TableResultSet*>(temp_ret);
+        if (batch_rows == 0) {
+            ret = harness::scan_table_rows(table_ret, stats, watch);
+        } else {
+            harness::ColumnBatchReader batch_reader(table_ret);
+            harness::ColumnBatch batch = batch_reader.create_batch(batch_rows);
+            while ((ret = batch_reader.next_batch(batch)) == E_OK && batch.row_count() > 0) {
+                harness::scan_column_batch(batch, stats);
+            }
+            stats.scan_s = watch.elapsed_s();
+        }
+        table_ret->close();
+    }
+    reader.close();
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 1000000);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "MIXED");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    int64_t repeat = args.get_int("repeat", 3);
+    vector<int64_t> batch_rows_list = args.get_int_list("batch-rows", {256, 1024, 4096});
+
+    string file_path = harness::resolve_data_path("bench_result_batch.tsfile");
+    harness::TableDatasetStats write_stats;
+    int ret = harness::write_table_dataset(file_path, config, write_stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::dataset_schema(config).column_names;
+
+    printf("rows=%lld columns=%zu type=%s\n", (long long)config.rows, columns.size(),
+           config.type_name.c_str());
+    printf("%-12s %-6s %10s %14s %14s %10s\n", "mode", "round", "scan_s", "rows/s", "cells/s",
+           "speedup");
+    // 逐行读取作为基准
+    double row_rate = 0;
+    vector<int64_t> modes = {0};
+    modes.insert(modes.end(), batch_rows_list.begin(), batch_rows_list.end());
+    for (int64_t batch_rows : modes) {
+        string mode = batch_rows == 0 ? "row" : "batch_" + to_string(batch_rows);
+        for (int64_t round = 0; round < repeat; round++) {
+            harness::ScanStats stats;
+            ret = run_scan(file_path, config.table_name, columns, static_cast<uint32_t>(batch_rows),
+                           stats);
+            if (ret != E_OK) {
+                cerr << "scan failed, error code: " << ret << endl;
+                return ret;
+            }
+            double rate = harness::per_second(stats.rows, stats.scan_s);
+            if (batch_rows == 0) {
+                row_rate = max(row_rate, rate);
+            }
+            printf("%-12s %-6lld %10.3f %14.0f %14.0f %10.2f\n", mode.c_str(), (long long)round,
+                   stats.scan_s, rate, harness::per_second(stats.cells, stats.scan_s),
+                   row_rate > 0 ? rate / row_rate : 0);
+        }
+    }
+    return 0;
+}
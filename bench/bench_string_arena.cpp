@@ -0,0 +1,184 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 字符串列读取的内存分配性能测试：在 TAG 列多、FIELD 列为字符串的表上对比
+ *   row_copy —— 逐行读取，get_value<common::String*>(i)->to_std_string()（测试用例中的读取方式，每个单元格分配一次）
+ *   row_view —— 逐行读取，按 string_view 访问 common::String，不复制
+ *   batch_N  —— ColumnBatchReader 按批读取，变长值存放在每列复用的字节区中，按 string_view 访问
+ * 输出 rows/s 以及读取阶段（query 之后到读完）每行的分配次数和分配字节数（见 harness/alloc_counter.h）。
+ * 每种方式对字符串的长度和首字节计算相同的校验和，校验和不一致时退出并返回 1。
+ *
+ * 参数：
+ *   --rows=1000000              生成数据的总行数
+ *   --tags=4 --fields=8 --type=STRING --tag-cardinality=1000   表结构（默认全部为字符串列）
+ *   --shape=LOW_CARDINALITY     FIELD 列数据形态，见 data_generator.h
+ *   --batch-rows=1024,4096      按批读取的每批行数（逗号分隔）
+ *   --repeat=3                  每种读取方式重复次数
+ */
+
+// 字符串的校验和：长度和首字节
+inline void mix_string(uint64_t& checksum, string_view value) {
+    harness::checksum_mix(checksum, value.size());
+    harness::checksum_mix(checksum, value.empty() ? 0 : value[0]);
+}
+
+// 一次读取的统计
+struct StringScanResult {
+    int64_t rows = 0;
+    uint64_t checksum = 0;
+    double scan_s = 0;
+    harness::AllocStats allocs;
+};
+
+// 逐行读取全部变长列，copy 为 true 时先转换为 std::string
+int scan_rows(TableResultSet* ret, bool copy, StringScanResult& result) {
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    vector<uint32_t> string_columns;
+    for (uint32_t i = 2; i <= column_count; i++) {
+        if (harness::ColumnBatch::value_width(metadata->get_column_type(i)) == 0) {
+            string_columns.push_back(i);
+        }
+    }
+    bool has_next = false;
+    int code = E_OK;
+    while ((code = ret->next(has_next)) == E_OK && has_next) {
+        for (uint32_t i : string_columns) {
+            if (ret->is_null(i)) {
+                continue;
+            }
+            common::String* value = ret->get_value<common::String*>(i);
+            if (copy) {
+                string text = value->to_std_string();
+                mix_string(result.checksum, text);
+            } else {
+                mix_string(result.checksum, harness::string_view_of(value));
+            }
+        }
+        result.rows++;
+    }
+    return code;
+}
+
+// 按批读取全部变长列
+int scan_batches(TableResultSet* ret, uint32_t batch_rows, StringScanResult& result) {
+    harness::ColumnBatchReader batch_reader(ret);
+    harness::ColumnBatch batch = batch_reader.create_batch(batch_rows);
+    int code = E_OK;
+    while ((code = batch_reader.next_batch(batch)) == E_OK && batch.row_count() > 0) {
+        for (uint32_t c = 2; c <= batch.column_count(); c++) {
+            if (harness::ColumnBatch::value_width(batch.column_type(c)) != 0) {
+                continue;
+            }
+            for (uint32_t r = 0; r < batch.row_count(); r++) {
+                if (!batch.is_null(c, r)) {
+                    mix_string(result.checksum, batch.string_value(c, r));
+                }
+            }
+        }
+        result.rows += batch.row_count();
+    }
+    return code;
+}
+
+// 打开文件并按指定方式读取全表：batch_rows 为 0 时逐行读取
+int run_scan(const string& file_path, const string& table_name, const vector<string>& columns,
+             bool copy, uint32_t batch_rows, StringScanResult& result) {
+    TsFileReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    ret = reader.query(table_name, columns, INT64_MIN, INT64_MAX, temp_ret);
+    if (ret == E_OK) {
+        auto* table_ret = dynamic_cast<TableResultSet*>(temp_ret);
+        harness::AllocStats before = harness::AllocCounter::snapshot();
+        harness::Stopwatch watch;
+        ret = batch_rows == 0 ? scan_rows(table_ret, copy, result)
+                              : scan_batches(table_ret, batch_rows, result);
+        result.scan_s = watch.elapsed_s();
+        result.allocs = harness::AllocCounter::snapshot().since(before);
+        table_ret->close();
+    }
+    reader.close();
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 1000000);
+    config.tag_count = args.get_int("tags", 4);
+    config.field_count = args.get_int("fields", 8);
+    config.type_name = args.get_string("type", "STRING");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 1000));
+    config.field_shape = args.get_string("shape", "LOW_CARDINALITY");
+    vector<int64_t> batch_rows_list = args.get_int_list("batch-rows", {1024, 4096});
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string file_path = harness::resolve_data_path("bench_string_arena.tsfile");
+    harness::TableDatasetStats write_stats;
+    int ret = harness::write_table_dataset(file_path, config, write_stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::dataset_schema(config).column_names;
+
+    printf("rows=%lld columns=%zu type=%s alloc_counter=%s\n", (long long)config.rows,
+           columns.size(), config.type_name.c_str(),
+           harness::AllocCounter::installed() ? "on" : "off");
+    printf("%-12s %-6s %10s %14s %12s %14s %10s\n", "mode", "round", "scan_s", "rows/s",
+           "allocs/row", "alloc_B/row", "speedup");
+    vector<int64_t> modes = {-1, 0};
+    modes.insert(modes.end(), batch_rows_list.begin(), batch_rows_list.end());
+    double copy_rate = 0;
+    uint64_t expected_checksum = 0;
+    for (int64_t mode : modes) {
+        string name = mode < 0 ? "row_copy" : mode == 0 ? "row_view" : "batch_" + to_string(mode);
+        for (int64_t round = 0; round < repeat; round++) {
+            StringScanResult result;
+            ret = run_scan(file_path, config.table_name, columns, mode < 0,
+                           static_cast<uint32_t>(max<int64_t>(0, mode)), result);
+            if (ret != E_OK) {
+                cerr << name << " scan failed, error code: " << ret << endl;
+                return ret;
+            }
+            double rate = harness::per_second(result.rows, result.scan_s);
+            if (mode < 0) {
+                copy_rate = max(copy_rate, rate);
+                expected_checksum = result.checksum;
+            } else if (result.checksum != expected_checksum) {
+                cerr << name << ": checksum mismatch" << endl;
+                return 1;
+            }
+            double rows = static_cast<double>(max<int64_t>(1, result.rows));
+            printf("%-12s %-6lld %10.3f %14.0f %12.3f %14.1f %10.2f\n", name.c_str(),
+                   (long long)round, result.scan_s, rate, result.allocs.allocations / rows,
+                   result.allocs.bytes / rows, copy_rate > 0 ? rate / copy_rate : 0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 分配计数只在 *_alloc 版本中启用（见 bench/CMakeLists.txt），计时版本不替换 malloc / operator new
+#ifdef HARNESS_ENABLE_ALLOC_COUNTER
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#endif
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 表模型读取吞吐性能测试：驱动 TsFileReader::query + TableResultSet::next
+ * 同时输出逐行读取阶段每行的分配次数，以及 open + query 的分配次数和一次查询的堆内存占用峰值增量。
+ * 分配统计只在 bench_table_read_alloc 中启用，bench_table_read 不统计分配（分配列为 0），吞吐量以该版本为准
+ *
+ * 参数：
+ *   --file=path                 读取已有的 tsfile，不指定时按下列参数生成数据文件
+ *   --table=bench_table         表名
+ *   --columns=tag0,s0           查询的列（读取已有文件时必须指定）
+ *   --rows=1000000              生成数据的总行数
+ *   --tags=2 --fields=10 --type=INT64 --tag-cardinality=100 --tablet-rows=1024
+ *   --shape=ROW --null-percent=0 --seed=42   FIELD 列数据形态、空值比例和随机种子
+ *   --range-percent=1,10        窄时间范围查询占全部时间区间的百分比（逗号分隔）
+ *   --repeat=3                  每种查询重复次数
+ *   --io-stats                  统计每次查询各阶段（open / query / next / close）的文件 I/O 并输出
+ */
+
+// 一次查询的统计
+struct QueryResult {
+    double open_s = 0;
+    double query_s = 0;
+    harness::ScanStats scan;
+    harness::IoReport io;
+    harness::AllocStats setup_allocs;   // open + query
+    harness::AllocStats scan_allocs;    // 逐行读取
+    uint64_t peak_live_bytes = 0;       // 打开文件到关闭的堆内存占用峰值增量
+};
+
+// 打开文件、查询并逐行读取全部结果
+int run_query(const string& file_path, const string& table_name, const vector<string>& columns,
+              int64_t start_time, int64_t end_time, QueryResult& result) {
+    harness::IoAccounting& accounting = harness::IoAccounting::instance();
+    harness::IoReport io_before = accounting.report();
+    harness::AllocScope alloc_scope;
+    harness::Stopwatch watch;
+    TsFileReader reader;
+    int ret;
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::OPEN);
+        ret = reader.open(file_path);
+    }
+    result.open_s = watch.elapsed_s();
+    if (ret != E_OK) {
+        return ret;
+    }
+    ResultSet* temp_ret = nullptr;
+    watch.reset();
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::QUERY);
+        ret = reader.query(table_name, columns, start_time, end_time, temp_ret);
+    }
+    result.query_s = watch.elapsed_s();
+    result.setup_allocs = alloc_scope.stats();
+    auto* table_ret = ret == E_OK ? dynamic_cast<TableResultSet*>(temp_ret) : nullptr;
+    if (table_ret != nullptr) {
+        harness::IoPhaseScope phase(harness::IoPhase::NEXT);
+        harness::AllocScope scan_scope;
+        ret = harness::scan_table_rows(table_ret, result.scan, watch);
+        result.scan_allocs = scan_scope.stats();
+    }
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::CLOSE);
+        if (table_ret != nullptr) {
+            table_ret->close();
+        }
+        reader.close();
+    }
+    result.io = accounting.report().since(io_before);
+    result.peak_live_bytes = alloc_scope.stats().peak_live_bytes;
+    return ret;
+}
+
+// 输出一行结果
+void print_result(const string& name, int64_t round, const QueryResult& result,
+                  uint64_t file_bytes) {
+    double rows_per_s = harness::per_second(result.scan.rows, result.scan.scan_s);
+    printf("%-14s %-6lld %10.3f %10.3f %12.3f %10.3f %12lld %14.0f %10.2f %12llu %12.4f %10.2f\n",
+           name.c_str(), (long long)round, result.open_s * 1000, result.query_s * 1000,
+           result.scan.first_row_s * 1000, result.scan.scan_s, (long long)result.scan.rows,
+           rows_per_s, harness::per_second(harness::to_mb(file_bytes), result.scan.scan_s),
+           (unsigned long long)result.setup_allocs.allocations,
+           result.scan_allocs.allocations_per(static_cast<double>(result.scan.rows)),
+           harness::to_mb(result.peak_live_bytes));
+    if (harness::IoAccounting::instance().enabled()) {
+        harness::print_io_report(result.io, "    ");
+    }
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    string file_path = args.get_string("file", "");
+    string table_name = args.get_string("table", "bench_table");
+    int64_t repeat = args.get_int("repeat", 3);
+    vector<int64_t> range_percents = args.get_int_list("range-percent", {1, 10});
+    vector<string> columns = args.get_string_list("columns", {});
+    bool io_stats = args.has("io-stats");
+
+    // 未指定文件时生成数据文件
+    if (file_path.empty()) {
+        harness::TableDatasetConfig config;
+        config.table_name = table_name;
+        config.rows = args.get_int("rows", 1000000);
+        config.tablet_rows = args.get_int("tablet-rows", 1024);
+        config.tag_count = args.get_int("tags", 2);
+        config.field_count = args.get_int("fields", 10);
+        config.type_name = args.get_string("type", "INT64");
+        config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+        config.field_shape = args.get_string("shape", "ROW");
+        config.null_rate = args.get_double("null-percent", 0) / 100;
+        config.seed = static_cast<uint64_t>(args.get_int("seed", 42));
+        file_path = harness::resolve_data_path("bench_table_read.tsfile");
+        harness::TableDatasetStats stats;
+        int ret = harness::write_table_dataset(file_path, config, stats);
+        if (ret != E_OK) {
+            cerr << "generate data failed, error code: " << ret << endl;
+            return ret;
+        }
+        if (columns.empty()) {
+            columns = harness::dataset_schema(config).column_names;
+        }
+    }
+    if (columns.empty()) {
+        cerr << "--columns is required when reading an existing file" << endl;
+        return 1;
+    }
+
+    // 只统计数据文件（生成数据之后启用，不统计写入）
+    if (io_stats) {
+        harness::IoAccounting::instance().enable(file_path);
+    }
+    uint64_t file_bytes = harness::file_size_bytes(file_path);
+    printf("file=%s size_MB=%.2f columns=%zu alloc_counter=%s\n", file_path.c_str(),
+           harness::to_mb(file_bytes), columns.size(),
+           harness::AllocCounter::installed() ? "on" : "off");
+    printf("%-14s %-6s %10s %10s %12s %10s %12s %14s %10s %12s %12s %10s\n", "query", "round",
+           "open_ms", "query_ms", "first_row_ms", "scan_s", "rows", "rows/s", "MB/s",
+           "setup_allocs", "allocs/row", "peak_MB");
+
+    // 全表扫描，同时得到数据的时间区间
+    int64_t min_time = INT64_MAX;
+    int64_t max_time = INT64_MIN;
+    for (int64_t round = 0; round < repeat; round++) {
+        QueryResult result;
+        int ret = run_query(file_path, table_name, columns, INT64_MIN, INT64_MAX, result);
+        if (ret != E_OK) {
+            cerr << "query failed, error code: " << ret << endl;
+            return ret;
+        }
+        min_time = result.scan.min_time;
+        max_time = result.scan.max_time;
+        print_result("full_scan", round, result, file_bytes);
+    }
+    if (min_time > max_time) {
+        return 0;
+    }
+
+    // 窄时间范围查询：窗口位于时间区间中间
+    for (int64_t percent : range_percents) {
+        int64_t span = max<int64_t>(1, (max_time - min_time) * percent / 100);
+        int64_t start_time = min_time + (max_time - min_time - span) / 2;
+        int64_t end_time = start_time + span;
+        for (int64_t round = 0; round < repeat; round++) {
+            QueryResult result;
+            int ret = run_query(file_path, table_name, columns, start_time, end_time, result);
+            if (ret != E_OK) {
+                cerr << "query failed, error code: " << ret << endl;
+                return ret;
+            }
+            // 窄范围查询只读取部分文件，不输出 MB/s
+            print_result("range_" + to_string(percent) + "%", round, result, 0);
+        }
+    }
+    return 0;
+}
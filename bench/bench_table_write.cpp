@@ -0,0 +1,104 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 分配计数只在 *_alloc 版本中启用（见 bench/CMakeLists.txt），计时版本不替换 malloc / operator new
+#ifdef HARNESS_ENABLE_ALLOC_COUNTER
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#endif
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#include "harness/table_dataset.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 表模型写入吞吐性能测试：驱动 TsFileTableWriter::write_table
+ * 同时输出 write_table 每个数据点的分配次数和分配字节数、flush + close 的分配次数，
+ * 以及写入期间堆内存占用峰值的增量（见 harness/alloc_counter.h）。分配统计只在 bench_table_write_alloc 中启用，
+ * bench_table_write 不统计分配（分配列为 0），吞吐量以该版本为准
+ *
+ * 参数：
+ *   --rows=1000000              写入总行数
+ *   --tablet-rows=1024,8192     每个 tablet 的行数（逗号分隔时依次测试）
+ *   --tags=2                    TAG 列数量
+ *   --fields=10                 FIELD 列数量
+ *   --type=INT64                FIELD 列数据类型，MIXED 表示多种类型轮换
+ *   --tag-cardinality=100       设备数量（TAG 组合的基数）
+ *   --memory-threshold=128      写入器缓存阈值（MB）
+ *   --shape=ROW                 FIELD 列数据形态：ROW/COUNTER/RANDOM_WALK/PERIODIC/LOW_CARDINALITY/ZIPF
+ *   --null-percent=0            FIELD 列空值比例（0-100）
+ *   --seed=42                   数据生成器的随机种子
+ *   --repeat=1                  每组配置重复次数
+ */
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 1000000);
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    config.tag_cardinality = max<int64_t>(1, args.get_int("tag-cardinality", 100));
+    config.memory_threshold = args.get_int("memory-threshold", 128) * 1024 * 1024;
+    config.field_shape = args.get_string("shape", "ROW");
+    config.null_rate = args.get_double("null-percent", 0) / 100;
+    config.seed = static_cast<uint64_t>(args.get_int("seed", 42));
+    int64_t repeat = args.get_int("repeat", 1);
+    vector<int64_t> tablet_rows_list = args.get_int_list("tablet-rows", {1024, 8192});
+
+    if (config.type_name != "MIXED" &&
+        harness::string_to_datatype(config.type_name) == TSDataType::INVALID_DATATYPE) {
+        cerr << "Unsupported data type: " << config.type_name << endl;
+        return 1;
+    }
+    harness::ValueShape shape;
+    if (!harness::string_to_shape(config.field_shape, shape)) {
+        cerr << "Unsupported shape: " << config.field_shape << endl;
+        return 1;
+    }
+
+    string file_path = harness::resolve_data_path("bench_table_write.tsfile");
+    printf("rows=%lld tags=%lld fields=%lld type=%s tag_cardinality=%lld shape=%s null_rate=%.2f "
+           "alloc_counter=%s\n",
+           (long long)config.rows, (long long)config.tag_count, (long long)config.field_count,
+           config.type_name.c_str(), (long long)config.tag_cardinality,
+           config.field_shape.c_str(), config.null_rate,
+           harness::AllocCounter::installed() ? "on" : "off");
+    printf("%-12s %-6s %10s %10s %12s %14s %14s %10s %12s %12s %12s %12s %10s\n", "tablet_rows",
+           "round", "fill_s", "write_s", "flush_cls_s", "rows/s", "points/s", "MB/s", "file_MB",
+           "allocs/pt", "alloc_B/pt", "flush_allocs", "peak_MB");
+    for (int64_t tablet_rows : tablet_rows_list) {
+        config.tablet_rows = max<int64_t>(1, tablet_rows);
+        for (int64_t round = 0; round < repeat; round++) {
+            harness::TableDatasetStats stats;
+            int ret = harness::write_table_dataset(file_path, config, stats);
+            if (ret != E_OK) {
+                cerr << "write failed, error code: " << ret << endl;
+                return ret;
+            }
+            // 吞吐量只统计写入器耗时（write_table + flush + close），不含构造 tablet 的耗时
+            double seconds = stats.write_s + stats.flush_close_s;
+            double points = static_cast<double>(config.rows) * config.field_count;
+            printf("%-12lld %-6lld %10.3f %10.3f %12.3f %14.0f %14.0f %10.2f %12.2f %12.4f "
+                   "%12.2f %12llu %10.2f\n",
+                   (long long)config.tablet_rows, (long long)round, stats.fill_s,
+                   stats.write_s, stats.flush_close_s,
+                   harness::per_second(config.rows, seconds),
+                   harness::per_second(points, seconds),
+                   harness::per_second(harness::to_mb(stats.file_bytes), seconds),
+                   harness::to_mb(stats.file_bytes), stats.write_allocs.allocations_per(points),
+                   stats.write_allocs.bytes_per(points),
+                   (unsigned long long)stats.flush_close_allocs.allocations,
+                   harness::to_mb(stats.peak_live_bytes));
+        }
+    }
+    return 0;
+}
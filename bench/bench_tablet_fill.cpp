@@ -0,0 +1,216 @@
+#include "common/db_common.h"
+#include "common/tablet.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/table_dataset.h"
+#include "harness/tablet_bulk.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 构造 tablet 的开销对比（只统计填充数据，不写入文件）：
+ *   by_name  —— 逐单元格 add_value(row, "column_name", value)（测试用例的写法）
+ *   by_index —— 逐单元格 add_value(row, column_index, value)
+ *   bulk     —— set_timestamps + append_column 按列批量写入
+ *
+ * 参数：
+ *   --tablet-rows=1024          每个 tablet 的行数
+ *   --tablets=200               每种方式填充的 tablet 数量
+ *   --tags=2 --fields=10 --type=INT64
+ *   --null-percent=0            FIELD 列空值比例（0-100）
+ */
+
+// 按列存储的源数据
+struct SourceColumns {
+    vector<int64_t> timestamps;
+    vector<vector<int64_t>> int64_values;
+    vector<vector<int32_t>> int32_values;
+    vector<vector<float>> float_values;
+    vector<vector<double>> double_values;
+    vector<vector<bool>> bool_values;
+    vector<vector<string>> string_values;
+    vector<vector<uint8_t>> nulls;     // 空值位图，1 表示空值
+};
+
+// 生成源数据，第 c 列按类型存放在对应的数组中
+SourceColumns build_source(const harness::TableDatasetSchema& schema, uint32_t rows,
+                           int64_t null_percent) {
+    size_t columns = schema.column_names.size();
+    SourceColumns source;
+    source.int64_values.resize(columns);
+    source.int32_values.resize(columns);
+    source.float_values.resize(columns);
+    source.double_values.resize(columns);
+    source.bool_values.resize(columns);
+    source.string_values.resize(columns);
+    source.nulls.resize(columns);
+    for (uint32_t r = 0; r < rows; r++) {
+        source.timestamps.push_back(r);
+    }
+    for (size_t c = 0; c < columns; c++) {
+        source.nulls[c].assign((rows + 7) / 8, 0);
+        for (uint32_t r = 0; r < rows; r++) {
+            bool valid = schema.column_categories[c] == ColumnCategory::TAG ||
+                         (r * 7919 + c) % 100 >= static_cast<uint64_t>(null_percent);
+            if (!valid) {
+                source.nulls[c][r >> 3] |= static_cast<uint8_t>(1u << (r & 7));
+            }
+            switch (schema.data_types[c]) {
+                case TSDataType::INT64:
+                case TSDataType::TIMESTAMP:
+                    source.int64_values[c].push_back(r + c);
+                    break;
+                case TSDataType::INT32:
+                case TSDataType::DATE:
+                    source.int32_values[c].push_back(static_cast<int32_t>(r + c));
+                    break;
+                case TSDataType::FLOAT:
+                    source.float_values[c].push_back(static_cast<float>(r) * 0.5f);
+                    break;
+                case TSDataType::DOUBLE:
+                    source.double_values[c].push_back(static_cast<double>(r) * 0.5);
+                    break;
+                case TSDataType::BOOLEAN:
+                    source.bool_values[c].push_back(r % 2 == 0);
+                    break;
+                default:
+                    source.string_values[c].push_back("value_" + to_string((r + c) % 16));
+                    break;
+            }
+        }
+    }
+    return source;
+}
+
+// 逐单元格写入，column 为列名（by_name）或列下标（by_index）
+template <typename Column>
+int fill_cell(Tablet& tablet, uint32_t row, Column column, TSDataType type,
+              const SourceColumns& source, size_t c) {
+    switch (type) {
+        case TSDataType::INT64:
+        case TSDataType::TIMESTAMP:
+            return tablet.add_value(row, column, source.int64_values[c][row]);
+        case TSDataType::INT32:
+        case TSDataType::DATE:
+            return tablet.add_value(row, column, source.int32_values[c][row]);
+        case TSDataType::FLOAT:
+            return tablet.add_value(row, column, source.float_values[c][row]);
+        case TSDataType::DOUBLE:
+            return tablet.add_value(row, column, source.double_values[c][row]);
+        case TSDataType::BOOLEAN:
+            return tablet.add_value(row, column, static_cast<bool>(source.bool_values[c][row]));
+        default:
+            return tablet.add_value(row, column, source.string_values[c][row].c_str());
+    }
+}
+
+// 逐行逐单元格填充
+int fill_by_cell(Tablet& tablet, const harness::TableDatasetSchema& schema,
+                 const SourceColumns& source, uint32_t rows, bool by_name) {
+    int ret = E_OK;
+    for (uint32_t r = 0; r < rows && ret == E_OK; r++) {
+        ret = tablet.add_timestamp(r, source.timestamps[r]);
+        for (size_t c = 0; c < schema.column_names.size() && ret == E_OK; c++) {
+            if (harness::bitmap_is_null(source.nulls[c].data(), r)) {
+                continue;
+            }
+            ret = by_name ? fill_cell(tablet, r, schema.column_names[c], schema.data_types[c],
+                                      source, c)
+                          : fill_cell(tablet, r, static_cast<uint32_t>(c), schema.data_types[c],
+                                      source, c);
+        }
+    }
+    return ret;
+}
+
+// 按列批量填充
+int fill_bulk(Tablet& tablet, const harness::TableDatasetSchema& schema,
+              const SourceColumns& source, uint32_t rows) {
+    int ret = harness::set_timestamps(tablet, 0, source.timestamps.data(), rows);
+    for (size_t c = 0; c < schema.column_names.size() && ret == E_OK; c++) {
+        uint32_t index = static_cast<uint32_t>(c);
+        const uint8_t* nulls = source.nulls[c].data();
+        switch (schema.data_types[c]) {
+            case TSDataType::INT64:
+            case TSDataType::TIMESTAMP:
+                ret = harness::append_column(tablet, index, 0, source.int64_values[c].data(), rows,
+                                             nulls);
+                break;
+            case TSDataType::INT32:
+            case TSDataType::DATE:
+                ret = harness::append_column(tablet, index, 0, source.int32_values[c].data(), rows,
+                                             nulls);
+                break;
+            case TSDataType::FLOAT:
+                ret = harness::append_column(tablet, index, 0, source.float_values[c].data(), rows,
+                                             nulls);
+                break;
+            case TSDataType::DOUBLE:
+                ret = harness::append_column(tablet, index, 0, source.double_values[c].data(),
+                                             rows, nulls);
+                break;
+            case TSDataType::BOOLEAN:
+                // vector<bool> 不是连续存储，逐个写入
+                for (uint32_t r = 0; r < rows && ret == E_OK; r++) {
+                    if (!harness::bitmap_is_null(nulls, r)) {
+                        ret = tablet.add_value(r, index, static_cast<bool>(source.bool_values[c][r]));
+                    }
+                }
+                break;
+            default:
+                ret = harness::append_column(tablet, index, 0, source.string_values[c].data(),
+                                             rows, nulls);
+                break;
+        }
+    }
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TableDatasetConfig config;
+    config.tag_count = args.get_int("tags", 2);
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    uint32_t rows = static_cast<uint32_t>(max<int64_t>(1, args.get_int("tablet-rows", 1024)));
+    int64_t tablets = args.get_int("tablets", 200);
+    int64_t null_percent = args.get_int("null-percent", 0);
+
+    harness::TableDatasetSchema schema = harness::dataset_schema(config);
+    SourceColumns source = build_source(schema, rows, null_percent);
+    double points = static_cast<double>(rows) * schema.column_names.size() * tablets;
+
+    printf("tablet_rows=%u columns=%zu type=%s tablets=%lld null_percent=%lld\n", rows,
+           schema.column_names.size(), config.type_name.c_str(), (long long)tablets,
+           (long long)null_percent);
+    printf("%-10s %10s %12s %14s\n", "mode", "fill_s", "ns/point", "points/s");
+    const vector<string> modes = {"by_name", "by_index", "bulk"};
+    for (const auto& mode : modes) {
+        double fill_s = 0;
+        for (int64_t t = 0; t < tablets; t++) {
+            Tablet tablet(config.table_name, schema.column_names, schema.data_types,
+                          schema.column_categories, static_cast<int>(rows));
+            harness::Stopwatch watch;
+            int ret = mode == "bulk" ? fill_bulk(tablet, schema, source, rows)
+                                     : fill_by_cell(tablet, schema, source, rows, mode == "by_name");
+            fill_s += watch.elapsed_s();
+            if (ret != E_OK) {
+                cerr << mode << " fill failed, error code: " << ret << endl;
+                return ret;
+            }
+        }
+        printf("%-10s %10.3f %12.2f %14.0f\n", mode.c_str(), fill_s, fill_s * 1e9 / points,
+               harness::per_second(points, fill_s));
+    }
+    return 0;
+}
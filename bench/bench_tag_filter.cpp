@@ -0,0 +1,153 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+#include "harness/table_dataset.h"
+#include "harness/tag_query.h"
+
+using namespace common;
+using namespace std;
+
+/**
+ * TAG 条件查询性能测试：在大量设备（1 万到 100 万）的表上执行只涉及少量设备的查询，
+ * 对比条件下推（读取器按设备索引跳过不满足条件的设备）与全表扫描后客户端过滤的耗时和读取字节数。
+ * 设备 i 的 TAG 值为 tag0_<i>、tag1_<i>，查询条件（N 为设备数）：
+ *   eq      tag0 = tag0_<N/2>                    1 个设备
+ *   in      tag0 IN (10 个均匀分布的设备)        10 个设备
+ *   prefix  tag0 以 tag0_<N/200> 开头            111 个设备
+ *   regex   tag0 ~ ^tag0_[0-9]*77$               约 1% 的设备
+ *
+ * 参数：
+ *   --devices=10000,100000      设备数量（逗号分隔），每种设备数量生成一个数据文件
+ *   --points-per-device=10      每个设备的行数
+ *   --fields=4 --type=INT64     FIELD 列数量和数据类型
+ *   --tablet-rows=1024          每个 tablet 的行数
+ *   --queries=eq,in,prefix,regex   执行的查询（逗号分隔）
+ *   --client                    同时执行全表扫描后客户端过滤，输出下推的加速比
+ *   --repeat=3                  每种查询重复次数
+ */
+
+// 按名称生成查询条件
+bool make_predicates(const string& name, int64_t devices, vector<harness::TagPredicate>& predicates) {
+    if (name == "eq") {
+        predicates = {harness::TagPredicate::eq("tag0", "tag0_" + to_string(devices / 2))};
+    } else if (name == "in") {
+        vector<string> values;
+        for (int64_t k = 0; k < 10; k++) {
+            values.push_back("tag0_" + to_string(k * devices / 10 + 1));
+        }
+        predicates = {harness::TagPredicate::in("tag0", values)};
+    } else if (name == "prefix") {
+        predicates = {harness::TagPredicate::prefix("tag0", "tag0_" + to_string(devices / 200))};
+    } else if (name == "regex") {
+        predicates = {harness::TagPredicate::regex("tag0", "^tag0_[0-9]*77$")};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 满足条件的设备数
+int64_t matched_devices(const vector<harness::TagPredicate>& predicates, int64_t devices) {
+    int64_t count = 0;
+    for (int64_t d = 0; d < devices; d++) {
+        if (harness::tag_predicates_match(predicates, {"tag0_" + to_string(d)})) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// 输出一行结果
+void print_result(int64_t devices, const string& name, const string& mode, int64_t round,
+                  const harness::TagQueryResult& result, int64_t expected_rows, double speedup) {
+    harness::IoCounters io = result.io.total();
+    printf("%-10lld %-8s %-10s %-6lld %10.3f %10.3f %12.3f %12lld %12lld %12.1f %8llu %8.2f\n",
+           (long long)devices, name.c_str(), mode.c_str(), (long long)round, result.open_s * 1000,
+           result.query_s * 1000, result.total_s * 1000, (long long)result.scan.rows,
+           (long long)expected_rows, io.read_bytes / 1024.0, (unsigned long long)io.reads,
+           speedup);
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    vector<int64_t> device_counts = args.get_int_list("devices", {10000, 100000});
+    int64_t points = max<int64_t>(1, args.get_int("points-per-device", 10));
+    vector<string> query_names = args.get_string_list("queries", {"eq", "in", "prefix", "regex"});
+    bool client = args.has("client");
+    int64_t repeat = args.get_int("repeat", 3);
+
+    printf("%-10s %-8s %-10s %-6s %10s %10s %12s %12s %12s %12s %8s %8s\n", "devices", "query",
+           "mode", "round", "open_ms", "query_ms", "total_ms", "rows", "expected", "read_KB",
+           "reads", "speedup");
+    for (int64_t devices : device_counts) {
+        harness::TableDatasetConfig config;
+        config.table_name = "bench_tag_table";
+        config.tag_count = 2;
+        config.tag_cardinality = max<int64_t>(1, devices);
+        config.rows = config.tag_cardinality * points;
+        config.field_count = args.get_int("fields", 4);
+        config.type_name = args.get_string("type", "INT64");
+        config.tablet_rows = args.get_int("tablet-rows", 1024);
+        string file_path = harness::resolve_data_path("bench_tag_filter.tsfile");
+        harness::TableDatasetStats stats;
+        int ret = harness::write_table_dataset(file_path, config, stats);
+        if (ret != E_OK) {
+            cerr << "generate data failed, error code: " << ret << endl;
+            return ret;
+        }
+        printf("# devices=%lld rows=%lld size_MB=%.2f write_s=%.3f\n", (long long)devices,
+               (long long)config.rows, harness::to_mb(stats.file_bytes),
+               stats.fill_s + stats.write_s + stats.flush_close_s);
+        vector<string> columns = harness::dataset_schema(config).column_names;
+        harness::IoAccounting::instance().enable(file_path);
+
+        for (const string& name : query_names) {
+            vector<harness::TagPredicate> predicates;
+            if (!make_predicates(name, config.tag_cardinality, predicates)) {
+                cerr << "unknown query: " << name << endl;
+                return 1;
+            }
+            int64_t expected_rows = matched_devices(predicates, config.tag_cardinality) *
+                                    (config.rows / config.tag_cardinality);
+            for (int64_t round = 0; round < repeat; round++) {
+                harness::TagQueryResult pushdown;
+                ret = harness::run_tag_query(file_path, config.table_name, columns, predicates,
+                                             true, pushdown);
+                if (ret != E_OK) {
+                    cerr << name << " query failed, error code: " << ret << endl;
+                    return ret;
+                }
+                double speedup = 0;
+                if (client) {
+                    harness::TagQueryResult scan;
+                    ret = harness::run_tag_query(file_path, config.table_name, columns, predicates,
+                                                 false, scan);
+                    if (ret != E_OK) {
+                        cerr << name << " client scan failed, error code: " << ret << endl;
+                        return ret;
+                    }
+                    print_result(devices, name, "client", round, scan, expected_rows, 1);
+                    speedup = pushdown.total_s > 0 ? scan.total_s / pushdown.total_s : 0;
+                }
+                print_result(devices, name, "pushdown", round, pushdown, expected_rows, speedup);
+                if (pushdown.scan.rows != expected_rows) {
+                    cerr << name << ": expected " << expected_rows << " rows, got "
+                         << pushdown.scan.rows << endl;
+                    return 1;
+                }
+            }
+        }
+        harness::IoAccounting::instance().disable();
+    }
+    return 0;
+}
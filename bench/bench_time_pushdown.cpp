@@ -0,0 +1,128 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+#include "harness/time_window.h"
+
+using namespace common;
+using namespace std;
+
+/**
+ * 时间范围下推性能测试：写入覆盖一天的数据（所有设备按时间顺序写入，每小时 flush 一次），
+ * 在数据的开始、中间、结束位置执行窄时间窗口查询，与全表扫描对比耗时和读取的字节数。
+ * 窄窗口查询读取的字节数应与窗口宽度成正比，而不是与文件大小成正比。
+ *
+ * 参数：
+ *   --devices=100               设备数量
+ *   --fields=4 --type=DOUBLE --shape=RANDOM_WALK   FIELD 列数量、数据类型和数据形态
+ *   --interval-ms=1000          每个设备的采样间隔（毫秒）
+ *   --hours=24                  数据覆盖的小时数
+ *   --flush-minutes=60          每写入多少分钟的数据 flush 一次
+ *   --window-minutes=5          查询窗口宽度（分钟，逗号分隔）
+ *   --positions=start,middle,end   窗口位置（逗号分隔），另有 before / after 表示数据之外的窗口
+ *   --tablet-rows=1024          每个 tablet 的最大行数
+ *   --seed=42                   数据生成器的随机种子
+ *   --repeat=3                  每种查询重复次数
+ */
+
+// 输出一行结果
+void print_result(const string& name, int64_t round, const harness::WindowQueryResult& result,
+                  int64_t expected_rows, uint64_t file_bytes) {
+    harness::IoCounters io = result.io.total();
+    printf("%-22s %-6lld %10.3f %10.3f %12.3f %10.3f %10lld %10lld %12.1f %8llu %8llu %8.2f\n",
+           name.c_str(), (long long)round, result.open_s * 1000, result.query_s * 1000,
+           result.scan.first_row_s * 1000, result.total_s * 1000, (long long)result.scan.rows,
+           (long long)expected_rows, io.read_bytes / 1024.0, (unsigned long long)io.reads,
+           (unsigned long long)io.random_reads,
+           file_bytes > 0 ? 100.0 * io.read_bytes / file_bytes : 0);
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TimeSeriesDatasetConfig config;
+    config.devices = max<int64_t>(1, args.get_int("devices", 100));
+    config.field_count = args.get_int("fields", 4);
+    config.type_name = args.get_string("type", "DOUBLE");
+    config.field_shape = args.get_string("shape", "RANDOM_WALK");
+    config.interval = max<int64_t>(1, args.get_int("interval-ms", 1000));
+    config.duration = args.get_int("hours", 24) * 3600 * 1000;
+    config.flush_interval = args.get_int("flush-minutes", 60) * 60 * 1000;
+    config.tablet_rows = args.get_int("tablet-rows", 1024);
+    config.seed = static_cast<uint64_t>(args.get_int("seed", 42));
+    vector<int64_t> window_minutes = args.get_int_list("window-minutes", {5});
+    vector<string> positions = args.get_string_list("positions", {"start", "middle", "end"});
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string file_path = harness::resolve_data_path("bench_time_pushdown.tsfile");
+    harness::TableDatasetStats stats;
+    int ret = harness::write_time_series_dataset(file_path, config, stats);
+    if (ret != E_OK) {
+        cerr << "generate data failed, error code: " << ret << endl;
+        return ret;
+    }
+    vector<string> columns = harness::time_series_schema(config).column_names;
+    harness::IoAccounting::instance().enable(file_path);
+
+    printf("file=%s size_MB=%.2f devices=%lld points_per_device=%lld chunk_groups_per_device=%lld\n",
+           file_path.c_str(), harness::to_mb(stats.file_bytes), (long long)config.devices,
+           (long long)harness::time_series_points(config),
+           (long long)((config.duration + config.flush_interval - 1) /
+                       max<int64_t>(1, config.flush_interval)));
+    printf("%-22s %-6s %10s %10s %12s %10s %10s %10s %12s %8s %8s %8s\n", "query", "round",
+           "open_ms", "query_ms", "first_row_ms", "total_ms", "rows", "expected", "read_KB",
+           "reads", "random", "read_%");
+
+    int64_t first_time = config.start_time;
+    int64_t last_time = harness::time_series_end_time(config);
+    for (int64_t round = 0; round < repeat; round++) {
+        harness::WindowQueryResult result;
+        ret = harness::run_window_query(file_path, config.table_name, columns, first_time,
+                                        last_time, result);
+        if (ret != E_OK) {
+            cerr << "query failed, error code: " << ret << endl;
+            return ret;
+        }
+        print_result("full_scan", round, result,
+                     harness::time_window_expected_rows(config, first_time, last_time),
+                     stats.file_bytes);
+    }
+
+    for (int64_t minutes : window_minutes) {
+        for (const string& position : positions) {
+            int64_t start_time = 0;
+            int64_t end_time = 0;
+            if (!harness::time_window(config, position, minutes * 60 * 1000, start_time,
+                                      end_time)) {
+                cerr << "unknown position: " << position << endl;
+                return 1;
+            }
+            int64_t expected_rows = harness::time_window_expected_rows(config, start_time, end_time);
+            string name = position + "_" + to_string(minutes) + "min";
+            for (int64_t round = 0; round < repeat; round++) {
+                harness::WindowQueryResult result;
+                ret = harness::run_window_query(file_path, config.table_name, columns, start_time,
+                                                end_time, result);
+                if (ret != E_OK) {
+                    cerr << "query failed, error code: " << ret << endl;
+                    return ret;
+                }
+                print_result(name, round, result, expected_rows, stats.file_bytes);
+                if (result.scan.rows != expected_rows) {
+                    cerr << name << ": expected " << expected_rows << " rows, got "
+                         << result.scan.rows << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/tree_dataset.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 树模型对齐设备与非对齐设备的对比性能测试：以相同的数据（harness/tree_dataset.h）分别写入
+ * 非对齐（register_timeseries + write_tablet）和对齐（register_aligned_timeseries + write_tablet_aligned）文件，
+ * 输出写入耗时和吞吐、文件大小和每个数据点的字节数，然后按设备查询多个测点，输出读取吞吐。
+ * 两种布局读出的行数和校验和不一致时退出并返回 1。
+ *
+ * 参数：
+ *   --devices=1000              设备数
+ *   --measurements=20           每个设备的测点数
+ *   --rows=1000                 每个设备写入的行数
+ *   --tablet-rows=1024          每个 tablet 的最大行数
+ *   --type=INT64                测点数据类型，MIXED 表示多种类型轮换
+ *   --read-devices=0            读取的设备数（均匀选取），0 表示全部
+ *   --read-measurements=1,5,0   每次查询的测点数（逗号分隔），0 表示全部测点
+ *   --repeat=3                  每种布局重复次数
+ */
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TreeDatasetConfig config;
+    config.devices = max<int64_t>(1, args.get_int("devices", 1000));
+    config.measurements = max<int64_t>(1, args.get_int("measurements", 20));
+    config.rows_per_device = max<int64_t>(1, args.get_int("rows", 1000));
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    config.type_name = args.get_string("type", "INT64");
+    int64_t read_devices = args.get_int("read-devices", 0);
+    vector<int64_t> read_measurements_list = args.get_int_list("read-measurements", {1, 5, 0});
+    int64_t repeat = args.get_int("repeat", 3);
+    if (config.type_name != "MIXED" &&
+        harness::string_to_datatype(config.type_name) == TSDataType::INVALID_DATATYPE) {
+        cerr << "Unsupported data type: " << config.type_name << endl;
+        return 1;
+    }
+
+    printf("devices=%lld measurements=%lld rows=%lld type=%s\n", (long long)config.devices,
+           (long long)config.measurements, (long long)config.rows_per_device,
+           config.type_name.c_str());
+    printf("%-12s %-6s %10s %10s %14s %10s %10s\n", "layout", "round", "reg_s", "write_s",
+           "points/s", "file_MB", "B/point");
+    // 第二个表格：每种布局、每个测点数的读取结果
+    struct ReadRow {
+        string layout;
+        int64_t round;
+        int64_t measurements;
+        harness::TreeReadStats stats;
+    };
+    vector<ReadRow> read_rows;
+    map<int64_t, pair<int64_t, uint64_t>> expected;   // 测点数 -> 非对齐布局的行数和校验和
+    map<int64_t, double> nonaligned_rate;
+    for (bool aligned : {false, true}) {
+        config.aligned = aligned;
+        string layout = aligned ? "aligned" : "nonaligned";
+        string file_path =
+            harness::resolve_data_path("bench_tree_aligned." + layout + ".tsfile");
+        for (int64_t round = 0; round < repeat; round++) {
+            harness::TreeDatasetStats stats;
+            int ret = harness::write_tree_dataset(file_path, config, stats);
+            if (ret != E_OK) {
+                cerr << layout << " write failed, error code: " << ret << endl;
+                return ret;
+            }
+            double points = static_cast<double>(stats.points(config));
+            double write_s = stats.write_s + stats.flush_s + stats.close_s;
+            printf("%-12s %-6lld %10.3f %10.3f %14.0f %10.2f %10.2f\n", layout.c_str(),
+                   (long long)round, stats.register_s, write_s,
+                   harness::per_second(points, write_s), harness::to_mb(stats.file_bytes),
+                   stats.file_bytes / points);
+            for (int64_t read_measurements : read_measurements_list) {
+                int64_t measurements = read_measurements > 0
+                                           ? min(read_measurements, config.measurements)
+                                           : config.measurements;
+                ReadRow row{layout, round, measurements, harness::TreeReadStats()};
+                ret = harness::read_tree_dataset(file_path, config, read_devices, measurements,
+                                                 row.stats);
+                if (ret != E_OK) {
+                    cerr << layout << " read failed, error code: " << ret << endl;
+                    return ret;
+                }
+                auto result = make_pair(row.stats.scan.rows, row.stats.scan.checksum);
+                if (!aligned) {
+                    expected[measurements] = result;
+                } else if (expected[measurements] != result) {
+                    cerr << "aligned read mismatch for " << measurements << " measurements" << endl;
+                    return 1;
+                }
+                read_rows.push_back(row);
+            }
+        }
+    }
+
+    printf("\n%-12s %-6s %-6s %10s %12s %10s %14s %14s %10s\n", "layout", "round", "meas",
+           "queries", "query_ms/q", "scan_s", "rows/s", "points/s", "speedup");
+    for (const ReadRow& row : read_rows) {
+        const harness::TreeReadStats& stats = row.stats;
+        double read_s = stats.query_s + stats.scan_s;
+        double rate = harness::per_second(stats.scan.cells, read_s);
+        if (row.layout == "nonaligned") {
+            nonaligned_rate[row.measurements] = max(nonaligned_rate[row.measurements], rate);
+        }
+        double baseline = nonaligned_rate[row.measurements];
+        printf("%-12s %-6lld %-6lld %10lld %12.3f %10.3f %14.0f %14.0f %10.2f\n",
+               row.layout.c_str(), (long long)row.round, (long long)row.measurements,
+               (long long)stats.queries, stats.query_s * 1e3 / max<int64_t>(1, stats.queries),
+               stats.scan_s, harness::per_second(stats.scan.rows, read_s), rate,
+               baseline > 0 ? rate / baseline : 0);
+    }
+    return 0;
+}
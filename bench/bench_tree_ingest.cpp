@@ -0,0 +1,109 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 分配计数只在 *_alloc 版本中启用（见 bench/CMakeLists.txt），计时版本不替换 malloc / operator new
+#ifdef HARNESS_ENABLE_ALLOC_COUNTER
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#endif
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#include "harness/tree_dataset.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 树模型写入扩展性性能测试：设备数 × 每设备测点数的矩阵，驱动 TsFileWriter 的
+ * register_timeseries、write_tablet、flush、close 并分别计时（数据集见 harness/tree_dataset.h）。
+ * 每个组合写入的数据点总数大致相同（每设备行数 = --points / 时间序列数，至少 1 行），
+ * 便于比较时间序列数量本身带来的开销。内存输出：
+ *   reg_B/series —— 注册后堆内存的净增长 / 时间序列数（写入器中每个时间序列的元数据开销）
+ *   buffer_MB    —— 全部 write_tablet 之后、flush 之前堆内存的净增长（写入器缓存的数据）
+ *   peak_MB      —— 注册到关闭期间堆内存占用峰值的增量；rss_MB 为同一期间峰值常驻内存的增量
+ * 分配统计需要 harness/alloc_counter.h 的替换函数，只在 bench_tree_ingest_alloc 中启用，reg_B/series、buffer_MB、
+ * peak_MB 三列只在该版本中输出；bench_tree_ingest 不统计分配，耗时和吞吐以该版本为准。rss_MB 需要 Linux 4.0 及以上。
+ *
+ * 参数：
+ *   --devices=1,100,10000,100000       设备数（逗号分隔）
+ *   --measurements=1,10,100,1000       每个设备的测点数（逗号分隔）
+ *   --points=10000000                  每个组合写入的数据点总数
+ *   --max-series=1000000               时间序列数（设备数 × 测点数）超过该值的组合跳过
+ *   --tablet-rows=1024                 每个 tablet 的最大行数
+ *   --type=INT64                       测点数据类型，MIXED 表示多种类型轮换
+ *   --repeat=1                         每个组合重复次数
+ */
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    vector<int64_t> devices_list = args.get_int_list("devices", {1, 100, 10000, 100000});
+    vector<int64_t> measurements_list = args.get_int_list("measurements", {1, 10, 100, 1000});
+    int64_t points = max<int64_t>(1, args.get_int("points", 10000000));
+    int64_t max_series = args.get_int("max-series", 1000000);
+    int64_t repeat = args.get_int("repeat", 1);
+    harness::TreeDatasetConfig config;
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    config.type_name = args.get_string("type", "INT64");
+    if (config.type_name != "MIXED" &&
+        harness::string_to_datatype(config.type_name) == TSDataType::INVALID_DATATYPE) {
+        cerr << "Unsupported data type: " << config.type_name << endl;
+        return 1;
+    }
+
+    string file_path = harness::resolve_data_path("bench_tree_ingest.tsfile");
+    printf("points=%lld tablet_rows=%lld type=%s alloc_counter=%s\n", (long long)points,
+           (long long)config.tablet_rows, config.type_name.c_str(),
+           harness::AllocCounter::installed() ? "on" : "off");
+    bool alloc_columns = harness::AllocCounter::installed();
+    printf("%-8s %-8s %-10s %-8s %-6s %10s %12s %10s %14s %10s %10s %10s", "devices", "meas",
+           "series", "rows/dev", "round", "reg_s", "reg_us/ser", "write_s", "points/s", "flush_s",
+           "close_s", "file_MB");
+    if (alloc_columns) {
+        printf(" %14s %10s %10s", "reg_B/series", "buffer_MB", "peak_MB");
+    }
+    printf(" %10s\n", "rss_MB");
+    for (int64_t devices : devices_list) {
+        for (int64_t measurements : measurements_list) {
+            config.devices = max<int64_t>(1, devices);
+            config.measurements = max<int64_t>(1, measurements);
+            int64_t series = config.devices * config.measurements;
+            if (series > max_series) {
+                printf("%-8lld %-8lld %-10lld skipped (series > --max-series)\n",
+                       (long long)config.devices, (long long)config.measurements,
+                       (long long)series);
+                continue;
+            }
+            config.rows_per_device = max<int64_t>(1, points / series);
+            for (int64_t round = 0; round < repeat; round++) {
+                harness::TreeDatasetStats stats;
+                int ret = harness::write_tree_dataset(file_path, config, stats);
+                if (ret != E_OK) {
+                    cerr << "write failed, error code: " << ret << endl;
+                    return ret;
+                }
+                double written = static_cast<double>(stats.points(config));
+                printf("%-8lld %-8lld %-10lld %-8lld %-6lld %10.3f %12.3f %10.3f %14.0f %10.3f "
+                       "%10.3f %10.2f",
+                       (long long)config.devices, (long long)config.measurements,
+                       (long long)series, (long long)config.rows_per_device, (long long)round,
+                       stats.register_s, stats.register_s * 1e6 / series, stats.write_s,
+                       harness::per_second(written, stats.write_s), stats.flush_s, stats.close_s,
+                       harness::to_mb(stats.file_bytes));
+                if (alloc_columns) {
+                    printf(" %14.1f %10.2f %10.2f",
+                           static_cast<double>(stats.register_allocs.live_bytes) / series,
+                           harness::to_mb(stats.write_allocs.live_bytes),
+                           harness::to_mb(stats.peak_live_bytes));
+                }
+                printf(" %10.2f\n", stats.rss_growth_kb < 0 ? -1.0 : stats.rss_growth_kb / 1024.0);
+            }
+        }
+    }
+    return 0;
+}
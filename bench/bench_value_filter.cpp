@@ -0,0 +1,134 @@
+#include "common/db_common.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+#include "harness/tree_dataset.h"
+#include "harness/value_query.h"
+
+using namespace common;
+using namespace std;
+
+/**
+ * 取值条件查询性能测试：在一个树模型设备上执行 s0 > X AND s1 < Y 形式的查询，选择率从 0.01% 到 100%，
+ * 对比条件下推（基于时间生成器的结果集，只解码满足条件的时间戳上的其余测点，并按统计信息跳过数据）
+ * 与读取全部行后在客户端过滤的耗时和读取量。库不提供解码计数，数据 page 在遍历结果集（NEXT 阶段）时读取，
+ * 读到的 page 都会被解码，因此以 NEXT 阶段的读取字节数和 read 次数（next_KB、next_reads）近似解码量，
+ * read_KB 为包括打开文件、读取索引在内的全部读取字节数。
+ * 数据见 harness/tree_dataset.h：s0 = v(t)，s1 = v(t) + 1，条件选取 v 居中的一段连续取值：
+ *   sorted     v(t) = t，满足条件的行在时间上连续，统计信息可以跳过其余 chunk / page
+ *   scrambled  v 为时间戳的伪随机排列，满足条件的行分散在全部 page 中，统计信息无法跳过数据
+ *
+ * 参数：
+ *   --rows=10000000                     设备的行数
+ *   --measurements=4                    测点数（至少 2，s0、s1 为条件测点），每次查询读取全部测点
+ *   --tablet-rows=1024                  每个 tablet 的行数
+ *   --flush-tablets=64                  每写入该数量的 tablet 后 flush 一次（0 表示只在最后 flush）
+ *   --selectivity=0.01,0.1,1,10,100     选择率（百分比，逗号分隔）
+ *   --order=sorted,scrambled            数据分布（逗号分隔），每种分布生成一个数据文件
+ *   --client                            同时执行读取全部行后客户端过滤，输出下推的加速比
+ *   --repeat=3                          每种选择率重复次数
+ */
+
+// 输出一行结果
+void print_result(const string& order, double percent, const string& mode, int64_t round,
+                  const harness::ValueQueryResult& result, int64_t expected_rows, double speedup) {
+    harness::IoCounters io = result.io.total();
+    const harness::IoCounters& next = result.io.phase(harness::IoPhase::NEXT);
+    printf("%-10s %10.4f %-10s %-6lld %12lld %12lld %12.1f %10llu %12.1f %12.3f %8.2f\n",
+           order.c_str(), percent, mode.c_str(), (long long)round, (long long)result.scan.rows,
+           (long long)expected_rows, next.read_bytes / 1024.0, (unsigned long long)next.reads,
+           io.read_bytes / 1024.0, result.total_s * 1000, speedup);
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    storage::libtsfile_init();
+
+    harness::TreeDatasetConfig config;
+    config.devices = 1;
+    config.measurements = max<int64_t>(2, args.get_int("measurements", 4));
+    config.rows_per_device = max<int64_t>(1, args.get_int("rows", 10000000));
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    config.flush_tablets = args.get_int("flush-tablets", 64);
+    config.type_name = "INT64";
+    vector<string> percents = args.get_string_list("selectivity", {"0.01", "0.1", "1", "10", "100"});
+    vector<string> orders = args.get_string_list("order", {"sorted", "scrambled"});
+    bool client = args.has("client");
+    int64_t repeat = args.get_int("repeat", 3);
+
+    string device_id = harness::tree_device_id(config, 0);
+    vector<string> measurements;
+    for (int64_t m = 0; m < config.measurements; m++) {
+        measurements.push_back("s" + to_string(m));
+    }
+    printf("%-10s %10s %-10s %-6s %12s %12s %12s %10s %12s %12s %8s\n", "order", "select_%",
+           "mode", "round", "rows", "expected", "next_KB", "next_reads", "read_KB", "total_ms",
+           "speedup");
+    for (const string& order : orders) {
+        if (order != "sorted" && order != "scrambled") {
+            cerr << "unknown order: " << order << endl;
+            return 1;
+        }
+        config.scrambled = order == "scrambled";
+        string file_path = harness::resolve_data_path("bench_value_filter." + order + ".tsfile");
+        harness::TreeDatasetStats stats;
+        int ret = harness::write_tree_dataset(file_path, config, stats);
+        if (ret != E_OK) {
+            cerr << "generate data failed, error code: " << ret << endl;
+            return ret;
+        }
+        printf("# order=%s rows=%lld size_MB=%.2f write_s=%.3f\n", order.c_str(),
+               (long long)config.rows_per_device, harness::to_mb(stats.file_bytes),
+               stats.fill_s + stats.write_s + stats.flush_s + stats.close_s);
+        harness::IoAccounting::instance().enable(file_path);
+
+        for (const string& percent_text : percents) {
+            double percent = stod(percent_text);
+            // 选取 v 居中的 width 个连续取值：s0 > low - 1 AND s1 < low + width + 1
+            int64_t width = min(config.rows_per_device,
+                                max<int64_t>(1, llround(config.rows_per_device * percent / 100)));
+            int64_t low = (config.rows_per_device - width) / 2;
+            vector<harness::ValuePredicate> predicates = {
+                harness::ValuePredicate::gt("s0", low - 1),
+                harness::ValuePredicate::lt("s1", low + width + 1)};
+            for (int64_t round = 0; round < repeat; round++) {
+                harness::ValueQueryResult pushdown;
+                ret = harness::run_value_query(file_path, device_id, measurements, predicates,
+                                               true, pushdown);
+                if (ret != E_OK) {
+                    cerr << percent_text << "% query failed, error code: " << ret << endl;
+                    return ret;
+                }
+                double speedup = 0;
+                if (client) {
+                    harness::ValueQueryResult scan;
+                    ret = harness::run_value_query(file_path, device_id, measurements, predicates,
+                                                   false, scan);
+                    if (ret != E_OK) {
+                        cerr << percent_text << "% client scan failed, error code: " << ret
+                             << endl;
+                        return ret;
+                    }
+                    print_result(order, percent, "client", round, scan, width, 1);
+                    speedup = pushdown.total_s > 0 ? scan.total_s / pushdown.total_s : 0;
+                }
+                print_result(order, percent, "pushdown", round, pushdown, width, speedup);
+                if (pushdown.scan.rows != width) {
+                    cerr << percent_text << "%: expected " << width << " rows, got "
+                         << pushdown.scan.rows << endl;
+                    return 1;
+                }
+            }
+        }
+        harness::IoAccounting::instance().disable();
+    }
+    return 0;
+}
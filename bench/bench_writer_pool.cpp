@@ -0,0 +1,172 @@
+#include "common/db_common.h"
+#include "common/tablet.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/table_dataset.h"
+#include "harness/writer_pool.h"
+
+using namespace storage;
+using namespace common;
+using namespace std;
+
+/**
+ * 多线程分片写入扩展性测试：T 个生产线程构造单设备 tablet，
+ * 通过 WriterPool 按设备哈希路由到 N 个分片（默认 N = T），输出聚合吞吐与线程数的关系。
+ * N >= T 时按分片把设备分给线程（分片 s 的设备由线程 s % T 写入），每个分片只有一个线程写入，
+ * 线程之间不争用分片的互斥锁；N < T 时按设备编号轮流分配，多个线程共用分片。
+ *
+ * 参数：
+ *   --threads=1,2,4,8           生产线程数（逗号分隔时依次测试）
+ *   --shards=0                  分片数，0 表示与线程数相同
+ *   --rows=4000000              写入总行数（所有线程合计）
+ *   --tablet-rows=1024          每个 tablet 的行数
+ *   --fields=10 --type=INT64    FIELD 列数量和类型（TAG 列固定 1 列）
+ *   --devices=1000              设备数量
+ */
+
+string device_key(int64_t device) { return "device_" + to_string(device); }
+
+// 把设备分给线程，返回每个线程负责的设备
+vector<vector<int64_t>> assign_devices(const harness::WriterPool& pool, int64_t devices,
+                                       int64_t threads) {
+    vector<vector<int64_t>> assigned(threads);
+    bool by_shard = static_cast<int64_t>(pool.shard_count()) >= threads;
+    for (int64_t d = 0; d < devices; d++) {
+        int64_t owner = by_shard ? static_cast<int64_t>(pool.shard_for(device_key(d))) % threads
+                                 : d % threads;
+        assigned[owner].push_back(d);
+    }
+    return assigned;
+}
+
+// 一个生产线程：轮流为负责的每个设备写入一个 tablet
+int produce(harness::WriterPool& pool, const harness::TableDatasetConfig& config,
+            const harness::TableDatasetSchema& schema, const vector<int64_t>& my_devices,
+            int64_t rows) {
+    vector<TSDataType> field_types = harness::dataset_field_types(config);
+    vector<string> text_pool;
+    for (int i = 0; i < 16; i++) {
+        text_pool.push_back("value_" + to_string(i));
+    }
+    if (my_devices.empty()) {
+        return E_OK;
+    }
+    vector<string> device_keys;
+    for (int64_t d : my_devices) {
+        device_keys.push_back(device_key(d));
+    }
+    vector<int64_t> next_timestamp(my_devices.size(), 0);
+    int64_t written = 0;
+    size_t turn = 0;
+    while (written < rows) {
+        uint32_t batch_rows = static_cast<uint32_t>(min<int64_t>(config.tablet_rows, rows - written));
+        size_t k = turn++ % my_devices.size();
+        Tablet tablet(config.table_name, schema.column_names, schema.data_types,
+                      schema.column_categories, static_cast<int>(batch_rows));
+        for (uint32_t r = 0; r < batch_rows; r++) {
+            int64_t timestamp = next_timestamp[k]++;
+            int ret = tablet.add_timestamp(r, timestamp);
+            if (ret == E_OK) {
+                ret = tablet.add_value(r, 0u, device_keys[k].c_str());
+            }
+            for (int64_t f = 0; f < config.field_count && ret == E_OK; f++) {
+                ret = harness::dataset_fill_value(tablet, r, static_cast<uint32_t>(1 + f),
+                                                  field_types[f], timestamp + f, timestamp,
+                                                  text_pool);
+            }
+            if (ret != E_OK) {
+                return ret;
+            }
+        }
+        int ret = pool.write(device_keys[k], tablet);
+        if (ret != E_OK) {
+            return ret;
+        }
+        written += batch_rows;
+    }
+    return E_OK;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    harness::init_tsfile_once();
+
+    harness::TableDatasetConfig config;
+    config.rows = args.get_int("rows", 4000000);
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 1024));
+    config.tag_count = 1;
+    config.field_count = args.get_int("fields", 10);
+    config.type_name = args.get_string("type", "INT64");
+    int64_t devices = max<int64_t>(1, args.get_int("devices", 1000));
+    int64_t shards_arg = args.get_int("shards", 0);
+    vector<int64_t> thread_list = args.get_int_list("threads", {1, 2, 4, 8});
+    harness::TableDatasetSchema schema = harness::dataset_schema(config);
+
+    printf("rows=%lld fields=%lld type=%s devices=%lld hardware_threads=%u\n",
+           (long long)config.rows, (long long)config.field_count, config.type_name.c_str(),
+           (long long)devices, thread::hardware_concurrency());
+    printf("%-8s %-8s %10s %14s %14s %10s %10s\n", "threads", "shards", "elapsed_s", "rows/s",
+           "points/s", "MB/s", "speedup");
+    double base_rate = 0;
+    for (int64_t threads : thread_list) {
+        threads = max<int64_t>(1, threads);
+        int64_t shards = shards_arg > 0 ? shards_arg : threads;
+        // 分片文件以 O_TRUNC 方式创建，已存在时被覆盖
+        string prefix = harness::resolve_data_path("bench_writer_pool", false);
+        harness::WriterPool pool(prefix, config.table_name, schema.column_schemas,
+                                 static_cast<size_t>(shards));
+        if (pool.init_code() != E_OK) {
+            cerr << "create writer pool failed, error code: " << pool.init_code() << endl;
+            return pool.init_code();
+        }
+        vector<vector<int64_t>> assigned = assign_devices(pool, devices, threads);
+        for (const auto& my_devices : assigned) {
+            if (my_devices.empty()) {
+                cerr << "a thread has no devices, increase --devices" << endl;
+                return 1;
+            }
+        }
+
+        atomic<int> error(E_OK);
+        harness::Stopwatch watch;
+        vector<thread> workers;
+        for (int64_t t = 0; t < threads; t++) {
+            int64_t rows = config.rows / threads + (t < config.rows % threads ? 1 : 0);
+            workers.emplace_back([&, t, rows]() {
+                int ret = produce(pool, config, schema, assigned[t], rows);
+                if (ret != E_OK) {
+                    error = ret;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        int ret = pool.close();
+        double elapsed = watch.elapsed_s();
+        if (error != E_OK || ret != E_OK) {
+            cerr << "write failed, error code: " << (error != E_OK ? error.load() : ret) << endl;
+            return 1;
+        }
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < pool.shard_count(); i++) {
+            bytes += harness::file_size_bytes(pool.file_path(i));
+        }
+        double rate = harness::per_second(config.rows, elapsed);
+        if (base_rate == 0) {
+            base_rate = rate;
+        }
+        printf("%-8lld %-8lld %10.3f %14.0f %14.0f %10.2f %10.2f\n", (long long)threads,
+               (long long)shards, elapsed, rate, rate * config.field_count,
+               harness::per_second(harness::to_mb(bytes), elapsed), rate / base_rate);
+    }
+    return 0;
+}
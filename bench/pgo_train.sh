@@ -0,0 +1,24 @@
+#!/bin/bash
+# PGO 训练脚本：使用性能测试的典型负载运行插桩后的程序，生成 profile 数据
+# 用法：
+#   cmake -DCMAKE_BUILD_TYPE=Release -DPGO_MODE=GENERATE .. && make
+#   ../bench/pgo_train.sh .
+#   cmake -DPGO_MODE=USE .. && make
+set -e
+
+BUILD_DIR=${1:-.}
+BENCH_DIR=${BUILD_DIR}/bench
+
+if [ ! -x "${BENCH_DIR}/bench_table_write" ]; then
+    echo "bench executables not found in ${BENCH_DIR}, build with -DPGO_MODE=GENERATE first"
+    exit 1
+fi
+
+# 写入负载：单一类型与混合类型、小 tablet 与大 tablet
+"${BENCH_DIR}/bench_table_write" --rows=500000 --tablet-rows=1024,8192 --type=INT64
+"${BENCH_DIR}/bench_table_write" --rows=500000 --tablet-rows=1024 --type=MIXED --tag-cardinality=1000
+
+# 读取负载：全表扫描与窄时间范围查询
+"${BENCH_DIR}/bench_table_read" --rows=500000 --type=MIXED --repeat=1
+
+echo "PGO profile generated, reconfigure with -DPGO_MODE=USE and rebuild"
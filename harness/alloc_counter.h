@@ -0,0 +1,316 @@
+#ifndef HARNESS_ALLOC_COUNTER_H
+#define HARNESS_ALLOC_COUNTER_H
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/**
+ * 内存分配计数：替换 malloc / calloc / realloc / free（以及对齐分配函数）和全局 operator new / delete，
+ * 统计分配次数、释放次数、申请的字节数、当前占用的堆内存和占用峰值，
+ * 用于测试用例和性能测试输出每个写入数据点、每个读取行的分配次数，并按预算断言。
+ *
+ * 使用方式：在可执行文件的一个源文件中定义 HARNESS_ALLOC_COUNTER_HOOKS 后包含本头文件
+ * （定义替换函数，转发给 glibc 的 __libc_malloc 等实现），其他源文件直接包含即可；未定义时计数始终为 0。
+ * operator new / delete 转发给 malloc / free，每次分配只计数一次。
+ * 计数是进程级的，包含所有线程和库内部的分配；占用按 malloc_usable_size 计算（含分配器的对齐填充）。
+ * 用 AllocScope 统计一个阶段（一个测试用例、写入、读取等）的分配和该阶段内的占用峰值。
+ */
+namespace harness {
+
+// 分配计数的快照
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes = 0;             // 申请的字节数累计（不减去释放的字节数）
+    int64_t live_bytes = 0;         // 当前占用的堆内存；since 之后为该阶段的净增长
+    uint64_t peak_live_bytes = 0;   // 占用峰值；AllocScope::stats 中为高出阶段开始时占用的部分
+
+    // 两次快照之差（this - before），峰值为高出 before 时占用的部分
+    // （before 之前的峰值未重置时不准确，需要阶段内的峰值时使用 AllocScope）
+    AllocStats since(const AllocStats& before) const {
+        AllocStats diff;
+        diff.allocations = allocations - before.allocations;
+        diff.deallocations = deallocations - before.deallocations;
+        diff.bytes = bytes - before.bytes;
+        diff.live_bytes = live_bytes - before.live_bytes;
+        uint64_t base = static_cast<uint64_t>(std::max<int64_t>(0, before.live_bytes));
+        diff.peak_live_bytes = peak_live_bytes > base ? peak_live_bytes - base : 0;
+        return diff;
+    }
+
+    // 累加另一个阶段的差值（不含峰值）
+    void add(const AllocStats& other) {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        bytes += other.bytes;
+        live_bytes += other.live_bytes;
+    }
+
+    // 每个单位（数据点、行）的分配次数和申请字节数，units 为 0 时按 1 计算
+    double allocations_per(double units) const { return allocations / std::max(units, 1.0); }
+    double bytes_per(double units) const { return bytes / std::max(units, 1.0); }
+};
+
+class AllocCounter {
+   public:
+    static AllocStats snapshot() {
+        AllocStats stats;
+        stats.allocations = allocations_.load(std::memory_order_relaxed);
+        stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+        stats.bytes = bytes_.load(std::memory_order_relaxed);
+        stats.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+        stats.peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // 是否定义了替换函数
+    static bool installed() { return installed_.load(std::memory_order_relaxed); }
+
+    // 把占用峰值重置为当前占用，返回重置前的峰值
+    static uint64_t reset_peak() {
+        int64_t live = std::max<int64_t>(0, live_bytes_.load(std::memory_order_relaxed));
+        return peak_live_bytes_.exchange(static_cast<uint64_t>(live), std::memory_order_relaxed);
+    }
+
+    // 占用峰值至少为 peak
+    static void raise_peak(uint64_t peak) {
+        uint64_t current = peak_live_bytes_.load(std::memory_order_relaxed);
+        while (current < peak &&
+               !peak_live_bytes_.compare_exchange_weak(current, peak, std::memory_order_relaxed)) {
+        }
+    }
+
+    // 以下由替换函数调用：size 为申请的字节数，usable 为分配器实际占用的字节数
+    static void on_alloc(size_t size, size_t usable) {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+        int64_t live = live_bytes_.fetch_add(static_cast<int64_t>(usable), std::memory_order_relaxed) +
+                       static_cast<int64_t>(usable);
+        if (live > 0) {
+            raise_peak(static_cast<uint64_t>(live));
+        }
+    }
+    static void on_free(size_t usable) {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+        live_bytes_.fetch_sub(static_cast<int64_t>(usable), std::memory_order_relaxed);
+    }
+    static void set_installed() { installed_.store(true, std::memory_order_relaxed); }
+
+   private:
+    static inline std::atomic<uint64_t> allocations_{0};
+    static inline std::atomic<uint64_t> deallocations_{0};
+    static inline std::atomic<uint64_t> bytes_{0};
+    static inline std::atomic<int64_t> live_bytes_{0};
+    static inline std::atomic<uint64_t> peak_live_bytes_{0};
+    static inline std::atomic<bool> installed_{false};
+};
+
+/**
+ * 统计一个阶段的分配：构造时记录快照并重置占用峰值，stats() 返回从构造到调用时的差值
+ * 可以嵌套，析构时恢复外层阶段的峰值
+ */
+class AllocScope {
+   public:
+    AllocScope() : outer_peak_(AllocCounter::reset_peak()), before_(AllocCounter::snapshot()) {}
+    ~AllocScope() { AllocCounter::raise_peak(outer_peak_); }
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    AllocStats stats() const { return AllocCounter::snapshot().since(before_); }
+
+   private:
+    uint64_t outer_peak_;
+    AllocStats before_;
+};
+
+// 分配预算：每个单位（数据点、行）的分配次数和申请字节数上限，以及占用峰值上限（0 表示不限制）
+struct AllocBudget {
+    double max_allocations_per_unit = 0;
+    double max_bytes_per_unit = 0;
+    uint64_t max_peak_live_bytes = 0;
+};
+
+/**
+ * 检查一个阶段的分配是否在预算内，超出时 message 为说明（用于断言的输出）
+ * 未定义替换函数时计数为 0，总是返回 true
+ */
+inline bool check_alloc_budget(const AllocStats& stats, double units, const AllocBudget& budget,
+                               std::string& message) {
+    char buf[256];
+    message.clear();
+    if (stats.allocations_per(units) > budget.max_allocations_per_unit) {
+        snprintf(buf, sizeof(buf), "allocations/unit %.4f > %.4f (%llu allocations, %.0f units); ",
+                 stats.allocations_per(units), budget.max_allocations_per_unit,
+                 (unsigned long long)stats.allocations, units);
+        message += buf;
+    }
+    if (stats.bytes_per(units) > budget.max_bytes_per_unit) {
+        snprintf(buf, sizeof(buf), "bytes/unit %.2f > %.2f; ", stats.bytes_per(units),
+                 budget.max_bytes_per_unit);
+        message += buf;
+    }
+    if (budget.max_peak_live_bytes > 0 && stats.peak_live_bytes > budget.max_peak_live_bytes) {
+        snprintf(buf, sizeof(buf), "peak live %llu > %llu bytes; ",
+                 (unsigned long long)stats.peak_live_bytes,
+                 (unsigned long long)budget.max_peak_live_bytes);
+        message += buf;
+    }
+    return message.empty();
+}
+
+// 输出一个阶段的分配统计（units 大于 0 时输出每个单位的分配次数和字节数）
+inline void print_alloc_stats(const char* name, const AllocStats& stats, double units = 0) {
+    printf("%s: allocations=%llu frees=%llu bytes=%llu live_delta=%lld peak_live=%llu",
+           name, (unsigned long long)stats.allocations, (unsigned long long)stats.deallocations,
+           (unsigned long long)stats.bytes, (long long)stats.live_bytes,
+           (unsigned long long)stats.peak_live_bytes);
+    if (units > 0) {
+        printf(" allocs/unit=%.4f bytes/unit=%.2f", stats.allocations_per(units),
+               stats.bytes_per(units));
+    }
+    printf("\n");
+}
+
+}  // namespace harness
+
+#ifdef HARNESS_ALLOC_COUNTER_HOOKS
+
+// glibc 的分配函数实现（替换 malloc 等之后仍可直接调用，不经过 dlsym，dlsym 本身会分配内存）
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace harness {
+namespace alloc_hooks {
+
+inline void* record(void* ptr, size_t size) {
+    if (ptr != nullptr) {
+        AllocCounter::on_alloc(size, malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+inline void* aligned(size_t alignment, size_t size) {
+    return record(__libc_memalign(std::max(alignment, sizeof(void*)), size), size);
+}
+
+inline void* allocate(size_t size) {
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+inline void* allocate_aligned(size_t size, std::align_val_t alignment) {
+    void* ptr = aligned(static_cast<size_t>(alignment), size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// 静态初始化时标记已定义替换函数
+struct Installer {
+    Installer() { AllocCounter::set_installed(); }
+};
+inline Installer installer;
+
+}  // namespace alloc_hooks
+}  // namespace harness
+
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+    return harness::alloc_hooks::record(__libc_malloc(size), size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    return harness::alloc_hooks::record(__libc_calloc(count, size), count * size);
+}
+
+// 原地扩展也按一次释放和一次分配计数
+void* realloc(void* ptr, size_t size) noexcept {
+    size_t old_usable = ptr == nullptr ? 0 : malloc_usable_size(ptr);
+    void* result = __libc_realloc(ptr, size);
+    if (ptr != nullptr && (result != nullptr || size == 0)) {
+        harness::AllocCounter::on_free(old_usable);
+    }
+    return harness::alloc_hooks::record(result, size);
+}
+
+void free(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        harness::AllocCounter::on_free(malloc_usable_size(ptr));
+        __libc_free(ptr);
+    }
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* result = harness::alloc_hooks::aligned(alignment, size);
+    if (result == nullptr) {
+        return ENOMEM;
+    }
+    *ptr = result;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    return harness::alloc_hooks::aligned(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    return harness::alloc_hooks::aligned(alignment, size);
+}
+
+}  // extern "C"
+
+void* operator new(size_t size) { return harness::alloc_hooks::allocate(size); }
+void* operator new[](size_t size) { return harness::alloc_hooks::allocate(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return harness::alloc_hooks::allocate_aligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return harness::alloc_hooks::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+#endif  // HARNESS_ALLOC_COUNTER_HOOKS
+
+#endif  // HARNESS_ALLOC_COUNTER_H
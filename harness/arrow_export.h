@@ -0,0 +1,369 @@
+#ifndef HARNESS_ARROW_EXPORT_H
+#define HARNESS_ARROW_EXPORT_H
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/column_batch.h"
+
+/**
+ * 按 Arrow C Data Interface（ArrowSchema / ArrowArray / ArrowArrayStream）导出表模型查询结果，
+ * 结构体按 Arrow 规范中的 ABI 定义，不依赖 Arrow 库，导出后可由 pyarrow、Arrow C++、DuckDB 等直接导入。
+ *
+ * 每批为一个 struct 数组，子数组与结果集的列一一对应（第 1 列为时间列，名称为 time）：
+ *   INT32 / INT64 / FLOAT / DOUBLE、STRING / TEXT（utf8）、BLOB（binary）的值数组、偏移数组和字节区
+ *   直接指向 ColumnBatch 的存储，不复制；批的所有权转移给 ArrowArray，release 时释放；
+ *   空值位图按 Arrow 的约定（1 表示非空）取反后保存，无空值的列不分配位图；
+ *   BOOLEAN 由每值一个字节压缩为每值一位，DATE（yyyyMMdd）转换为 date32（1970-01-01 起的天数），
+ *   时间列和 TIMESTAMP 列为毫秒时间戳（tsm:）。
+ * 子数组各自持有批的引用，调用方可以把子数组移出后单独释放。
+ *
+ * TableResultSet 只提供逐行游标，ColumnBatchReader 从游标取值时已按列写入，
+ * 导出为 Arrow 只在上述需要转换的列上复制，不再逐单元格转换。
+ */
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+extern "C" {
+
+struct ArrowArrayStream {
+    int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+    int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+    const char* (*get_last_error)(struct ArrowArrayStream*);
+    void (*release)(struct ArrowArrayStream*);
+    void* private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+namespace harness {
+
+// 列类型对应的 Arrow 格式字符串，不支持的类型返回 nullptr
+inline const char* arrow_format(common::TSDataType type) {
+    switch (type) {
+        case common::BOOLEAN:
+            return "b";
+        case common::INT32:
+            return "i";
+        case common::INT64:
+            return "l";
+        case common::FLOAT:
+            return "f";
+        case common::DOUBLE:
+            return "g";
+        case common::DATE:
+            return "tdD";
+        case common::TIMESTAMP:
+            return "tsm:";
+        case common::TEXT:
+        case common::STRING:
+            return "u";
+        case common::BLOB:
+            return "z";
+        default:
+            return nullptr;
+    }
+}
+
+// yyyyMMdd 转换为 1970-01-01 起的天数（公历）
+inline int32_t date_to_epoch_days(int32_t value) {
+    int32_t y = value / 10000;
+    int32_t m = value / 100 % 100;
+    int32_t d = value % 100;
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// ArrowSchema 的私有数据：名称、格式字符串和子结构
+struct ArrowSchemaData {
+    std::vector<std::string> names;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_pointers;
+};
+
+inline void release_arrow_schema(ArrowSchema* schema) {
+    for (int64_t i = 0; i < schema->n_children; i++) {
+        ArrowSchema* child = schema->children[i];
+        if (child->release != nullptr) {
+            child->release(child);
+        }
+    }
+    delete static_cast<std::shared_ptr<ArrowSchemaData>*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+inline void release_arrow_schema_child(ArrowSchema* schema) {
+    delete static_cast<std::shared_ptr<ArrowSchemaData>*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+/**
+ * 导出结果集的表结构：struct 类型，子字段为各列（第 1 列为时间列，不可为空）
+ * names 和 types 含时间列；返回 EINVAL 表示有不支持的数据类型
+ */
+inline int export_arrow_schema(const std::vector<std::string>& names,
+                               const std::vector<common::TSDataType>& types, ArrowSchema* out) {
+    // 先检查全部类型：子结构持有 data，创建之后提前返回会形成循环引用而无法释放
+    for (size_t i = 1; i < types.size(); i++) {
+        if (arrow_format(types[i]) == nullptr) {
+            return EINVAL;
+        }
+    }
+    auto data = std::make_shared<ArrowSchemaData>();
+    data->names = names;
+    data->children.resize(types.size());
+    for (size_t i = 0; i < types.size(); i++) {
+        const char* format = i == 0 ? "tsm:" : arrow_format(types[i]);
+        ArrowSchema& child = data->children[i];
+        child = ArrowSchema();
+        child.format = format;
+        child.name = data->names[i].c_str();
+        child.flags = i == 0 ? 0 : ARROW_FLAG_NULLABLE;
+        child.release = &release_arrow_schema_child;
+        child.private_data = new std::shared_ptr<ArrowSchemaData>(data);
+        data->child_pointers.push_back(&child);
+    }
+    *out = ArrowSchema();
+    out->format = "+s";
+    out->name = "";
+    out->n_children = static_cast<int64_t>(types.size());
+    out->children = data->child_pointers.data();
+    out->release = &release_arrow_schema;
+    out->private_data = new std::shared_ptr<ArrowSchemaData>(std::move(data));
+    return 0;
+}
+
+// ArrowArray 的私有数据：持有批和转换后的缓冲区
+struct ArrowBatchData {
+    explicit ArrowBatchData(ColumnBatch&& batch) : batch(std::move(batch)) {}
+
+    ColumnBatch batch;
+    std::vector<std::vector<uint8_t>> converted;    // 取反的空值位图、压缩的 BOOLEAN、转换的 DATE
+    std::vector<std::vector<const void*>> buffers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_pointers;
+    const void* struct_buffers[1] = {nullptr};
+};
+
+inline void release_arrow_array(ArrowArray* array) {
+    for (int64_t i = 0; i < array->n_children; i++) {
+        ArrowArray* child = array->children[i];
+        if (child->release != nullptr) {
+            child->release(child);
+        }
+    }
+    delete static_cast<std::shared_ptr<ArrowBatchData>*>(array->private_data);
+    array->release = nullptr;
+}
+
+inline void release_arrow_array_child(ArrowArray* array) {
+    delete static_cast<std::shared_ptr<ArrowBatchData>*>(array->private_data);
+    array->release = nullptr;
+}
+
+/**
+ * 把一批数据导出为 struct 数组，批的存储转移给 out（batch 之后不可再使用）
+ * 返回 EINVAL 表示有不支持的数据类型
+ */
+inline int export_arrow_batch(ColumnBatch&& batch, ArrowArray* out) {
+    // 先检查全部类型，原因同 export_arrow_schema
+    for (uint32_t c = 1; c <= batch.column_count(); c++) {
+        if (arrow_format(batch.column_type(c)) == nullptr) {
+            return EINVAL;
+        }
+    }
+    auto data = std::make_shared<ArrowBatchData>(std::move(batch));
+    const ColumnBatch& b = data->batch;
+    uint32_t rows = b.row_count();
+    uint32_t column_count = b.column_count();
+    size_t bitmap_bytes = (rows + 7) / 8;
+    static const int32_t kEmptyOffsets[1] = {0};
+    static const char kEmptyBytes[1] = {0};
+    data->buffers.resize(column_count);
+    data->children.resize(column_count);
+    for (uint32_t c = 1; c <= column_count; c++) {
+        common::TSDataType type = b.column_type(c);
+        const uint8_t* nulls = b.null_bitmap(c);
+        int64_t null_count = 0;
+        for (uint32_t r = 0; r < rows; r++) {
+            null_count += (nulls[r >> 3] >> (r & 7)) & 1;
+        }
+        std::vector<const void*>& buffers = data->buffers[c - 1];
+        buffers.push_back(nullptr);
+        if (null_count > 0) {
+            std::vector<uint8_t> validity(bitmap_bytes);
+            for (size_t i = 0; i < bitmap_bytes; i++) {
+                validity[i] = static_cast<uint8_t>(~nulls[i]);
+            }
+            data->converted.push_back(std::move(validity));
+            buffers[0] = data->converted.back().data();
+        }
+        if (type == common::BOOLEAN) {
+            std::vector<uint8_t> bits(bitmap_bytes + 1, 0);
+            const bool* values = b.values<bool>(c);
+            for (uint32_t r = 0; r < rows; r++) {
+                bits[r >> 3] |= static_cast<uint8_t>(values[r]) << (r & 7);
+            }
+            data->converted.push_back(std::move(bits));
+            buffers.push_back(data->converted.back().data());
+        } else if (type == common::DATE) {
+            std::vector<uint8_t> days((rows + 1) * sizeof(int32_t));
+            const int32_t* values = b.values<int32_t>(c);
+            int32_t* out_days = reinterpret_cast<int32_t*>(days.data());
+            for (uint32_t r = 0; r < rows; r++) {
+                out_days[r] = (nulls[r >> 3] >> (r & 7)) & 1 ? 0 : date_to_epoch_days(values[r]);
+            }
+            data->converted.push_back(std::move(days));
+            buffers.push_back(data->converted.back().data());
+        } else if (ColumnBatch::value_width(type) > 0) {
+            buffers.push_back(b.values<char>(c));
+        } else {
+            const char* bytes = b.string_data(c);
+            buffers.push_back(rows > 0 ? b.string_offsets(c) : kEmptyOffsets);
+            buffers.push_back(bytes != nullptr ? bytes : kEmptyBytes);
+        }
+        ArrowArray& child = data->children[c - 1];
+        child = ArrowArray();
+        child.length = rows;
+        child.null_count = null_count;
+        child.n_buffers = static_cast<int64_t>(buffers.size());
+        child.buffers = buffers.data();
+        child.release = &release_arrow_array_child;
+        child.private_data = new std::shared_ptr<ArrowBatchData>(data);
+        data->child_pointers.push_back(&child);
+    }
+    *out = ArrowArray();
+    out->length = rows;
+    out->n_buffers = 1;
+    out->n_children = column_count;
+    out->buffers = data->struct_buffers;
+    out->children = data->child_pointers.data();
+    out->release = &release_arrow_array;
+    out->private_data = new std::shared_ptr<ArrowBatchData>(std::move(data));
+    return 0;
+}
+
+// ArrowArrayStream 的私有数据
+struct ArrowStreamData {
+    ArrowStreamData(storage::TableResultSet* ret, uint32_t batch_rows)
+        : reader(ret), batch_rows(batch_rows) {
+        auto metadata = ret->get_metadata();
+        names.push_back("time");
+        for (uint32_t i = 2; i <= metadata->get_column_count(); i++) {
+            names.push_back(metadata->get_column_name(i));
+        }
+    }
+
+    ColumnBatchReader reader;
+    uint32_t batch_rows;
+    std::vector<std::string> names;
+    std::string error;
+};
+
+inline int arrow_stream_get_schema(ArrowArrayStream* stream, ArrowSchema* out) {
+    auto* data = static_cast<ArrowStreamData*>(stream->private_data);
+    int code = export_arrow_schema(data->names, data->reader.column_types(), out);
+    if (code != 0) {
+        data->error = "unsupported column type";
+    }
+    return code;
+}
+
+// 读取下一批：每批新建存储（所有权随 ArrowArray 交给调用方），读完时 out->release 为 nullptr
+inline int arrow_stream_get_next(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* data = static_cast<ArrowStreamData*>(stream->private_data);
+    ColumnBatch batch = data->reader.create_batch(data->batch_rows);
+    int code = data->reader.next_batch(batch);
+    if (code != common::E_OK) {
+        data->error = "next_batch failed, error code: " + std::to_string(code);
+        return EIO;
+    }
+    if (batch.row_count() == 0) {
+        *out = ArrowArray();
+        return 0;
+    }
+    code = export_arrow_batch(std::move(batch), out);
+    if (code != 0) {
+        data->error = "unsupported column type";
+    }
+    return code;
+}
+
+inline const char* arrow_stream_get_last_error(ArrowArrayStream* stream) {
+    auto* data = static_cast<ArrowStreamData*>(stream->private_data);
+    return data->error.empty() ? nullptr : data->error.c_str();
+}
+
+inline void arrow_stream_release(ArrowArrayStream* stream) {
+    delete static_cast<ArrowStreamData*>(stream->private_data);
+    stream->release = nullptr;
+}
+
+/**
+ * 把结果集导出为 ArrowArrayStream，每次 get_next 读取最多 batch_rows 行
+ * 结果集须在 stream 释放之前保持打开；已导出的 ArrowArray 不引用结果集，可以在关闭之后继续使用
+ */
+inline void export_arrow_stream(storage::TableResultSet* ret, uint32_t batch_rows,
+                                ArrowArrayStream* out) {
+    out->get_schema = &arrow_stream_get_schema;
+    out->get_next = &arrow_stream_get_next;
+    out->get_last_error = &arrow_stream_get_last_error;
+    out->release = &arrow_stream_release;
+    out->private_data = new ArrowStreamData(ret, batch_rows);
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_ARROW_EXPORT_H
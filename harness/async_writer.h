@@ -0,0 +1,193 @@
+#ifndef HARNESS_ASYNC_WRITER_H
+#define HARNESS_ASYNC_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/tablet.h"
+#include "writer/tsfile_table_writer.h"
+
+#include "harness/bench_util.h"
+
+/**
+ * 异步表模型写入器：调用方把填充好的 tablet 提交到有界队列后立即取得新的 tablet 继续填充，
+ * 后台线程依次调用 write_table（编码、压缩和 I/O），数据准备与写入重叠执行。
+ *
+ *   - 队列深度 queue_depth 为已提交但尚未写入的 tablet 数量上限，队列满时 submit 阻塞（反压）；
+ *   - 空闲 tablet 由后台线程在写入完成后通过 factory 重新创建并放回空闲列表，
+ *     acquire 优先从空闲列表取得，tablet 的析构和构造都不占用调用方线程；
+ *   - submit / flush 返回 std::future<int>，写入（flush 时为 flush 完成）后设置错误码；
+ *   - 一次写入失败后，之后提交的 tablet 不再写入，直接以该错误码完成。
+ *
+ * 写入器的生命周期由调用方管理，close 之后才能关闭或销毁写入器。
+ */
+namespace harness {
+
+// 异步写入统计
+struct AsyncWriterStats {
+    uint64_t tablets = 0;
+    double submit_wait_s = 0;   // 调用方因队列满阻塞的总耗时
+    double acquire_wait_s = 0;  // 调用方取得 tablet 的总耗时（空闲列表为空时包含创建耗时）
+    double write_s = 0;         // 后台线程 write_table / flush 的总耗时
+};
+
+class AsyncTableWriter {
+   public:
+    using TabletFactory = std::function<std::unique_ptr<storage::Tablet>()>;
+
+    AsyncTableWriter(storage::TsFileTableWriter* writer, TabletFactory factory,
+                     size_t queue_depth = 2)
+        : writer_(writer), factory_(std::move(factory)),
+          queue_depth_(queue_depth == 0 ? 1 : queue_depth) {
+        for (size_t i = 0; i < queue_depth_; i++) {
+            free_.push_back(factory_());
+        }
+        worker_ = std::thread([this]() { run(); });
+    }
+
+    ~AsyncTableWriter() { close(); }
+
+    AsyncTableWriter(const AsyncTableWriter&) = delete;
+    AsyncTableWriter& operator=(const AsyncTableWriter&) = delete;
+
+    // 取得一个空白 tablet，空闲列表为空时直接创建
+    std::unique_ptr<storage::Tablet> acquire() {
+        Stopwatch watch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            lock.unlock();
+            std::unique_ptr<storage::Tablet> tablet = factory_();
+            lock.lock();
+            stats_.acquire_wait_s += watch.elapsed_s();
+            return tablet;
+        }
+        std::unique_ptr<storage::Tablet> tablet = std::move(free_.back());
+        free_.pop_back();
+        stats_.acquire_wait_s += watch.elapsed_s();
+        return tablet;
+    }
+
+    // 提交 tablet，队列满时阻塞，返回的 future 在该 tablet 写入后完成
+    std::future<int> submit(std::unique_ptr<storage::Tablet> tablet) {
+        Task task;
+        task.tablet = std::move(tablet);
+        return push(std::move(task));
+    }
+
+    // 在已提交的 tablet 全部写入后执行 flush，返回的 future 在 flush 完成后完成
+    std::future<int> flush() {
+        Task task;
+        task.flush = true;
+        return push(std::move(task));
+    }
+
+    // 等待已提交的任务全部完成并停止后台线程，返回第一个错误码；不关闭写入器
+    int close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return error_;
+            }
+            stopped_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        return error_;
+    }
+
+    // 当前统计，close 之后为最终结果
+    AsyncWriterStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+   private:
+    struct Task {
+        std::unique_ptr<storage::Tablet> tablet;
+        bool flush = false;
+        std::promise<int> done;
+    };
+
+    std::future<int> push(Task task) {
+        std::future<int> result = task.done.get_future();
+        Stopwatch watch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() { return queue_.size() < queue_depth_ || stopped_; });
+        stats_.submit_wait_s += watch.elapsed_s();
+        if (stopped_) {
+            task.done.set_value(error_ != common::E_OK ? error_ : -1);
+            return result;
+        }
+        queue_.push_back(std::move(task));
+        lock.unlock();
+        not_empty_.notify_one();
+        return result;
+    }
+
+    void run() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [this]() { return !queue_.empty() || stopped_; });
+                if (queue_.empty()) {
+                    return;
+                }
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            not_full_.notify_one();
+
+            int ret = error_;
+            Stopwatch watch;
+            if (ret == common::E_OK) {
+                ret = task.flush ? writer_->flush() : writer_->write_table(*task.tablet);
+            }
+            double write_s = watch.elapsed_s();
+            // 在锁外销毁已写入的 tablet 并创建新的空闲 tablet
+            bool recycle = task.tablet != nullptr;
+            task.tablet.reset();
+            std::unique_ptr<storage::Tablet> fresh = recycle ? factory_() : nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (ret != common::E_OK && error_ == common::E_OK) {
+                    error_ = ret;
+                }
+                stats_.write_s += write_s;
+                stats_.tablets += recycle ? 1 : 0;
+                if (fresh && free_.size() < queue_depth_) {
+                    free_.push_back(std::move(fresh));
+                }
+            }
+            task.done.set_value(ret);
+        }
+    }
+
+    storage::TsFileTableWriter* writer_;
+    TabletFactory factory_;
+    size_t queue_depth_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<Task> queue_;
+    std::vector<std::unique_ptr<storage::Tablet>> free_;
+    bool stopped_ = false;
+    int error_ = common::E_OK;
+    AsyncWriterStats stats_;
+    std::thread worker_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_ASYNC_WRITER_H
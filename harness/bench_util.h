@@ -0,0 +1,339 @@
+#ifndef HARNESS_BENCH_UTIL_H
+#define HARNESS_BENCH_UTIL_H
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+
+/**
+ * 性能测试公共工具：计时、命令行参数解析、数据文件路径、内存统计
+ */
+namespace harness {
+
+// 计时器（单调时钟）
+class Stopwatch {
+   public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    // 重新开始计时
+    void reset() { start_ = std::chrono::steady_clock::now(); }
+
+    // 返回经过的秒数
+    double elapsed_s() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start_)
+            .count();
+    }
+
+    // 返回经过的微秒数
+    int64_t elapsed_us() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start_)
+            .count();
+    }
+
+   private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+// 命令行参数：仅支持 --key=value 和 --flag 两种格式
+class BenchArgs {
+   public:
+    BenchArgs(int argc, char** argv) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) {
+                std::cerr << "Ignore unknown argument: " << arg << std::endl;
+                continue;
+            }
+            size_t pos = arg.find('=');
+            if (pos == std::string::npos) {
+                values_[arg.substr(2)] = "true";
+            } else {
+                values_[arg.substr(2, pos - 2)] = arg.substr(pos + 1);
+            }
+        }
+    }
+
+    bool has(const std::string& key) const { return values_.count(key) > 0; }
+
+    std::string get_string(const std::string& key,
+                           const std::string& default_value) const {
+        auto it = values_.find(key);
+        return it == values_.end() ? default_value : it->second;
+    }
+
+    int64_t get_int(const std::string& key, int64_t default_value) const {
+        auto it = values_.find(key);
+        return it == values_.end() ? default_value
+                                   : std::strtoll(it->second.c_str(), nullptr, 10);
+    }
+
+    double get_double(const std::string& key, double default_value) const {
+        auto it = values_.find(key);
+        return it == values_.end() ? default_value
+                                   : std::strtod(it->second.c_str(), nullptr);
+    }
+
+    // 逗号分隔的字符串列表，如 --columns=tag0,s0
+    std::vector<std::string> get_string_list(
+        const std::string& key, const std::vector<std::string>& default_value) const {
+        auto it = values_.find(key);
+        if (it == values_.end()) {
+            return default_value;
+        }
+        std::vector<std::string> result;
+        size_t start = 0;
+        const std::string& s = it->second;
+        while (start <= s.size()) {
+            size_t end = s.find(',', start);
+            if (end == std::string::npos) {
+                end = s.size();
+            }
+            if (end > start) {
+                result.push_back(s.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return result;
+    }
+
+    // 逗号分隔的整数列表，如 --tablet-rows=1024,4096
+    std::vector<int64_t> get_int_list(const std::string& key,
+                                      const std::vector<int64_t>& default_value) const {
+        if (!has(key)) {
+            return default_value;
+        }
+        std::vector<int64_t> result;
+        for (const auto& item : get_string_list(key, {})) {
+            result.push_back(std::strtoll(item.c_str(), nullptr, 10));
+        }
+        return result;
+    }
+
+   private:
+    std::map<std::string, std::string> values_;
+};
+
+/**
+ * 获取 data/tsfile 目录下指定文件的完整路径（与测试用例的 init_file_path 逻辑一致），
+ * 文件已存在时会被删除；找不到 data 目录时返回原文件名
+ */
+inline std::string resolve_data_path(const std::string& file_name,
+                                     bool remove_existing = true) {
+    char result[PATH_MAX];
+    ssize_t count = readlink("/proc/self/exe", result, PATH_MAX);
+    std::string executable_path = std::string(result, (count > 0) ? count : 0);
+    std::filesystem::path root_path =
+        std::filesystem::path(executable_path).parent_path();
+    // 向上查找直到找到包含"data"目录的根目录
+    while (!root_path.empty() && root_path != root_path.parent_path() &&
+           !std::filesystem::exists(root_path / "data")) {
+        root_path = root_path.parent_path();
+    }
+    if (root_path.empty() || !std::filesystem::exists(root_path / "data")) {
+        std::cerr << "Directory does not exist: data" << std::endl;
+        return file_name;
+    }
+    std::filesystem::path directory_path = root_path / "data" / "tsfile";
+    std::filesystem::create_directories(directory_path);
+    std::filesystem::path file_path = directory_path / file_name;
+    if (remove_existing && std::filesystem::exists(file_path) &&
+        std::filesystem::is_regular_file(file_path)) {
+        std::filesystem::remove(file_path);
+    }
+    return file_path.string();
+}
+
+// 文件大小（字节），文件不存在时返回 0
+inline uint64_t file_size_bytes(const std::string& path) {
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : size;
+}
+
+// 进程峰值常驻内存（KB），优先读取 /proc/self/status 的 VmHWM（可被 reset_peak_rss 重置）
+inline long peak_rss_kb() {
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status != nullptr) {
+        char line[256];
+        long value = -1;
+        while (fgets(line, sizeof(line), status) != nullptr) {
+            if (sscanf(line, "VmHWM: %ld kB", &value) == 1) {
+                break;
+            }
+        }
+        fclose(status);
+        if (value >= 0) {
+            return value;
+        }
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// 将峰值常驻内存重置为当前值（Linux 4.0 及以上），用于分阶段统计峰值内存
+inline bool reset_peak_rss() {
+    FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (clear_refs == nullptr) {
+        return false;
+    }
+    bool ok = fputs("5", clear_refs) >= 0;
+    fclose(clear_refs);
+    return ok;
+}
+
+// 将数据类型转换为字符串
+inline std::string datatype_to_string(common::TSDataType type) {
+    switch (type) {
+        case common::TSDataType::BOOLEAN:
+            return "BOOLEAN";
+        case common::TSDataType::INT32:
+            return "INT32";
+        case common::TSDataType::INT64:
+            return "INT64";
+        case common::TSDataType::FLOAT:
+            return "FLOAT";
+        case common::TSDataType::DOUBLE:
+            return "DOUBLE";
+        case common::TSDataType::TEXT:
+            return "TEXT";
+        case common::TSDataType::STRING:
+            return "STRING";
+        case common::TSDataType::BLOB:
+            return "BLOB";
+        case common::TSDataType::DATE:
+            return "DATE";
+        case common::TSDataType::TIMESTAMP:
+            return "TIMESTAMP";
+        default:
+            return "INVALID_TYPE";
+    }
+}
+
+// 将字符串解析为数据类型（大小写不敏感），无法识别时返回 INVALID_DATATYPE
+inline common::TSDataType string_to_datatype(std::string name) {
+    for (auto& c : name) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    const common::TSDataType all_types[] = {
+        common::TSDataType::BOOLEAN, common::TSDataType::INT32,
+        common::TSDataType::INT64,   common::TSDataType::FLOAT,
+        common::TSDataType::DOUBLE,  common::TSDataType::TEXT,
+        common::TSDataType::STRING,  common::TSDataType::BLOB,
+        common::TSDataType::DATE,    common::TSDataType::TIMESTAMP,
+    };
+    for (auto type : all_types) {
+        if (datatype_to_string(type) == name) {
+            return type;
+        }
+    }
+    return common::TSDataType::INVALID_DATATYPE;
+}
+
+// 将编码方式转换为字符串
+inline std::string encoding_to_string(common::TSEncoding encoding) {
+    switch (encoding) {
+        case common::TSEncoding::PLAIN:
+            return "PLAIN";
+        case common::TSEncoding::DICTIONARY:
+            return "DICTIONARY";
+        case common::TSEncoding::RLE:
+            return "RLE";
+        case common::TSEncoding::DIFF:
+            return "DIFF";
+        case common::TSEncoding::TS_2DIFF:
+            return "TS_2DIFF";
+        case common::TSEncoding::BITMAP:
+            return "BITMAP";
+        case common::TSEncoding::GORILLA_V1:
+            return "GORILLA_V1";
+        case common::TSEncoding::REGULAR:
+            return "REGULAR";
+        case common::TSEncoding::GORILLA:
+            return "GORILLA";
+        case common::TSEncoding::ZIGZAG:
+            return "ZIGZAG";
+        case common::TSEncoding::FREQ:
+            return "FREQ";
+        default:
+            return "INVALID_ENCODING";
+    }
+}
+
+// 将字符串解析为编码方式（大小写不敏感），无法识别时返回 INVALID_ENCODING
+inline common::TSEncoding string_to_encoding(std::string name) {
+    for (auto& c : name) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    for (int i = common::TSEncoding::PLAIN; i <= common::TSEncoding::FREQ; i++) {
+        auto encoding = static_cast<common::TSEncoding>(i);
+        if (encoding_to_string(encoding) == name) {
+            return encoding;
+        }
+    }
+    return common::TSEncoding::INVALID_ENCODING;
+}
+
+// 将压缩方式转换为字符串
+inline std::string compression_to_string(common::CompressionType compression) {
+    switch (compression) {
+        case common::CompressionType::UNCOMPRESSED:
+            return "UNCOMPRESSED";
+        case common::CompressionType::SNAPPY:
+            return "SNAPPY";
+        case common::CompressionType::GZIP:
+            return "GZIP";
+        case common::CompressionType::LZO:
+            return "LZO";
+        case common::CompressionType::SDT:
+            return "SDT";
+        case common::CompressionType::PAA:
+            return "PAA";
+        case common::CompressionType::PLA:
+            return "PLA";
+        case common::CompressionType::LZ4:
+            return "LZ4";
+        default:
+            return "INVALID_COMPRESSION";
+    }
+}
+
+// 将字符串解析为压缩方式（大小写不敏感），无法识别时返回 INVALID_COMPRESSION
+inline common::CompressionType string_to_compression(std::string name) {
+    for (auto& c : name) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    for (int i = common::CompressionType::UNCOMPRESSED; i <= common::CompressionType::LZ4; i++) {
+        auto compression = static_cast<common::CompressionType>(i);
+        if (compression_to_string(compression) == name) {
+            return compression;
+        }
+    }
+    return common::CompressionType::INVALID_COMPRESSION;
+}
+
+// 吞吐量换算：每秒数量
+inline double per_second(double count, double seconds) {
+    return seconds > 0 ? count / seconds : 0;
+}
+
+// 字节转换为 MB
+inline double to_mb(double bytes) { return bytes / (1024.0 * 1024.0); }
+
+}  // namespace harness
+
+#endif  // HARNESS_BENCH_UTIL_H
@@ -0,0 +1,228 @@
+#ifndef HARNESS_COLUMN_BATCH_H
+#define HARNESS_COLUMN_BATCH_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+/**
+ * 表模型按列批量读取：一次从 TableResultSet 取出最多 N 行，
+ * 写入调用方持有的按列存储的定长数组和空值位图。
+ * 变长列（STRING/TEXT/BLOB）的值连续存放在该列的字节区中，按偏移数组访问（与 Arrow 的变长列布局相同），
+ * 字节区和偏移数组在批之间复用，容量足够后读取不再分配内存；string_value 返回的视图在下一次
+ * next_batch 之前有效。
+ *
+ * TableResultSet 只提供逐行游标，这里在打开时按列类型选定每列的取值函数，
+ * 去掉逐单元格的类型分支，并让调用方按列连续处理数据。
+ */
+namespace harness {
+
+// common::String 的视图（不复制），在结果集移动到下一行之前有效
+inline std::string_view string_view_of(const common::String* value) {
+    return std::string_view(value->buf_, value->len_);
+}
+
+class ColumnBatchReader;
+
+// 按列存储的一批数据，列下标与 TableResultSet 一致（从 1 开始，第 1 列为时间列）
+class ColumnBatch {
+   public:
+    ColumnBatch(const std::vector<common::TSDataType>& types, uint32_t capacity)
+        : capacity_(capacity) {
+        for (auto type : types) {
+            Column column;
+            column.type = type;
+            column.width = value_width(type);
+            column.data.resize(static_cast<size_t>(column.width) * capacity);
+            if (column.width == 0) {
+                column.offsets.assign(capacity + 1, 0);
+            }
+            column.nulls.resize((capacity + 7) / 8);
+            columns_.push_back(std::move(column));
+        }
+    }
+
+    uint32_t capacity() const { return capacity_; }
+    uint32_t row_count() const { return row_count_; }
+    uint32_t column_count() const { return static_cast<uint32_t>(columns_.size()); }
+    common::TSDataType column_type(uint32_t column) const { return columns_[column - 1].type; }
+
+    // 定长列的值数组，T 需与列类型一致（DATE 为 int32_t，TIMESTAMP 为 int64_t）
+    template <typename T>
+    const T* values(uint32_t column) const {
+        return reinterpret_cast<const T*>(columns_[column - 1].data.data());
+    }
+
+    // 变长列（STRING/TEXT/BLOB）的值，空值为空视图；在下一次 next_batch 之前有效
+    std::string_view string_value(uint32_t column, uint32_t row) const {
+        const Column& c = columns_[column - 1];
+        return std::string_view(c.bytes.data() + c.offsets[row],
+                                static_cast<size_t>(c.offsets[row + 1] - c.offsets[row]));
+    }
+
+    // 变长列的字节区和偏移数组：第 row 行为 [offsets[row], offsets[row + 1])，偏移数组有 row_count() + 1 个元素
+    const char* string_data(uint32_t column) const { return columns_[column - 1].bytes.data(); }
+    const int32_t* string_offsets(uint32_t column) const {
+        return columns_[column - 1].offsets.data();
+    }
+
+    // 空值位图：第 row 行对应第 row / 8 个字节的第 row % 8 位，1 表示空值（与 harness/tablet_bulk.h 的
+    // append_column 相同，可直接传入写回 tablet）
+    const uint8_t* null_bitmap(uint32_t column) const { return columns_[column - 1].nulls.data(); }
+
+    bool is_null(uint32_t column, uint32_t row) const {
+        return (columns_[column - 1].nulls[row >> 3] >> (row & 7)) & 1;
+    }
+
+    // 定长类型的字节宽度，变长类型返回 0
+    static uint32_t value_width(common::TSDataType type) {
+        switch (type) {
+            case common::BOOLEAN:
+                return sizeof(bool);
+            case common::DATE:
+            case common::INT32:
+                return sizeof(int32_t);
+            case common::TIMESTAMP:
+            case common::INT64:
+                return sizeof(int64_t);
+            case common::FLOAT:
+                return sizeof(float);
+            case common::DOUBLE:
+                return sizeof(double);
+            default:
+                return 0;
+        }
+    }
+
+   private:
+    friend class ColumnBatchReader;
+
+    struct Column {
+        common::TSDataType type;
+        uint32_t width = 0;
+        std::vector<uint8_t> data;
+        std::vector<char> bytes;         // 变长列的值
+        std::vector<int32_t> offsets;    // 变长列每行的起始偏移，共 capacity + 1 个
+        std::vector<uint8_t> nulls;
+    };
+
+    uint32_t capacity_ = 0;
+    uint32_t row_count_ = 0;
+    std::vector<Column> columns_;
+};
+
+// 从 TableResultSet 按批读取数据
+class ColumnBatchReader {
+   public:
+    explicit ColumnBatchReader(storage::TableResultSet* ret) : ret_(ret) {
+        auto metadata = ret_->get_metadata();
+        uint32_t column_count = metadata->get_column_count();
+        for (uint32_t i = 1; i <= column_count; i++) {
+            common::TSDataType type = metadata->get_column_type(i);
+            types_.push_back(type);
+            fills_.push_back(select_fill(type));
+            supported_ = supported_ && fills_.back() != nullptr;
+        }
+    }
+
+    const std::vector<common::TSDataType>& column_types() const { return types_; }
+
+    // 按结果集的列类型创建一批数据的存储
+    ColumnBatch create_batch(uint32_t capacity) const { return ColumnBatch(types_, capacity); }
+
+    /**
+     * 读取最多 batch.capacity() 行，读取到的行数为 batch.row_count()，为 0 表示已读完
+     * 返回错误码（E_OK 表示成功）；不支持的数据类型返回 -1
+     */
+    int next_batch(ColumnBatch& batch) {
+        batch.row_count_ = 0;
+        if (!supported_) {
+            return -1;
+        }
+        if (finished_) {
+            return common::E_OK;
+        }
+        for (auto& column : batch.columns_) {
+            std::memset(column.nulls.data(), 0, column.nulls.size());
+            column.bytes.clear();
+        }
+        uint32_t column_count = static_cast<uint32_t>(types_.size());
+        bool has_next = false;
+        int code = common::E_OK;
+        uint32_t row = 0;
+        while (row < batch.capacity_) {
+            if ((code = ret_->next(has_next)) != common::E_OK || !has_next) {
+                finished_ = true;
+                break;
+            }
+            for (uint32_t i = 1; i <= column_count; i++) {
+                ColumnBatch::Column& column = batch.columns_[i - 1];
+                if (ret_->is_null(i)) {
+                    column.nulls[row >> 3] |= static_cast<uint8_t>(1u << (row & 7));
+                    if (column.width == 0) {
+                        column.offsets[row + 1] = column.offsets[row];
+                    }
+                } else {
+                    fills_[i - 1](ret_, i, column, row);
+                }
+            }
+            row++;
+        }
+        batch.row_count_ = row;
+        return code;
+    }
+
+   private:
+    using FillFn = void (*)(storage::TableResultSet*, uint32_t, ColumnBatch::Column&, uint32_t);
+
+    template <typename T>
+    static void fill_fixed(storage::TableResultSet* ret, uint32_t index,
+                           ColumnBatch::Column& column, uint32_t row) {
+        reinterpret_cast<T*>(column.data.data())[row] = ret->get_value<T>(index);
+    }
+
+    static void fill_string(storage::TableResultSet* ret, uint32_t index,
+                            ColumnBatch::Column& column, uint32_t row) {
+        common::String* value = ret->get_value<common::String*>(index);
+        column.bytes.insert(column.bytes.end(), value->buf_, value->buf_ + value->len_);
+        column.offsets[row + 1] = static_cast<int32_t>(column.bytes.size());
+    }
+
+    static FillFn select_fill(common::TSDataType type) {
+        switch (type) {
+            case common::BOOLEAN:
+                return &fill_fixed<bool>;
+            case common::DATE:
+            case common::INT32:
+                return &fill_fixed<int32_t>;
+            case common::TIMESTAMP:
+            case common::INT64:
+                return &fill_fixed<int64_t>;
+            case common::FLOAT:
+                return &fill_fixed<float>;
+            case common::DOUBLE:
+                return &fill_fixed<double>;
+            case common::BLOB:
+            case common::TEXT:
+            case common::STRING:
+                return &fill_string;
+            default:
+                return nullptr;
+        }
+    }
+
+    storage::TableResultSet* ret_;
+    std::vector<common::TSDataType> types_;
+    std::vector<FillFn> fills_;
+    bool supported_ = true;
+    bool finished_ = false;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_COLUMN_BATCH_H
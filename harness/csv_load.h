@@ -0,0 +1,720 @@
+#ifndef HARNESS_CSV_LOAD_H
+#define HARNESS_CSV_LOAD_H
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "writer/tsfile_table_writer.h"
+
+#include "harness/bench_util.h"
+
+/**
+ * CSV 批量导入：流式读取 CSV 文件，按块（以换行切分）分发给多个解析线程，
+ * 解析线程把每块的行解析并填充为 tablet，写入线程按块在文件中的顺序调用 write_table。
+ *
+ *   - 第一行为表头（列名），时间列默认为第一列，值为整数时间戳；
+ *   - 表结构由前 sample_rows 行推断（BOOLEAN、INT64、DOUBLE、STRING），可按列名指定类型和类别；
+ *     未指定 TAG 列时，推断为 STRING 的列作为 TAG 列，其余为 FIELD 列；
+ *   - 空字段为空值；字段可以用双引号包围（"" 表示一个引号），但不能包含换行；
+ *   - 读取、解析、写入之间同时存在的块数不超过 max_inflight_blocks，
+ *     内存占用约为 max_inflight_blocks × (block_bytes + 一块解析出的 tablet) 加上写入器的缓存，与文件大小无关。
+ * 出错时返回 kCsvLoadError（或库的错误码），error() 给出说明（含出错行在文件中的字节偏移）。
+ */
+namespace harness {
+
+// CSV 格式错误、列不存在或值无法按列的类型解析
+constexpr int kCsvLoadError = -102;
+
+// 一个非时间列的类型和类别
+struct CsvColumn {
+    std::string name;
+    common::TSDataType type = common::TSDataType::STRING;
+    common::ColumnCategory category = common::ColumnCategory::FIELD;
+};
+
+struct CsvLoadConfig {
+    std::string table_name = "csv_table";
+    char delimiter = ',';
+    std::string time_column;                // 时间列名，为空时使用第一列
+    std::vector<CsvColumn> columns;         // 按列名指定的类型和类别，其余列推断
+    std::vector<std::string> tag_columns;   // TAG 列，为空时推断为 STRING 的列作为 TAG 列
+    int64_t sample_rows = 1000;             // 推断表结构的行数
+    size_t block_bytes = 8 * 1024 * 1024;   // 每块读取的字节数（按最后一个换行切分）
+    int64_t tablet_rows = 8192;             // 每个 tablet 的最大行数
+    int threads = 0;                        // 解析线程数，0 表示 CPU 核数
+    int max_inflight_blocks = 0;            // 同时存在的块数上限，0 表示 2 × 解析线程数 + 2
+    uint64_t memory_threshold = 128 * 1024 * 1024;   // 写入器缓存阈值
+};
+
+// 导入统计
+struct CsvLoadStats {
+    int64_t rows = 0;
+    uint64_t input_bytes = 0;    // 读取的 CSV 字节数（不含表头）
+    uint64_t blocks = 0;
+    uint64_t tablets = 0;
+    uint64_t file_bytes = 0;     // 输出文件大小
+    double total_s = 0;          // 打开输入文件到关闭写入器
+    double parse_s = 0;          // 各解析线程耗时之和
+    double write_s = 0;          // write_table 耗时
+    double flush_close_s = 0;
+    double write_wait_s = 0;     // 写入线程等待解析结果（解析是瓶颈时较大）
+    double read_wait_s = 0;      // 读取线程等待块数低于上限（写入是瓶颈时较大）
+    int threads = 0;
+    int max_inflight_blocks = 0;
+};
+
+/**
+ * 把 [line, end) 按分隔符切分为字段，原地去掉引号并还原 "" 转义，每个字段之后写入 '\0'
+ * （end 指向行尾的换行符，可写）；返回字段数
+ */
+inline size_t split_csv_line(char* line, char* end, char delimiter,
+                             std::vector<std::string_view>& fields) {
+    fields.clear();
+    char* p = line;
+    while (true) {
+        char* start = p;
+        char* out = p;
+        if (p < end && *p == '"') {
+            p++;
+            while (p < end) {
+                if (*p == '"') {
+                    if (p + 1 < end && p[1] == '"') {
+                        *out++ = '"';
+                        p += 2;
+                        continue;
+                    }
+                    p++;
+                    break;
+                }
+                *out++ = *p++;
+            }
+            while (p < end && *p != delimiter) {
+                p++;
+            }
+        } else {
+            while (p < end && *p != delimiter) {
+                p++;
+            }
+            out = p;
+        }
+        fields.emplace_back(start, out - start);
+        bool last = p >= end;
+        *out = '\0';
+        if (last) {
+            return fields.size();
+        }
+        p++;
+    }
+}
+
+// 整数和浮点数：整个字段都是数字时返回 true
+template <typename T>
+inline bool parse_csv_number(std::string_view text, T& value) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+// true / false（不区分大小写）
+inline bool parse_csv_bool(std::string_view text, bool& value) {
+    auto equals = [text](const char* word) {
+        size_t n = std::strlen(word);
+        if (text.size() != n) {
+            return false;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if ((text[i] | 0x20) != word[i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (equals("true")) {
+        value = true;
+        return true;
+    }
+    if (equals("false")) {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+// YYYY-MM-DD 转换为 DATE 类型的 yyyyMMdd 整数
+inline bool parse_csv_date(std::string_view text, int32_t& value) {
+    int32_t year = 0;
+    int32_t month = 0;
+    int32_t day = 0;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-' ||
+        !parse_csv_number(text.substr(0, 4), year) || !parse_csv_number(text.substr(5, 2), month) ||
+        !parse_csv_number(text.substr(8, 2), day) || month < 1 || month > 12 || day < 1 ||
+        day > 31) {
+        return false;
+    }
+    value = year * 10000 + month * 100 + day;
+    return true;
+}
+
+// 能表示该值的最窄类型：BOOLEAN、INT64、DOUBLE、STRING
+inline common::TSDataType infer_csv_type(std::string_view text) {
+    bool flag;
+    int64_t integer;
+    double real;
+    if (parse_csv_bool(text, flag)) {
+        return common::TSDataType::BOOLEAN;
+    }
+    if (parse_csv_number(text, integer)) {
+        return common::TSDataType::INT64;
+    }
+    if (parse_csv_number(text, real)) {
+        return common::TSDataType::DOUBLE;
+    }
+    return common::TSDataType::STRING;
+}
+
+// 合并两个推断类型：INVALID_DATATYPE 表示尚无非空值，INT64 与 DOUBLE 合并为 DOUBLE，其余不同时为 STRING
+inline common::TSDataType widen_csv_type(common::TSDataType current, common::TSDataType sample) {
+    if (current == common::TSDataType::INVALID_DATATYPE || current == sample) {
+        return sample;
+    }
+    bool numeric = (current == common::TSDataType::INT64 || current == common::TSDataType::DOUBLE) &&
+                   (sample == common::TSDataType::INT64 || sample == common::TSDataType::DOUBLE);
+    return numeric ? common::TSDataType::DOUBLE : common::TSDataType::STRING;
+}
+
+/**
+ * 按列的类型解析字段并写入 tablet，无法解析时返回 kCsvLoadError
+ * 变长类型直接传入字段指针，字段须以 '\0' 结尾（split_csv_line 的结果）
+ */
+inline int add_csv_value(storage::Tablet& tablet, uint32_t row, uint32_t col,
+                         common::TSDataType type, std::string_view text) {
+    switch (type) {
+        case common::TSDataType::BOOLEAN: {
+            bool value;
+            return parse_csv_bool(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::INT32: {
+            int32_t value;
+            return parse_csv_number(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::DATE: {
+            int32_t value;
+            return parse_csv_date(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::INT64:
+        case common::TSDataType::TIMESTAMP: {
+            int64_t value;
+            return parse_csv_number(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::FLOAT: {
+            float value;
+            return parse_csv_number(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::DOUBLE: {
+            double value;
+            return parse_csv_number(text, value) ? tablet.add_value(row, col, value) : kCsvLoadError;
+        }
+        case common::TSDataType::TEXT:
+        case common::TSDataType::STRING:
+        case common::TSDataType::BLOB:
+            return tablet.add_value(row, col, text.data());
+        default:
+            return kCsvLoadError;
+    }
+}
+
+class CsvLoader {
+   public:
+    explicit CsvLoader(const CsvLoadConfig& config) : config_(config) {}
+
+    CsvLoader(const CsvLoader&) = delete;
+    CsvLoader& operator=(const CsvLoader&) = delete;
+
+    /**
+     * 读取表头，按前 sample_rows 行推断表结构，返回错误码（E_OK 表示成功）
+     */
+    int open(const std::string& csv_path) {
+        csv_path_ = csv_path;
+        std::ifstream input(csv_path, std::ios::binary);
+        std::string line;
+        if (!input || !std::getline(input, line)) {
+            return fail_open("cannot read header of " + csv_path);
+        }
+        header_bytes_ = line.size() + 1;
+        // 跳过 UTF-8 BOM
+        if (line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            line.erase(0, 3);
+        }
+        std::vector<std::string_view> fields;
+        split_line(line, fields);
+        header_.assign(fields.begin(), fields.end());
+        time_index_ = 0;
+        if (!config_.time_column.empty()) {
+            auto it = std::find(header_.begin(), header_.end(), config_.time_column);
+            if (it == header_.end()) {
+                return fail_open("time column not found: " + config_.time_column);
+            }
+            time_index_ = static_cast<size_t>(it - header_.begin());
+        }
+
+        std::vector<common::TSDataType> inferred(header_.size(),
+                                                 common::TSDataType::INVALID_DATATYPE);
+        for (int64_t i = 0; i < config_.sample_rows && std::getline(input, line); i++) {
+            if (line.empty() || line == "\r") {
+                continue;
+            }
+            if (split_line(line, fields) != header_.size()) {
+                return fail_open("sample row " + std::to_string(i + 1) + ": expected " +
+                                 std::to_string(header_.size()) + " fields, got " +
+                                 std::to_string(fields.size()));
+            }
+            for (size_t c = 0; c < fields.size(); c++) {
+                if (!fields[c].empty()) {
+                    inferred[c] = widen_csv_type(inferred[c], infer_csv_type(fields[c]));
+                }
+            }
+        }
+
+        for (const CsvColumn& column : config_.columns) {
+            if (std::find(header_.begin(), header_.end(), column.name) == header_.end()) {
+                return fail_open("column not found: " + column.name);
+            }
+        }
+        for (const std::string& name : config_.tag_columns) {
+            if (std::find(header_.begin(), header_.end(), name) == header_.end()) {
+                return fail_open("tag column not found: " + name);
+            }
+        }
+        columns_.clear();
+        csv_indexes_.clear();
+        for (size_t c = 0; c < header_.size(); c++) {
+            if (c == time_index_) {
+                continue;
+            }
+            CsvColumn column;
+            column.name = header_[c];
+            auto given = std::find_if(config_.columns.begin(), config_.columns.end(),
+                                      [&](const CsvColumn& item) { return item.name == header_[c]; });
+            if (given != config_.columns.end()) {
+                column = *given;
+            } else {
+                column.type = inferred[c] == common::TSDataType::INVALID_DATATYPE
+                                  ? common::TSDataType::STRING
+                                  : inferred[c];
+                bool tag = config_.tag_columns.empty()
+                               ? column.type == common::TSDataType::STRING
+                               : std::find(config_.tag_columns.begin(), config_.tag_columns.end(),
+                                           column.name) != config_.tag_columns.end();
+                column.category = tag ? common::ColumnCategory::TAG : common::ColumnCategory::FIELD;
+            }
+            // TAG 列只能是字符串
+            if (column.category == common::ColumnCategory::TAG) {
+                column.type = common::TSDataType::STRING;
+            }
+            columns_.push_back(column);
+            csv_indexes_.push_back(c);
+        }
+        return common::E_OK;
+    }
+
+    // open 之后的表结构（不含时间列，按 CSV 中的顺序）
+    const std::vector<CsvColumn>& columns() const { return columns_; }
+
+    // 最近一次出错的说明
+    const std::string& error() const { return error_; }
+
+    /**
+     * 导入 open 的 CSV 文件到 tsfile_path（覆盖已有文件），返回错误码（E_OK 表示成功）
+     */
+    int load(const std::string& tsfile_path, CsvLoadStats& stats) {
+        Stopwatch total;
+        stats = CsvLoadStats();
+        stats.threads = config_.threads > 0
+                            ? config_.threads
+                            : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        stats.max_inflight_blocks =
+            config_.max_inflight_blocks > 0 ? config_.max_inflight_blocks : 2 * stats.threads + 2;
+        std::FILE* input = std::fopen(csv_path_.c_str(), "rb");
+        if (input == nullptr || std::fseek(input, static_cast<long>(header_bytes_), SEEK_SET) != 0) {
+            if (input != nullptr) {
+                std::fclose(input);
+            }
+            error_ = "cannot open " + csv_path_;
+            return kCsvLoadError;
+        }
+        names_.clear();
+        types_.clear();
+        categories_.clear();
+        std::vector<common::ColumnSchema> column_schemas;
+        for (const CsvColumn& column : columns_) {
+            names_.push_back(column.name);
+            types_.push_back(column.type);
+            categories_.push_back(column.category);
+            column_schemas.emplace_back(column.name, column.type, column.category);
+        }
+
+        storage::WriteFile file;
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        mode_t mode = 0666;
+        int ret = file.create(tsfile_path, flags, mode);
+        if (ret != common::E_OK) {
+            std::fclose(input);
+            error_ = "cannot create " + tsfile_path;
+            return ret;
+        }
+        auto* schema = new storage::TableSchema(config_.table_name, column_schemas);
+        auto* writer = new storage::TsFileTableWriter(&file, schema, config_.memory_threshold);
+
+        reset_pipeline(stats.max_inflight_blocks);
+        std::thread reader([&]() { read_blocks(input, stats); });
+        std::vector<std::thread> workers;
+        for (int i = 0; i < stats.threads; i++) {
+            workers.emplace_back([this]() { parse_blocks(); });
+        }
+        write_blocks(writer, stats);
+        reader.join();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        std::fclose(input);
+        stats.parse_s = parse_s_;
+        ret = code_;
+        if (ret == common::E_OK) {
+            Stopwatch watch;
+            ret = writer->flush();
+            if (ret == common::E_OK) {
+                ret = writer->close();
+            }
+            stats.flush_close_s = watch.elapsed_s();
+            if (ret != common::E_OK) {
+                error_ = "flush / close failed";
+            }
+        }
+        delete writer;
+        delete schema;
+        stats.file_bytes = file_size_bytes(tsfile_path);
+        stats.total_s = total.elapsed_s();
+        return ret;
+    }
+
+   private:
+    // 一块完整的行：data 的前 length 字节，以换行结尾
+    struct Block {
+        uint64_t seq = 0;
+        uint64_t offset = 0;   // 在文件中的字节偏移
+        std::vector<char> data;
+        size_t length = 0;
+        int64_t rows = 0;
+        std::vector<std::unique_ptr<storage::Tablet>> tablets;
+    };
+
+    int fail_open(const std::string& message) {
+        error_ = message;
+        return kCsvLoadError;
+    }
+
+    // 切分 std::string 中的一行（去掉行尾的 '\r'）
+    size_t split_line(std::string& line, std::vector<std::string_view>& fields) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        line.push_back('\n');
+        return split_csv_line(&line[0], &line[0] + line.size() - 1, config_.delimiter, fields);
+    }
+
+    void reset_pipeline(int max_inflight) {
+        max_inflight_ = max_inflight;
+        inflight_ = 0;
+        blocks_read_ = 0;
+        reading_done_ = false;
+        code_ = common::E_OK;
+        parse_s_ = 0;
+        pending_.clear();
+        parsed_.clear();
+        free_buffers_.clear();
+    }
+
+    // 记录第一个错误并通知所有线程停止
+    void fail(int code, const std::string& message) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (code_ == common::E_OK) {
+                code_ = code;
+                error_ = message;
+            }
+        }
+        cv_.notify_all();
+    }
+
+    bool failed() const { return code_ != common::E_OK; }
+
+    // 读取线程：按块读取，每块在最后一个换行之后切分，剩余部分留给下一块
+    void read_blocks(std::FILE* input, CsvLoadStats& stats) {
+        std::vector<char> carry;
+        uint64_t offset = header_bytes_;
+        uint64_t seq = 0;
+        bool eof = false;
+        while (!eof) {
+            std::vector<char> data;
+            {
+                Stopwatch watch;
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return inflight_ < max_inflight_ || failed(); });
+                stats.read_wait_s += watch.elapsed_s();
+                if (failed()) {
+                    break;
+                }
+                inflight_++;
+                if (!free_buffers_.empty()) {
+                    data = std::move(free_buffers_.back());
+                    free_buffers_.pop_back();
+                }
+            }
+            size_t filled = carry.size();
+            if (data.size() < filled + config_.block_bytes + 1) {
+                data.resize(filled + config_.block_bytes + 1);
+            }
+            std::copy(carry.begin(), carry.end(), data.begin());
+            size_t cut = std::string::npos;
+            while (cut == std::string::npos && !eof) {
+                if (data.size() < filled + config_.block_bytes + 1) {
+                    // 一行超过 block_bytes：扩大本块
+                    data.resize(std::max(data.size() * 2, filled + config_.block_bytes + 1));
+                }
+                size_t n = std::fread(data.data() + filled, 1, config_.block_bytes, input);
+                if (n == 0) {
+                    eof = true;
+                    if (std::ferror(input)) {
+                        fail(kCsvLoadError, "read error at offset " + std::to_string(offset + filled));
+                        return;
+                    }
+                }
+                for (size_t i = filled + n; i > filled; i--) {
+                    if (data[i - 1] == '\n') {
+                        cut = i - 1;
+                        break;
+                    }
+                }
+                filled += n;
+            }
+            if (cut == std::string::npos) {
+                // 文件末尾没有换行的最后一行
+                if (filled == 0) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    inflight_--;
+                    break;
+                }
+                data[filled] = '\n';
+                cut = filled++;
+            }
+            carry.assign(data.begin() + cut + 1, data.begin() + filled);
+            auto block = std::make_unique<Block>();
+            block->seq = seq++;
+            block->offset = offset;
+            block->length = cut + 1;
+            block->data = std::move(data);
+            offset += block->length;
+            stats.input_bytes += block->length;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_.push_back(std::move(block));
+                blocks_read_ = seq;
+            }
+            cv_.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reading_done_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    // 解析线程
+    void parse_blocks() {
+        while (true) {
+            std::unique_ptr<Block> block;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return !pending_.empty() || reading_done_ || failed(); });
+                if (failed() || pending_.empty()) {
+                    return;
+                }
+                block = std::move(pending_.front());
+                pending_.pop_front();
+            }
+            Stopwatch watch;
+            std::string message;
+            int ret = parse_block(*block, message);
+            double seconds = watch.elapsed_s();
+            if (ret != common::E_OK) {
+                fail(ret, message);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                parse_s_ += seconds;
+                parsed_[block->seq] = std::move(block);
+            }
+            cv_.notify_all();
+        }
+    }
+
+    // 解析一块的全部行，填充 tablet
+    int parse_block(Block& block, std::string& message) {
+        char* begin = block.data.data();
+        char* p = begin;
+        char* end = begin + block.length;
+        int64_t remaining = std::count(p, end, '\n');
+        std::vector<std::string_view> fields;
+        std::unique_ptr<storage::Tablet> tablet;
+        uint32_t row = 0;
+        uint32_t capacity = 0;
+        while (p < end) {
+            char* eol = static_cast<char*>(std::memchr(p, '\n', end - p));
+            char* line_end = eol > p && eol[-1] == '\r' ? eol - 1 : eol;
+            uint64_t line_offset = block.offset + (p - begin);
+            if (line_end == p) {
+                remaining--;
+                p = eol + 1;
+                continue;
+            }
+            if (split_csv_line(p, line_end, config_.delimiter, fields) != header_.size()) {
+                message = "offset " + std::to_string(line_offset) + ": expected " +
+                          std::to_string(header_.size()) + " fields, got " +
+                          std::to_string(fields.size());
+                return kCsvLoadError;
+            }
+            if (tablet == nullptr) {
+                capacity = static_cast<uint32_t>(std::min(config_.tablet_rows, remaining));
+                tablet = std::make_unique<storage::Tablet>(config_.table_name, names_, types_,
+                                                           categories_, static_cast<int>(capacity));
+                row = 0;
+            }
+            int64_t timestamp = 0;
+            if (!parse_csv_number(fields[time_index_], timestamp)) {
+                message = "offset " + std::to_string(line_offset) + ": invalid timestamp '" +
+                          std::string(fields[time_index_]) + "'";
+                return kCsvLoadError;
+            }
+            int ret = tablet->add_timestamp(row, timestamp);
+            for (size_t c = 0; c < columns_.size() && ret == common::E_OK; c++) {
+                std::string_view text = fields[csv_indexes_[c]];
+                if (text.empty()) {
+                    continue;
+                }
+                ret = add_csv_value(*tablet, row, static_cast<uint32_t>(c), columns_[c].type, text);
+                if (ret != common::E_OK) {
+                    message = "offset " + std::to_string(line_offset) + ": column " +
+                              columns_[c].name + ": invalid " +
+                              datatype_to_string(columns_[c].type) + " value '" + std::string(text) +
+                              "'";
+                }
+            }
+            if (ret != common::E_OK) {
+                if (message.empty()) {
+                    message = "offset " + std::to_string(line_offset) + ": add value failed";
+                }
+                return ret;
+            }
+            block.rows++;
+            remaining--;
+            if (++row == capacity) {
+                block.tablets.push_back(std::move(tablet));
+            }
+            p = eol + 1;
+        }
+        if (tablet != nullptr && row > 0) {
+            block.tablets.push_back(std::move(tablet));
+        }
+        return common::E_OK;
+    }
+
+    // 写入线程：按块的顺序写入，写完后归还块的缓冲区
+    void write_blocks(storage::TsFileTableWriter* writer, CsvLoadStats& stats) {
+        for (uint64_t next = 0;; next++) {
+            std::unique_ptr<Block> block;
+            {
+                Stopwatch watch;
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&]() {
+                    return failed() || parsed_.count(next) > 0 ||
+                           (reading_done_ && next >= blocks_read_);
+                });
+                stats.write_wait_s += watch.elapsed_s();
+                auto it = parsed_.find(next);
+                if (failed() || it == parsed_.end()) {
+                    return;
+                }
+                block = std::move(it->second);
+                parsed_.erase(it);
+            }
+            Stopwatch watch;
+            for (const auto& tablet : block->tablets) {
+                int ret = writer->write_table(*tablet);
+                if (ret != common::E_OK) {
+                    fail(ret, "write_table failed at offset " + std::to_string(block->offset));
+                    return;
+                }
+            }
+            stats.write_s += watch.elapsed_s();
+            stats.rows += block->rows;
+            stats.tablets += block->tablets.size();
+            stats.blocks++;
+            block->tablets.clear();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                inflight_--;
+                free_buffers_.push_back(std::move(block->data));
+            }
+            cv_.notify_all();
+        }
+    }
+
+    CsvLoadConfig config_;
+    std::string csv_path_;
+    std::string error_;
+    uint64_t header_bytes_ = 0;
+    std::vector<std::string> header_;
+    size_t time_index_ = 0;
+    std::vector<CsvColumn> columns_;
+    std::vector<size_t> csv_indexes_;   // columns_[i] 在 CSV 中的列下标
+    std::vector<std::string> names_;
+    std::vector<common::TSDataType> types_;
+    std::vector<common::ColumnCategory> categories_;
+
+    // 流水线状态，由 mutex_ 保护
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int max_inflight_ = 0;
+    int inflight_ = 0;
+    uint64_t blocks_read_ = 0;
+    bool reading_done_ = false;
+    int code_ = common::E_OK;
+    double parse_s_ = 0;
+    std::deque<std::unique_ptr<Block>> pending_;
+    std::map<uint64_t, std::unique_ptr<Block>> parsed_;
+    std::vector<std::vector<char>> free_buffers_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_CSV_LOAD_H
@@ -0,0 +1,259 @@
+#ifndef HARNESS_DATA_GENERATOR_H
+#define HARNESS_DATA_GENERATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/tablet.h"
+
+/**
+ * 合成时序数据生成器：按列的数据形态生成可复现（相同种子生成相同序列）的值并填充 tablet，
+ * 使性能测试数据的压缩特性接近真实传感器数据，而不是以行号为值的平凡数据。
+ *
+ * 数据形态（ValueShape）：
+ *   ROW              —— 行号（与原测试用例相同的平凡数据，用于对比）
+ *   COUNTER          —— 单调递增计数器，每次增加 step × [0.5, 1.5)
+ *   RANDOM_WALK      —— 随机游走，每次变化 [-noise, noise)
+ *   PERIODIC         —— 周期信号 amplitude × sin(2πi / period) 叠加 [-noise, noise) 噪声
+ *   LOW_CARDINALITY  —— 在 cardinality 个取值中均匀选取
+ *   ZIPF             —— 在 cardinality 个取值中按 Zipf 分布（指数 zipf_s）选取，第 0 个取值最频繁
+ *
+ * 字符串类型的列：LOW_CARDINALITY / ZIPF 取字典中的字符串，其他形态取数值的十进制字符串；
+ * 布尔类型的列：LOW_CARDINALITY / ZIPF 为取值编号是否为 0，其他形态为取整后的数值是否为偶数。
+ */
+namespace harness {
+
+// SplitMix64 伪随机数生成器，相同种子生成相同序列
+class SplitMix64 {
+   public:
+    explicit SplitMix64(uint64_t seed = 0) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // [0, 1) 区间的均匀分布
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+   private:
+    uint64_t state_;
+};
+
+enum class ValueShape { ROW, COUNTER, RANDOM_WALK, PERIODIC, LOW_CARDINALITY, ZIPF };
+
+inline std::string shape_to_string(ValueShape shape) {
+    switch (shape) {
+        case ValueShape::ROW:
+            return "ROW";
+        case ValueShape::COUNTER:
+            return "COUNTER";
+        case ValueShape::RANDOM_WALK:
+            return "RANDOM_WALK";
+        case ValueShape::PERIODIC:
+            return "PERIODIC";
+        case ValueShape::LOW_CARDINALITY:
+            return "LOW_CARDINALITY";
+        case ValueShape::ZIPF:
+            return "ZIPF";
+    }
+    return "UNKNOWN";
+}
+
+// 形态名称转换为 ValueShape，无法识别时返回 false
+inline bool string_to_shape(const std::string& name, ValueShape& shape) {
+    const ValueShape shapes[] = {ValueShape::ROW,         ValueShape::COUNTER,
+                                 ValueShape::RANDOM_WALK, ValueShape::PERIODIC,
+                                 ValueShape::LOW_CARDINALITY, ValueShape::ZIPF};
+    for (ValueShape candidate : shapes) {
+        if (shape_to_string(candidate) == name) {
+            shape = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 一列的生成参数
+struct ColumnGenSpec {
+    ValueShape shape = ValueShape::ROW;
+    double null_rate = 0;         // 空值比例（0-1）
+    double step = 1;              // COUNTER 的平均步长
+    double noise = 1;             // RANDOM_WALK 的步长上限，PERIODIC 的噪声幅度
+    double amplitude = 100;       // PERIODIC 的振幅
+    int64_t period = 1000;        // PERIODIC 的周期（行数）
+    int64_t cardinality = 16;     // LOW_CARDINALITY / ZIPF 的取值个数
+    double zipf_s = 1.1;          // ZIPF 的指数
+    std::string text_prefix = "value_";  // 字符串字典的前缀
+};
+
+// 一列的生成器，按顺序生成该列的值
+class ColumnGenerator {
+   public:
+    ColumnGenerator(common::TSDataType type, const ColumnGenSpec& spec, uint64_t seed)
+        : type_(type), spec_(spec), random_(seed), null_random_(~seed) {
+        spec_.cardinality = std::max<int64_t>(1, spec_.cardinality);
+        spec_.period = std::max<int64_t>(1, spec_.period);
+        if (categorical()) {
+            for (int64_t i = 0; i < spec_.cardinality; i++) {
+                dictionary_.push_back(spec_.text_prefix + std::to_string(i));
+            }
+        }
+        if (spec_.shape == ValueShape::ZIPF) {
+            double sum = 0;
+            for (int64_t i = 0; i < spec_.cardinality; i++) {
+                sum += 1.0 / std::pow(static_cast<double>(i + 1), spec_.zipf_s);
+                zipf_cdf_.push_back(sum);
+            }
+            for (double& p : zipf_cdf_) {
+                p /= sum;
+            }
+        }
+    }
+
+    common::TSDataType type() const { return type_; }
+
+    /**
+     * 生成下一个值，返回 false 表示空值
+     * 空值同样推进序列状态，空值使用单独的随机数序列，空值比例不影响值的序列
+     */
+    bool next() {
+        switch (spec_.shape) {
+            case ValueShape::ROW:
+                value_ = static_cast<double>(index_);
+                break;
+            case ValueShape::COUNTER:
+                value_ += spec_.step * (0.5 + random_.uniform());
+                break;
+            case ValueShape::RANDOM_WALK:
+                value_ += spec_.noise * (2 * random_.uniform() - 1);
+                break;
+            case ValueShape::PERIODIC:
+                value_ = spec_.amplitude *
+                             std::sin(kTwoPi * static_cast<double>(index_ % spec_.period) /
+                                      static_cast<double>(spec_.period)) +
+                         spec_.noise * (2 * random_.uniform() - 1);
+                break;
+            case ValueShape::LOW_CARDINALITY:
+                category_ = static_cast<int64_t>(random_.next() % spec_.cardinality);
+                value_ = static_cast<double>(category_);
+                break;
+            case ValueShape::ZIPF:
+                category_ = static_cast<int64_t>(
+                    std::lower_bound(zipf_cdf_.begin(), zipf_cdf_.end(), random_.uniform()) -
+                    zipf_cdf_.begin());
+                category_ = std::min(category_, spec_.cardinality - 1);
+                value_ = static_cast<double>(category_);
+                break;
+        }
+        index_++;
+        return spec_.null_rate <= 0 || null_random_.uniform() >= spec_.null_rate;
+    }
+
+    int64_t int_value() const { return static_cast<int64_t>(std::llround(value_)); }
+    double double_value() const { return value_; }
+
+    bool bool_value() const { return categorical() ? category_ == 0 : int_value() % 2 == 0; }
+
+    const std::string& text_value() {
+        if (categorical()) {
+            return dictionary_[category_];
+        }
+        text_ = std::to_string(int_value());
+        return text_;
+    }
+
+    // 生成下一个值写入 tablet 的 (row, col)，空值不写入
+    int fill(storage::Tablet& tablet, uint32_t row, uint32_t col) {
+        if (!next()) {
+            return common::E_OK;
+        }
+        switch (type_) {
+            case common::TSDataType::INT64:
+            case common::TSDataType::TIMESTAMP:
+                return tablet.add_value(row, col, int_value());
+            case common::TSDataType::INT32:
+            case common::TSDataType::DATE:
+                return tablet.add_value(row, col, static_cast<int32_t>(int_value()));
+            case common::TSDataType::FLOAT:
+                return tablet.add_value(row, col, static_cast<float>(value_));
+            case common::TSDataType::DOUBLE:
+                return tablet.add_value(row, col, value_);
+            case common::TSDataType::BOOLEAN:
+                return tablet.add_value(row, col, bool_value());
+            case common::TSDataType::TEXT:
+            case common::TSDataType::STRING:
+            case common::TSDataType::BLOB:
+                return tablet.add_value(row, col, text_value().c_str());
+            default:
+                return -1;
+        }
+    }
+
+   private:
+    static constexpr double kTwoPi = 6.283185307179586;
+
+    bool categorical() const {
+        return spec_.shape == ValueShape::LOW_CARDINALITY || spec_.shape == ValueShape::ZIPF;
+    }
+
+    common::TSDataType type_;
+    ColumnGenSpec spec_;
+    SplitMix64 random_;
+    SplitMix64 null_random_;
+    int64_t index_ = 0;
+    double value_ = 0;
+    int64_t category_ = 0;
+    std::vector<std::string> dictionary_;
+    std::vector<double> zipf_cdf_;
+    std::string text_;
+};
+
+/**
+ * tablet 生成器：每列一个 ColumnGenerator，第 i 列的种子由 seed 和 i 确定，
+ * 多次 fill 之间序列连续，时间戳从 start_time 开始按 interval 递增
+ */
+class TabletGenerator {
+   public:
+    TabletGenerator(const std::vector<common::TSDataType>& data_types,
+                    const std::vector<ColumnGenSpec>& specs, uint64_t seed,
+                    int64_t start_time = 0, int64_t interval = 1)
+        : next_time_(start_time), interval_(interval) {
+        SplitMix64 seeds(seed);
+        for (size_t i = 0; i < data_types.size(); i++) {
+            columns_.emplace_back(data_types[i], specs[i], seeds.next());
+        }
+    }
+
+    size_t column_count() const { return columns_.size(); }
+    ColumnGenerator& column(size_t i) { return columns_[i]; }
+    int64_t next_time() const { return next_time_; }
+
+    // 填充 tablet 的第 [0, rows) 行
+    int fill(storage::Tablet& tablet, uint32_t rows) {
+        int ret = common::E_OK;
+        for (uint32_t row = 0; row < rows && ret == common::E_OK; row++) {
+            ret = tablet.add_timestamp(row, next_time_);
+            next_time_ += interval_;
+            for (size_t c = 0; c < columns_.size() && ret == common::E_OK; c++) {
+                ret = columns_[c].fill(tablet, row, static_cast<uint32_t>(c));
+            }
+        }
+        return ret;
+    }
+
+   private:
+    std::vector<ColumnGenerator> columns_;
+    int64_t next_time_;
+    int64_t interval_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_DATA_GENERATOR_H
@@ -0,0 +1,590 @@
+#ifndef HARNESS_IO_ACCOUNTING_H
+#define HARNESS_IO_ACCOUNTING_H
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "harness/bench_util.h"
+
+/**
+ * 文件 I/O 统计：统计 storage::WriteFile 和 TsFileReader 实际执行的系统调用次数和字节数。
+ * 库内部直接调用 open / read / pread / write / lseek / fsync / close，无法替换其文件层，
+ * 因此在可执行文件中定义同名函数拦截这些调用（转发给 libc 的实现），按阶段累计：
+ *   调用次数、字节数、显式 lseek 次数、fsync 次数、不连续的 pread 次数（随机读），
+ *   以及每次读写大小按 2 的幂分组的分布。
+ *
+ * 使用方式：
+ *   1. 在可执行文件的一个源文件中定义 HARNESS_IO_ACCOUNTING_HOOKS 后包含本头文件（定义拦截函数），
+ *      并链接 ${CMAKE_DL_LIBS}；其他源文件直接包含本头文件即可。
+ *   2. 运行时选择是否统计：调用 IoAccounting::instance().enable(filter)，
+ *      或设置环境变量 HARNESS_IO_ACCOUNTING=filter（为 1 时使用默认的 ".tsfile"）。
+ *      只统计启用后打开的、路径包含 filter 的文件，标准输出、日志等其他文件不计入。
+ *   3. 用 IoPhaseScope 标记当前阶段（open / query / next / flush / close），其余调用计入 other。
+ *   4. 可选安装 IoRedirect，由它代替 libc 处理 pread（例如 harness/mmap_read.h 从内存映射中复制）。
+ * 阶段是进程级的（不是线程级），多个线程同时读写时按各自调用时的当前阶段计入。
+ */
+namespace harness {
+
+enum class IoPhase { OTHER, OPEN, QUERY, NEXT, FLUSH, CLOSE };
+
+constexpr int kIoPhaseCount = 6;
+// 可跟踪的最大文件描述符（不含）
+constexpr int kIoMaxFds = 65536;
+// 读写大小分布的分组数：第 0 组为 0 字节，第 i 组为 [2^(i-1), 2^i)
+constexpr int kIoSizeBuckets = 40;
+
+inline const char* phase_to_string(IoPhase phase) {
+    switch (phase) {
+        case IoPhase::OTHER:
+            return "other";
+        case IoPhase::OPEN:
+            return "open";
+        case IoPhase::QUERY:
+            return "query";
+        case IoPhase::NEXT:
+            return "next";
+        case IoPhase::FLUSH:
+            return "flush";
+        case IoPhase::CLOSE:
+            return "close";
+    }
+    return "unknown";
+}
+
+// 读写大小所在的分组
+inline int io_size_bucket(uint64_t size) {
+    int bucket = 0;
+    while (size > 0 && bucket < kIoSizeBuckets - 1) {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// 一个阶段的统计
+struct IoCounters {
+    uint64_t opens = 0;
+    uint64_t closes = 0;
+    uint64_t reads = 0;          // read + pread 次数
+    uint64_t read_bytes = 0;
+    uint64_t random_reads = 0;   // 起始位置不等于同一文件上一次读取结束位置的 pread 次数
+    uint64_t writes = 0;         // write + pwrite 次数
+    uint64_t write_bytes = 0;
+    uint64_t seeks = 0;          // 显式 lseek 次数
+    uint64_t fsyncs = 0;         // fsync + fdatasync 次数
+    std::array<uint64_t, kIoSizeBuckets> read_sizes{};
+    std::array<uint64_t, kIoSizeBuckets> write_sizes{};
+
+    void add(const IoCounters& other) {
+        opens += other.opens;
+        closes += other.closes;
+        reads += other.reads;
+        read_bytes += other.read_bytes;
+        random_reads += other.random_reads;
+        writes += other.writes;
+        write_bytes += other.write_bytes;
+        seeks += other.seeks;
+        fsyncs += other.fsyncs;
+        for (int i = 0; i < kIoSizeBuckets; i++) {
+            read_sizes[i] += other.read_sizes[i];
+            write_sizes[i] += other.write_sizes[i];
+        }
+    }
+};
+
+// 各阶段统计的快照
+struct IoReport {
+    std::array<IoCounters, kIoPhaseCount> phases;
+
+    const IoCounters& phase(IoPhase phase) const { return phases[static_cast<int>(phase)]; }
+
+    IoCounters total() const {
+        IoCounters sum;
+        for (const IoCounters& counters : phases) {
+            sum.add(counters);
+        }
+        return sum;
+    }
+
+    // 两次快照之差（this - before），用于统计一段操作的 I/O
+    IoReport since(const IoReport& before) const {
+        IoReport diff = *this;
+        for (int p = 0; p < kIoPhaseCount; p++) {
+            IoCounters& d = diff.phases[p];
+            const IoCounters& b = before.phases[p];
+            d.opens -= b.opens;
+            d.closes -= b.closes;
+            d.reads -= b.reads;
+            d.read_bytes -= b.read_bytes;
+            d.random_reads -= b.random_reads;
+            d.writes -= b.writes;
+            d.write_bytes -= b.write_bytes;
+            d.seeks -= b.seeks;
+            d.fsyncs -= b.fsyncs;
+            for (int i = 0; i < kIoSizeBuckets; i++) {
+                d.read_sizes[i] -= b.read_sizes[i];
+                d.write_sizes[i] -= b.write_sizes[i];
+            }
+        }
+        return diff;
+    }
+};
+
+/**
+ * 读取重定向：安装后，拦截函数在文件打开之后、关闭之前通知它，
+ * pread 先交给它处理，返回 false 时再调用 libc 的实现；重定向处理的读取同样计入统计
+ */
+class IoRedirect {
+   public:
+    virtual ~IoRedirect() = default;
+    virtual void on_open(int fd, const char* path, int flags) = 0;
+    virtual void on_close(int fd) = 0;
+    virtual bool pread(int fd, void* buf, size_t count, int64_t offset, ssize_t& ret) = 0;
+};
+
+class IoAccounting {
+   public:
+    static IoAccounting& instance() {
+        static IoAccounting accounting;
+        return accounting;
+    }
+
+    // 开始统计之后打开的、路径包含 filter 的文件
+    void enable(const std::string& filter = ".tsfile") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        filter_ = filter;
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    // 停止统计新打开的文件，已打开的文件继续统计直到关闭
+    void disable() { enabled_.store(false, std::memory_order_release); }
+
+    bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    // 清零所有阶段的统计（不影响已跟踪的文件）
+    void reset() {
+        for (PhaseCounters& counters : phases_) {
+            counters.clear();
+        }
+    }
+
+    // 设置当前阶段，返回之前的阶段
+    IoPhase set_phase(IoPhase phase) {
+        return static_cast<IoPhase>(phase_.exchange(static_cast<int>(phase)));
+    }
+
+    IoReport report() const {
+        IoReport report;
+        for (int p = 0; p < kIoPhaseCount; p++) {
+            phases_[p].load(report.phases[p]);
+        }
+        return report;
+    }
+
+    // 安装读取重定向，nullptr 表示取消；已打开的文件不会补发 on_open
+    void set_redirect(IoRedirect* redirect) { redirect_.store(redirect, std::memory_order_release); }
+
+    IoRedirect* redirect() const { return redirect_.load(std::memory_order_acquire); }
+
+    // 以下由拦截函数调用
+    void on_open(int fd, const char* path) {
+        if (fd < 0 || fd >= kIoMaxFds || !enabled() || path == nullptr) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (std::strstr(path, filter_.c_str()) == nullptr) {
+                return;
+            }
+        }
+        next_offsets_[fd].store(0, std::memory_order_relaxed);
+        tracked_[fd].store(true, std::memory_order_release);
+        current().opens++;
+    }
+
+    void on_close(int fd) {
+        if (tracked(fd)) {
+            tracked_[fd].store(false, std::memory_order_release);
+            current().closes++;
+        }
+    }
+
+    void on_read(int fd, ssize_t bytes, int64_t offset = -1) {
+        if (!tracked(fd)) {
+            return;
+        }
+        PhaseCounters& counters = current();
+        counters.reads++;
+        if (offset >= 0) {
+            int64_t expected = next_offsets_[fd].exchange(offset + std::max<ssize_t>(bytes, 0),
+                                                          std::memory_order_relaxed);
+            if (offset != expected) {
+                counters.random_reads++;
+            }
+        }
+        if (bytes > 0) {
+            counters.read_bytes += static_cast<uint64_t>(bytes);
+        }
+        counters.read_sizes[io_size_bucket(bytes > 0 ? bytes : 0)]++;
+    }
+
+    void on_write(int fd, ssize_t bytes) {
+        if (!tracked(fd)) {
+            return;
+        }
+        PhaseCounters& counters = current();
+        counters.writes++;
+        if (bytes > 0) {
+            counters.write_bytes += static_cast<uint64_t>(bytes);
+        }
+        counters.write_sizes[io_size_bucket(bytes > 0 ? bytes : 0)]++;
+    }
+
+    void on_seek(int fd) {
+        if (tracked(fd)) {
+            current().seeks++;
+        }
+    }
+
+    void on_fsync(int fd) {
+        if (tracked(fd)) {
+            current().fsyncs++;
+        }
+    }
+
+   private:
+    // 一个阶段的计数器（原子变量，拦截函数可能在多个线程中同时调用）
+    struct PhaseCounters {
+        std::atomic<uint64_t> opens{0};
+        std::atomic<uint64_t> closes{0};
+        std::atomic<uint64_t> reads{0};
+        std::atomic<uint64_t> read_bytes{0};
+        std::atomic<uint64_t> random_reads{0};
+        std::atomic<uint64_t> writes{0};
+        std::atomic<uint64_t> write_bytes{0};
+        std::atomic<uint64_t> seeks{0};
+        std::atomic<uint64_t> fsyncs{0};
+        std::array<std::atomic<uint64_t>, kIoSizeBuckets> read_sizes{};
+        std::array<std::atomic<uint64_t>, kIoSizeBuckets> write_sizes{};
+
+        void clear() {
+            opens = closes = reads = read_bytes = random_reads = 0;
+            writes = write_bytes = seeks = fsyncs = 0;
+            for (int i = 0; i < kIoSizeBuckets; i++) {
+                read_sizes[i] = 0;
+                write_sizes[i] = 0;
+            }
+        }
+
+        void load(IoCounters& out) const {
+            out.opens = opens;
+            out.closes = closes;
+            out.reads = reads;
+            out.read_bytes = read_bytes;
+            out.random_reads = random_reads;
+            out.writes = writes;
+            out.write_bytes = write_bytes;
+            out.seeks = seeks;
+            out.fsyncs = fsyncs;
+            for (int i = 0; i < kIoSizeBuckets; i++) {
+                out.read_sizes[i] = read_sizes[i];
+                out.write_sizes[i] = write_sizes[i];
+            }
+        }
+    };
+
+    IoAccounting() {
+        const char* filter = std::getenv("HARNESS_IO_ACCOUNTING");
+        if (filter != nullptr && filter[0] != '\0') {
+            enable(std::strcmp(filter, "1") == 0 ? ".tsfile" : filter);
+        }
+    }
+
+    bool tracked(int fd) const {
+        return fd >= 0 && fd < kIoMaxFds && tracked_[fd].load(std::memory_order_acquire);
+    }
+
+    PhaseCounters& current() { return phases_[phase_.load(std::memory_order_relaxed)]; }
+
+    std::mutex mutex_;
+    std::string filter_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<int> phase_{static_cast<int>(IoPhase::OTHER)};
+    std::atomic<IoRedirect*> redirect_{nullptr};
+    std::array<PhaseCounters, kIoPhaseCount> phases_;
+    std::array<std::atomic<bool>, kIoMaxFds> tracked_{};
+    std::array<std::atomic<int64_t>, kIoMaxFds> next_offsets_{};
+};
+
+// 在作用域内设置当前阶段，离开作用域时恢复之前的阶段
+class IoPhaseScope {
+   public:
+    explicit IoPhaseScope(IoPhase phase) : previous_(IoAccounting::instance().set_phase(phase)) {}
+    ~IoPhaseScope() { IoAccounting::instance().set_phase(previous_); }
+
+    IoPhaseScope(const IoPhaseScope&) = delete;
+    IoPhaseScope& operator=(const IoPhaseScope&) = delete;
+
+   private:
+    IoPhase previous_;
+};
+
+// 输出各阶段统计，无 I/O 的阶段不输出
+inline void print_io_report(const IoReport& report, const std::string& indent = "") {
+    printf("%s%-8s %8s %8s %12s %8s %8s %12s %8s %8s\n", indent.c_str(), "phase", "opens",
+           "reads", "read_MB", "random", "writes", "write_MB", "seeks", "fsyncs");
+    auto print_row = [&](const char* name, const IoCounters& c) {
+        printf("%s%-8s %8llu %8llu %12.3f %8llu %8llu %12.3f %8llu %8llu\n", indent.c_str(), name,
+               (unsigned long long)c.opens, (unsigned long long)c.reads, to_mb(c.read_bytes),
+               (unsigned long long)c.random_reads, (unsigned long long)c.writes,
+               to_mb(c.write_bytes), (unsigned long long)c.seeks, (unsigned long long)c.fsyncs);
+    };
+    for (int p = 0; p < kIoPhaseCount; p++) {
+        const IoCounters& c = report.phases[p];
+        if (c.opens + c.closes + c.reads + c.writes + c.seeks + c.fsyncs > 0) {
+            print_row(phase_to_string(static_cast<IoPhase>(p)), c);
+        }
+    }
+    print_row("total", report.total());
+}
+
+// 输出读写大小分布，例如 "read [4KB,8KB): 12"
+inline void print_io_sizes(const IoCounters& counters, const std::string& indent = "") {
+    auto print_sizes = [&](const char* name, const std::array<uint64_t, kIoSizeBuckets>& sizes) {
+        for (int i = 0; i < kIoSizeBuckets; i++) {
+            if (sizes[i] == 0) {
+                continue;
+            }
+            if (i == 0) {
+                printf("%s%s 0B: %llu\n", indent.c_str(), name, (unsigned long long)sizes[i]);
+            } else {
+                printf("%s%s [%lluB,%lluB): %llu\n", indent.c_str(), name, 1ULL << (i - 1),
+                       1ULL << i, (unsigned long long)sizes[i]);
+            }
+        }
+    };
+    print_sizes("read", counters.read_sizes);
+    print_sizes("write", counters.write_sizes);
+}
+
+}  // namespace harness
+
+#ifdef HARNESS_IO_ACCOUNTING_HOOKS
+#include <dlfcn.h>
+
+/**
+ * 拦截函数：通过 asm 标签定义与 libc 同名的符号，不与 _FORTIFY_SOURCE 的内联包装函数冲突；
+ * 动态链接时可执行文件中的定义优先于 libc，原始实现通过 dlsym(RTLD_NEXT) 取得。
+ * 拦截函数保留 errno，统计本身不改变调用结果。
+ */
+namespace harness {
+namespace io_hooks {
+
+template <typename F>
+F real_function(const char* name) {
+    return reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+}
+
+// open 的第三个参数只在创建文件时有效
+inline bool open_has_mode(int flags) {
+#ifdef O_TMPFILE
+    return (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE;
+#else
+    return (flags & O_CREAT) != 0;
+#endif
+}
+
+// 文件打开后通知统计和读取重定向
+inline void notify_open(int fd, const char* path, int flags) {
+    IoAccounting& accounting = IoAccounting::instance();
+    accounting.on_open(fd, path);
+    if (IoRedirect* redirect = accounting.redirect()) {
+        redirect->on_open(fd, path, flags);
+    }
+}
+
+}  // namespace io_hooks
+}  // namespace harness
+
+extern "C" {
+int harness_hook_open(const char* path, int flags, ...) __asm__("open");
+int harness_hook_open64(const char* path, int flags, ...) __asm__("open64");
+int harness_hook_openat(int dirfd, const char* path, int flags, ...) __asm__("openat");
+int harness_hook_close(int fd) __asm__("close");
+ssize_t harness_hook_read(int fd, void* buf, size_t count) __asm__("read");
+ssize_t harness_hook_pread(int fd, void* buf, size_t count, off_t offset) __asm__("pread");
+ssize_t harness_hook_pread64(int fd, void* buf, size_t count, off64_t offset) __asm__("pread64");
+ssize_t harness_hook_write(int fd, const void* buf, size_t count) __asm__("write");
+ssize_t harness_hook_pwrite(int fd, const void* buf, size_t count, off_t offset) __asm__("pwrite");
+ssize_t harness_hook_pwrite64(int fd, const void* buf, size_t count, off64_t offset)
+    __asm__("pwrite64");
+off_t harness_hook_lseek(int fd, off_t offset, int whence) __asm__("lseek");
+off64_t harness_hook_lseek64(int fd, off64_t offset, int whence) __asm__("lseek64");
+int harness_hook_fsync(int fd) __asm__("fsync");
+int harness_hook_fdatasync(int fd) __asm__("fdatasync");
+}
+
+#define HARNESS_IO_HOOK_OPEN(hook, real_name)                                               \
+    int hook(const char* path, int flags, ...) {                                            \
+        static auto real = harness::io_hooks::real_function<int (*)(const char*, int, ...)>( \
+            real_name);                                                                     \
+        mode_t mode = 0;                                                                    \
+        if (harness::io_hooks::open_has_mode(flags)) {                                      \
+            va_list args;                                                                   \
+            va_start(args, flags);                                                          \
+            mode = static_cast<mode_t>(va_arg(args, int));                                  \
+            va_end(args);                                                                   \
+        }                                                                                   \
+        int fd = real(path, flags, mode);                                                   \
+        int saved_errno = errno;                                                            \
+        harness::io_hooks::notify_open(fd, path, flags);                                    \
+        errno = saved_errno;                                                                \
+        return fd;                                                                          \
+    }
+
+HARNESS_IO_HOOK_OPEN(harness_hook_open, "open")
+HARNESS_IO_HOOK_OPEN(harness_hook_open64, "open64")
+
+#undef HARNESS_IO_HOOK_OPEN
+
+int harness_hook_openat(int dirfd, const char* path, int flags, ...) {
+    static auto real =
+        harness::io_hooks::real_function<int (*)(int, const char*, int, ...)>("openat");
+    mode_t mode = 0;
+    if (harness::io_hooks::open_has_mode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, int));
+        va_end(args);
+    }
+    int fd = real(dirfd, path, flags, mode);
+    int saved_errno = errno;
+    harness::io_hooks::notify_open(fd, path, flags);
+    errno = saved_errno;
+    return fd;
+}
+
+int harness_hook_close(int fd) {
+    static auto real = harness::io_hooks::real_function<int (*)(int)>("close");
+    harness::IoAccounting& accounting = harness::IoAccounting::instance();
+    if (harness::IoRedirect* redirect = accounting.redirect()) {
+        redirect->on_close(fd);
+    }
+    accounting.on_close(fd);
+    return real(fd);
+}
+
+ssize_t harness_hook_read(int fd, void* buf, size_t count) {
+    static auto real = harness::io_hooks::real_function<ssize_t (*)(int, void*, size_t)>("read");
+    ssize_t ret = real(fd, buf, count);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_read(fd, ret);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t harness_hook_pread(int fd, void* buf, size_t count, off_t offset) {
+    static auto real =
+        harness::io_hooks::real_function<ssize_t (*)(int, void*, size_t, off_t)>("pread");
+    harness::IoRedirect* redirect = harness::IoAccounting::instance().redirect();
+    ssize_t ret = 0;
+    if (redirect == nullptr || !redirect->pread(fd, buf, count, offset, ret)) {
+        ret = real(fd, buf, count, offset);
+    }
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_read(fd, ret, offset);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t harness_hook_pread64(int fd, void* buf, size_t count, off64_t offset) {
+    static auto real =
+        harness::io_hooks::real_function<ssize_t (*)(int, void*, size_t, off64_t)>("pread64");
+    harness::IoRedirect* redirect = harness::IoAccounting::instance().redirect();
+    ssize_t ret = 0;
+    if (redirect == nullptr || !redirect->pread(fd, buf, count, offset, ret)) {
+        ret = real(fd, buf, count, offset);
+    }
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_read(fd, ret, offset);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t harness_hook_write(int fd, const void* buf, size_t count) {
+    static auto real =
+        harness::io_hooks::real_function<ssize_t (*)(int, const void*, size_t)>("write");
+    ssize_t ret = real(fd, buf, count);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_write(fd, ret);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t harness_hook_pwrite(int fd, const void* buf, size_t count, off_t offset) {
+    static auto real =
+        harness::io_hooks::real_function<ssize_t (*)(int, const void*, size_t, off_t)>("pwrite");
+    ssize_t ret = real(fd, buf, count, offset);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_write(fd, ret);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t harness_hook_pwrite64(int fd, const void* buf, size_t count, off64_t offset) {
+    static auto real =
+        harness::io_hooks::real_function<ssize_t (*)(int, const void*, size_t, off64_t)>(
+            "pwrite64");
+    ssize_t ret = real(fd, buf, count, offset);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_write(fd, ret);
+    errno = saved_errno;
+    return ret;
+}
+
+off_t harness_hook_lseek(int fd, off_t offset, int whence) {
+    static auto real = harness::io_hooks::real_function<off_t (*)(int, off_t, int)>("lseek");
+    off_t ret = real(fd, offset, whence);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_seek(fd);
+    errno = saved_errno;
+    return ret;
+}
+
+off64_t harness_hook_lseek64(int fd, off64_t offset, int whence) {
+    static auto real = harness::io_hooks::real_function<off64_t (*)(int, off64_t, int)>("lseek64");
+    off64_t ret = real(fd, offset, whence);
+    int saved_errno = errno;
+    harness::IoAccounting::instance().on_seek(fd);
+    errno = saved_errno;
+    return ret;
+}
+
+int harness_hook_fsync(int fd) {
+    static auto real = harness::io_hooks::real_function<int (*)(int)>("fsync");
+    harness::IoAccounting::instance().on_fsync(fd);
+    return real(fd);
+}
+
+int harness_hook_fdatasync(int fd) {
+    static auto real = harness::io_hooks::real_function<int (*)(int)>("fdatasync");
+    harness::IoAccounting::instance().on_fsync(fd);
+    return real(fd);
+}
+
+#endif  // HARNESS_IO_ACCOUNTING_HOOKS
+
+#endif  // HARNESS_IO_ACCOUNTING_H
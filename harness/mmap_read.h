@@ -0,0 +1,201 @@
+#ifndef HARNESS_MMAP_READ_H
+#define HARNESS_MMAP_READ_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "common/db_common.h"
+
+#include "harness/io_accounting.h"
+
+/**
+ * 内存映射读取模式：启用后，以只读方式打开的、路径包含 filter 的文件在打开时整体映射到内存，
+ * 读取器的 pread 直接从映射中复制，不再进入内核（无系统调用、无内核到用户缓冲区的复制），
+ * 映射区域按 advice 调用 madvise（顺序读、随机读、预读），文件关闭时解除映射。
+ *
+ * TsFileReader 的文件访问在库内部，读取器仍把数据复制到自己的缓冲区，无法原地访问映射中的字节；
+ * 本模式通过 io_accounting.h 的拦截函数实现（IoRedirect），需要在可执行文件中定义
+ * HARNESS_IO_ACCOUNTING_HOOKS，未定义时启用本模式不生效（served_reads 为 0）。
+ * 映射失败（空文件等）时回退到 pread。
+ */
+namespace harness {
+
+enum class MmapAdvice { NORMAL, SEQUENTIAL, RANDOM, WILLNEED };
+
+inline std::string advice_to_string(MmapAdvice advice) {
+    switch (advice) {
+        case MmapAdvice::NORMAL:
+            return "NORMAL";
+        case MmapAdvice::SEQUENTIAL:
+            return "SEQUENTIAL";
+        case MmapAdvice::RANDOM:
+            return "RANDOM";
+        case MmapAdvice::WILLNEED:
+            return "WILLNEED";
+    }
+    return "UNKNOWN";
+}
+
+// 名称转换为 MmapAdvice，无法识别时返回 false
+inline bool string_to_advice(const std::string& name, MmapAdvice& advice) {
+    const MmapAdvice advices[] = {MmapAdvice::NORMAL, MmapAdvice::SEQUENTIAL, MmapAdvice::RANDOM,
+                                  MmapAdvice::WILLNEED};
+    for (MmapAdvice candidate : advices) {
+        if (advice_to_string(candidate) == name) {
+            advice = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+class MmapReadMode : public IoRedirect {
+   public:
+    static MmapReadMode& instance() {
+        static MmapReadMode mode;
+        return mode;
+    }
+
+    // 之后以只读方式打开的、路径包含 filter 的文件使用内存映射读取
+    void enable(const std::string& filter, MmapAdvice advice = MmapAdvice::NORMAL) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            filter_ = filter;
+            advice_ = advice;
+        }
+        enabled_.store(true, std::memory_order_release);
+        IoAccounting::instance().set_redirect(this);
+    }
+
+    // 停止映射新打开的文件，已映射的文件在关闭时解除映射
+    void disable() { enabled_.store(false, std::memory_order_release); }
+
+    bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    uint64_t mapped_files() const { return mapped_files_.load(); }
+    uint64_t served_reads() const { return served_reads_.load(); }
+    uint64_t served_bytes() const { return served_bytes_.load(); }
+
+    void reset_counters() {
+        mapped_files_ = 0;
+        served_reads_ = 0;
+        served_bytes_ = 0;
+    }
+
+    void on_open(int fd, const char* path, int flags) override {
+        if (fd < 0 || fd >= kIoMaxFds || !enabled() || path == nullptr ||
+            (flags & O_ACCMODE) != O_RDONLY) {
+            return;
+        }
+        MmapAdvice advice;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (std::strstr(path, filter_.c_str()) == nullptr) {
+                return;
+            }
+            advice = advice_;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            return;
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            return;
+        }
+        madvise(data, size, madvise_flag(advice));
+        sizes_[fd].store(size, std::memory_order_relaxed);
+        mappings_[fd].store(static_cast<const char*>(data), std::memory_order_release);
+        mapped_files_++;
+    }
+
+    void on_close(int fd) override {
+        if (fd < 0 || fd >= kIoMaxFds) {
+            return;
+        }
+        const char* data = mappings_[fd].exchange(nullptr, std::memory_order_acq_rel);
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), sizes_[fd].load(std::memory_order_relaxed));
+        }
+    }
+
+    // 从映射中复制 [offset, offset + count)，超出文件末尾的部分不复制（与 pread 相同）
+    bool pread(int fd, void* buf, size_t count, int64_t offset, ssize_t& ret) override {
+        if (fd < 0 || fd >= kIoMaxFds || offset < 0) {
+            return false;
+        }
+        const char* data = mappings_[fd].load(std::memory_order_acquire);
+        if (data == nullptr) {
+            return false;
+        }
+        uint64_t size = sizes_[fd].load(std::memory_order_relaxed);
+        uint64_t start = static_cast<uint64_t>(offset);
+        size_t bytes = start >= size ? 0 : static_cast<size_t>(std::min<uint64_t>(count, size - start));
+        std::memcpy(buf, data + start, bytes);
+        ret = static_cast<ssize_t>(bytes);
+        served_reads_++;
+        served_bytes_ += bytes;
+        return true;
+    }
+
+   private:
+    MmapReadMode() = default;
+
+    static int madvise_flag(MmapAdvice advice) {
+        switch (advice) {
+            case MmapAdvice::SEQUENTIAL:
+                return MADV_SEQUENTIAL;
+            case MmapAdvice::RANDOM:
+                return MADV_RANDOM;
+            case MmapAdvice::WILLNEED:
+                return MADV_WILLNEED;
+            case MmapAdvice::NORMAL:
+                break;
+        }
+        return MADV_NORMAL;
+    }
+
+    std::mutex mutex_;
+    std::string filter_;
+    MmapAdvice advice_ = MmapAdvice::NORMAL;
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> mapped_files_{0};
+    std::atomic<uint64_t> served_reads_{0};
+    std::atomic<uint64_t> served_bytes_{0};
+    std::array<std::atomic<const char*>, kIoMaxFds> mappings_{};
+    std::array<std::atomic<size_t>, kIoMaxFds> sizes_{};
+};
+
+/**
+ * 把文件从页缓存中移出（posix_fadvise DONTNEED，不需要 root 权限），用于冷缓存测试
+ * 只能移出干净的页，因此先 fdatasync；返回 E_OK 表示成功
+ * 直接以系统调用打开和关闭文件，绕过拦截函数：否则启用本模式时打开文件会映射整个文件并按 advice
+ * 预读（WILLNEED），与随后的 DONTNEED 竞争，冷缓存测试的文件可能部分仍在页缓存中
+ */
+inline int evict_page_cache(const std::string& path) {
+    int fd = static_cast<int>(syscall(SYS_openat, AT_FDCWD, path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd < 0) {
+        return -1;
+    }
+    int ret = fdatasync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0
+                  ? common::E_OK
+                  : -1;
+    syscall(SYS_close, fd);
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_MMAP_READ_H
@@ -0,0 +1,138 @@
+#ifndef HARNESS_PARALLEL_SCAN_H
+#define HARNESS_PARALLEL_SCAN_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/column_batch.h"
+
+/**
+ * 表模型并行查询：把一个表查询按时间范围切分为多个分区，由多个工作线程并行读取，
+ * 每个分区的数据以 ColumnBatch 的形式交给调用方（按分区迭代，不做全局归并）。
+ *
+ * TsFileReader 的查询会共享读取器内部的文件句柄和元数据缓存，同一个读取器上的
+ * 多个结果集不能在多个线程中同时读取。因此每个工作线程打开一个读取器并在该线程的
+ * 所有分区之间复用，文件页缓存由操作系统在线程之间共享。
+ * 分区之间时间范围不相交且按时间排序，按分区下标顺序拼接即为按时间分段有序的结果。
+ */
+namespace harness {
+
+// 一个查询分区，时间范围为闭区间 [start_time, end_time]
+struct ScanPartition {
+    int index = 0;
+    int64_t start_time = 0;
+    int64_t end_time = 0;
+};
+
+// 把闭区间 [start_time, end_time] 均分为 parts 个分区
+inline std::vector<ScanPartition> split_time_range(int64_t start_time, int64_t end_time,
+                                                   int parts) {
+    std::vector<ScanPartition> partitions;
+    if (parts <= 0 || start_time > end_time) {
+        return partitions;
+    }
+    // 使用无符号数计算跨度，避免 [INT64_MIN, INT64_MAX] 溢出
+    uint64_t span = static_cast<uint64_t>(end_time) - static_cast<uint64_t>(start_time);
+    uint64_t step = span / static_cast<uint64_t>(parts);
+    int64_t begin = start_time;
+    for (int i = 0; i < parts; i++) {
+        ScanPartition partition;
+        partition.index = i;
+        partition.start_time = begin;
+        partition.end_time = i == parts - 1 ? end_time
+                                            : static_cast<int64_t>(static_cast<uint64_t>(begin) + step);
+        partitions.push_back(partition);
+        if (partition.end_time == end_time) {
+            break;
+        }
+        begin = partition.end_time + 1;
+    }
+    return partitions;
+}
+
+/**
+ * 分区数据的处理函数，在工作线程中调用（不同分区可能同时调用，需自行保证线程安全），
+ * 返回非 E_OK 时停止全部查询
+ */
+using PartitionConsumer = std::function<int(const ScanPartition&, const ColumnBatch&)>;
+
+class ParallelTableScan {
+   public:
+    ParallelTableScan(const std::string& file_path, const std::string& table_name,
+                      const std::vector<std::string>& columns, uint32_t batch_rows = 1024)
+        : file_path_(file_path), table_name_(table_name), columns_(columns),
+          batch_rows_(batch_rows) {}
+
+    /**
+     * 使用 thread_count 个工作线程读取全部分区，工作线程按分区下标顺序领取分区
+     * 返回第一个错误码（E_OK 表示全部成功）
+     */
+    int run(const std::vector<ScanPartition>& partitions, int thread_count,
+            const PartitionConsumer& consumer) {
+        std::atomic<size_t> next_partition(0);
+        std::atomic<int> error(common::E_OK);
+        std::vector<std::thread> workers;
+        thread_count = std::max(1, std::min<int>(thread_count, static_cast<int>(partitions.size())));
+        for (int t = 0; t < thread_count; t++) {
+            workers.emplace_back([&]() {
+                storage::TsFileReader reader;
+                int ret = reader.open(file_path_);
+                while (ret == common::E_OK && error == common::E_OK) {
+                    size_t i = next_partition++;
+                    if (i >= partitions.size()) {
+                        break;
+                    }
+                    ret = scan_partition(reader, partitions[i], consumer);
+                }
+                reader.close();
+                if (ret != common::E_OK) {
+                    int expected = common::E_OK;
+                    error.compare_exchange_strong(expected, ret);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return error;
+    }
+
+   private:
+    int scan_partition(storage::TsFileReader& reader, const ScanPartition& partition,
+                       const PartitionConsumer& consumer) {
+        storage::ResultSet* temp_ret = nullptr;
+        int ret = reader.query(table_name_, columns_, partition.start_time, partition.end_time,
+                               temp_ret);
+        if (ret != common::E_OK) {
+            return ret;
+        }
+        auto* table_ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+        ColumnBatchReader batch_reader(table_ret);
+        ColumnBatch batch = batch_reader.create_batch(batch_rows_);
+        while ((ret = batch_reader.next_batch(batch)) == common::E_OK && batch.row_count() > 0) {
+            ret = consumer(partition, batch);
+            if (ret != common::E_OK) {
+                break;
+            }
+        }
+        table_ret->close();
+        return ret;
+    }
+
+    std::string file_path_;
+    std::string table_name_;
+    std::vector<std::string> columns_;
+    uint32_t batch_rows_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_PARALLEL_SCAN_H
@@ -0,0 +1,263 @@
+#ifndef HARNESS_TABLE_DATASET_H
+#define HARNESS_TABLE_DATASET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "writer/tsfile_table_writer.h"
+
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#include "harness/data_generator.h"
+
+/**
+ * 表模型性能测试数据集：按配置生成表结构并写入 tsfile，供写入和读取性能测试共用
+ */
+namespace harness {
+
+// 数据集配置
+struct TableDatasetConfig {
+    std::string table_name = "bench_table";
+    int64_t rows = 1000000;                  // 写入总行数
+    int64_t tablet_rows = 1024;              // 每个 tablet 的行数
+    int64_t tag_count = 2;                   // TAG 列数量
+    int64_t field_count = 10;                // FIELD 列数量
+    std::string type_name = "INT64";         // FIELD 列数据类型，MIXED 表示多种类型轮换
+    int64_t tag_cardinality = 100;           // 设备数量（TAG 组合的基数）
+    uint64_t memory_threshold = 128 * 1024 * 1024;  // 写入器缓存阈值
+    std::string field_shape = "ROW";         // FIELD 列的数据形态，见 data_generator.h
+    double null_rate = 0;                    // FIELD 列空值比例（0-1）
+    uint64_t seed = 42;                      // 数据生成器的随机种子
+};
+
+// 写入耗时统计
+struct TableDatasetStats {
+    double fill_s = 0;         // 构造 tablet 耗时
+    double write_s = 0;        // write_table 耗时
+    double flush_close_s = 0;  // flush + close 耗时
+    uint64_t file_bytes = 0;   // 文件大小
+    // 内存分配（可执行文件未定义 harness/alloc_counter.h 的替换函数时为 0）
+    AllocStats write_allocs;        // write_table 的分配，不含构造 tablet（不含峰值）
+    AllocStats flush_close_allocs;  // flush + close 的分配
+    uint64_t peak_live_bytes = 0;   // 写入期间堆内存占用峰值高出开始时的部分（含 tablet）
+};
+
+// 数据集表结构
+struct TableDatasetSchema {
+    std::vector<std::string> column_names;
+    std::vector<common::TSDataType> data_types;
+    std::vector<common::ColumnCategory> column_categories;
+    std::vector<common::ColumnSchema> column_schemas;
+};
+
+// 生成 FIELD 列的数据类型
+inline std::vector<common::TSDataType> dataset_field_types(const TableDatasetConfig& config) {
+    const std::vector<common::TSDataType> mixed = {
+        common::TSDataType::INT64,  common::TSDataType::INT32,
+        common::TSDataType::FLOAT,  common::TSDataType::DOUBLE,
+        common::TSDataType::BOOLEAN, common::TSDataType::STRING,
+    };
+    common::TSDataType single = string_to_datatype(config.type_name);
+    std::vector<common::TSDataType> types;
+    for (int64_t i = 0; i < config.field_count; i++) {
+        types.push_back(config.type_name == "MIXED" ? mixed[i % mixed.size()] : single);
+    }
+    return types;
+}
+
+// 生成表结构：TAG 列命名为 tag0..tagN，FIELD 列命名为 s0..sN
+inline TableDatasetSchema dataset_schema(const TableDatasetConfig& config) {
+    TableDatasetSchema schema;
+    std::vector<common::TSDataType> field_types = dataset_field_types(config);
+    for (int64_t i = 0; i < config.tag_count; i++) {
+        schema.column_names.push_back("tag" + std::to_string(i));
+        schema.data_types.push_back(common::TSDataType::STRING);
+        schema.column_categories.push_back(common::ColumnCategory::TAG);
+    }
+    for (int64_t i = 0; i < config.field_count; i++) {
+        schema.column_names.push_back("s" + std::to_string(i));
+        schema.data_types.push_back(field_types[i]);
+        schema.column_categories.push_back(common::ColumnCategory::FIELD);
+    }
+    for (size_t i = 0; i < schema.column_names.size(); i++) {
+        schema.column_schemas.emplace_back(schema.column_names[i], schema.data_types[i],
+                                           schema.column_categories[i]);
+    }
+    return schema;
+}
+
+// 每个设备连续写入的行数：每个 tablet 内按设备分块
+inline int64_t dataset_block_rows(const TableDatasetConfig& config) {
+    int64_t cardinality = std::max<int64_t>(1, config.tag_cardinality);
+    return std::max<int64_t>(1, config.tablet_rows / std::min(cardinality, config.tablet_rows));
+}
+
+// 第 i 行所属的设备编号
+inline int64_t dataset_device(const TableDatasetConfig& config, int64_t i) {
+    return (i / dataset_block_rows(config)) % std::max<int64_t>(1, config.tag_cardinality);
+}
+
+// 第 i 行的时间戳：设备内单调递增，所有设备共享同一时间区间
+inline int64_t dataset_timestamp(const TableDatasetConfig& config, int64_t i) {
+    int64_t block = dataset_block_rows(config);
+    int64_t cardinality = std::max<int64_t>(1, config.tag_cardinality);
+    return (i / block / cardinality) * block + (i % block);
+}
+
+// 按数据类型向 tablet 写入一个值
+inline int dataset_fill_value(storage::Tablet& tablet, uint32_t row, uint32_t col,
+                              common::TSDataType type, int64_t value, int64_t timestamp,
+                              const std::vector<std::string>& text_pool) {
+    switch (type) {
+        case common::TSDataType::INT64:
+            return tablet.add_value(row, col, value);
+        case common::TSDataType::INT32:
+        case common::TSDataType::DATE:
+            return tablet.add_value(row, col, static_cast<int32_t>(value));
+        case common::TSDataType::FLOAT:
+            return tablet.add_value(row, col, static_cast<float>(value) * 0.5f);
+        case common::TSDataType::DOUBLE:
+            return tablet.add_value(row, col, static_cast<double>(value) * 0.5);
+        case common::TSDataType::BOOLEAN:
+            return tablet.add_value(row, col, value % 2 == 0);
+        case common::TSDataType::TIMESTAMP:
+            return tablet.add_value(row, col, timestamp);
+        case common::TSDataType::TEXT:
+        case common::TSDataType::STRING:
+        case common::TSDataType::BLOB:
+            return tablet.add_value(row, col, text_pool[value % text_pool.size()].c_str());
+        default:
+            return -1;
+    }
+}
+
+/**
+ * 预先生成的 TAG 值和字符串值，避免计入构造字符串的开销；
+ * FIELD 列不是 ROW 形态或含空值时，每个 FIELD 列使用一个 ColumnGenerator 按行顺序生成
+ */
+struct DatasetValuePool {
+    std::vector<std::vector<std::string>> tag_values;  // 设备 -> TAG 列 -> 值
+    std::vector<std::string> text_pool;
+    std::vector<ColumnGenerator> field_generators;
+};
+
+inline DatasetValuePool dataset_value_pool(const TableDatasetConfig& config) {
+    DatasetValuePool pool;
+    int64_t cardinality = std::max<int64_t>(1, config.tag_cardinality);
+    pool.tag_values.resize(cardinality);
+    for (int64_t d = 0; d < cardinality; d++) {
+        for (int64_t t = 0; t < config.tag_count; t++) {
+            pool.tag_values[d].push_back("tag" + std::to_string(t) + "_" + std::to_string(d));
+        }
+    }
+    for (int i = 0; i < 16; i++) {
+        pool.text_pool.push_back("value_" + std::to_string(i));
+    }
+    ColumnGenSpec spec;
+    if (!string_to_shape(config.field_shape, spec.shape)) {
+        spec.shape = ValueShape::ROW;
+    }
+    spec.null_rate = config.null_rate;
+    if (spec.shape != ValueShape::ROW || spec.null_rate > 0) {
+        std::vector<common::TSDataType> field_types = dataset_field_types(config);
+        SplitMix64 seeds(config.seed);
+        for (common::TSDataType type : field_types) {
+            pool.field_generators.emplace_back(type, spec, seeds.next());
+        }
+    }
+    return pool;
+}
+
+/**
+ * 把数据集第 [start, start + rows) 行写入 tablet 的第 [0, rows) 行
+ * field_types 为 dataset_field_types(config) 的结果；使用生成器时需按行顺序依次调用
+ */
+inline int dataset_fill_tablet(storage::Tablet& tablet, const TableDatasetConfig& config,
+                               DatasetValuePool& pool,
+                               const std::vector<common::TSDataType>& field_types, int64_t start,
+                               int64_t rows) {
+    int ret = common::E_OK;
+    for (int64_t r = 0; r < rows && ret == common::E_OK; r++) {
+        int64_t i = start + r;
+        int64_t device = dataset_device(config, i);
+        int64_t timestamp = dataset_timestamp(config, i);
+        uint32_t row = static_cast<uint32_t>(r);
+        ret = tablet.add_timestamp(row, timestamp);
+        for (int64_t t = 0; t < config.tag_count && ret == common::E_OK; t++) {
+            ret = tablet.add_value(row, static_cast<uint32_t>(t), pool.tag_values[device][t].c_str());
+        }
+        for (int64_t f = 0; f < config.field_count && ret == common::E_OK; f++) {
+            uint32_t col = static_cast<uint32_t>(config.tag_count + f);
+            ret = pool.field_generators.empty()
+                      ? dataset_fill_value(tablet, row, col, field_types[f], i + f, timestamp,
+                                           pool.text_pool)
+                      : pool.field_generators[f].fill(tablet, row, col);
+        }
+    }
+    return ret;
+}
+
+/**
+ * 按配置写入数据集到指定文件，返回错误码（E_OK 表示成功）
+ */
+inline int write_table_dataset(const std::string& file_path, const TableDatasetConfig& config,
+                               TableDatasetStats& stats) {
+    TableDatasetSchema dataset = dataset_schema(config);
+    std::vector<common::TSDataType> field_types = dataset_field_types(config);
+    int64_t tablet_rows = std::max<int64_t>(1, config.tablet_rows);
+    DatasetValuePool pool = dataset_value_pool(config);
+
+    storage::WriteFile file;
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    mode_t mode = 0666;
+    int ret = file.create(file_path, flags, mode);
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    auto* schema = new storage::TableSchema(config.table_name, dataset.column_schemas);
+    auto* writer = new storage::TsFileTableWriter(&file, schema, config.memory_threshold);
+
+    AllocScope alloc_scope;
+    Stopwatch watch;
+    for (int64_t start = 0; start < config.rows && ret == common::E_OK; start += tablet_rows) {
+        int64_t batch_rows = std::min(tablet_rows, config.rows - start);
+        watch.reset();
+        storage::Tablet tablet(config.table_name, dataset.column_names, dataset.data_types,
+                               dataset.column_categories, static_cast<int>(batch_rows));
+        ret = dataset_fill_tablet(tablet, config, pool, field_types, start, batch_rows);
+        stats.fill_s += watch.elapsed_s();
+        if (ret != common::E_OK) {
+            break;
+        }
+        AllocStats alloc_before = AllocCounter::snapshot();
+        watch.reset();
+        ret = writer->write_table(tablet);
+        stats.write_s += watch.elapsed_s();
+        stats.write_allocs.add(AllocCounter::snapshot().since(alloc_before));
+    }
+    if (ret == common::E_OK) {
+        AllocScope flush_scope;
+        watch.reset();
+        ret = writer->flush();
+        if (ret == common::E_OK) {
+            ret = writer->close();
+        }
+        stats.flush_close_s = watch.elapsed_s();
+        stats.flush_close_allocs = flush_scope.stats();
+    }
+    stats.peak_live_bytes = alloc_scope.stats().peak_live_bytes;
+    delete writer;
+    delete schema;
+    stats.file_bytes = file_size_bytes(file_path);
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TABLE_DATASET_H
@@ -0,0 +1,514 @@
+#ifndef HARNESS_TABLE_EXPORT_H
+#define HARNESS_TABLE_EXPORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "reader/filter/tag_filter.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+
+/**
+ * 表模型导出：把 tsfile 中的一个或多个表导出为 CSV 或按列存储的二进制格式。
+ * 导出拆分为任务，多个工作线程并行执行，每个工作线程打开一个读取器并在任务之间复用（见 parallel_scan.h）：
+ *   - TABLE 模式：每个表一个任务，输出 <output_dir>/<table>.<ext>；
+ *   - DEVICE 模式：每个表的设备按 devices_per_task 个一组，每组一个任务，
+ *     以 TAG 列等值条件的 OR 下推给读取器，输出 <output_dir>/<table>.part-NNNNN.<ext>。
+ * 每个任务按 ColumnBatch 批量读取，整批格式化到输出缓冲区（数值使用 std::to_chars，不经过 iostream），
+ * 缓冲区超过 buffer_bytes 时写入文件；内存占用约为 线程数 × (一批数据 + buffer_bytes)，与文件大小无关。
+ *
+ * CSV：第一行为表头（time 和各列名），空值为空字段，字符串含分隔符、引号或换行时用双引号包围，
+ * BOOLEAN 为 true / false，DATE 为 YYYY-MM-DD，BLOB 为 0x 开头的十六进制。
+ *
+ * 按列二进制格式（扩展名 .tscb，整数均为小端）：
+ *   文件头：魔数 "TSCB"、uint32 版本（1）、uint32 列数，每列 uint8 类型、uint32 名称长度、名称
+ *   每批：uint32 行数，之后按列依次为空值位图（(行数 + 7) / 8 字节，1 表示空值）和值：
+ *         定长列为 行数 × 宽度 字节（空值位置的内容未定义），变长列为 (行数 + 1) 个 int32 偏移和字节区
+ * 布局与 ColumnBatch（以及 Arrow 的定长列、变长列）相同，读取方可以整块复制。
+ */
+namespace harness {
+
+// 表或列不存在、设备的 TAG 值无法转换为条件、输出文件无法写入
+constexpr int kTableExportError = -103;
+
+enum class ExportFormat { CSV, COLUMNAR };
+enum class ExportPartition { TABLE, DEVICE };
+
+inline const char* export_format_extension(ExportFormat format) {
+    return format == ExportFormat::CSV ? "csv" : "tscb";
+}
+
+// 名称转换为 ExportFormat（csv / columnar），无法识别时返回 false
+inline bool string_to_export_format(const std::string& name, ExportFormat& format) {
+    if (name == "csv") {
+        format = ExportFormat::CSV;
+    } else if (name == "columnar") {
+        format = ExportFormat::COLUMNAR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 名称转换为 ExportPartition（table / device），无法识别时返回 false
+inline bool string_to_export_partition(const std::string& name, ExportPartition& partition) {
+    if (name == "table") {
+        partition = ExportPartition::TABLE;
+    } else if (name == "device") {
+        partition = ExportPartition::DEVICE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+struct TableExportConfig {
+    std::vector<std::string> tables;        // 导出的表，为空时导出全部表
+    ExportFormat format = ExportFormat::CSV;
+    ExportPartition partition = ExportPartition::TABLE;
+    int threads = 0;                        // 工作线程数，0 表示 CPU 核数
+    uint32_t batch_rows = 4096;             // 每批读取的行数
+    size_t buffer_bytes = 1024 * 1024;      // 输出缓冲区大小
+    int64_t devices_per_task = 64;          // DEVICE 模式每个任务的设备数
+    char delimiter = ',';
+};
+
+// 一个导出任务：一个表（DEVICE 模式下为其中一组设备）写入一个文件
+struct ExportTask {
+    std::string table_name;
+    std::vector<std::string> columns;                // 查询的列（不含时间列）
+    std::vector<std::string> tag_columns;            // DEVICE 模式：TAG 列名
+    std::vector<std::vector<std::string>> devices;   // DEVICE 模式：每个设备的 TAG 值
+    std::string output_path;
+};
+
+// 导出统计，耗时为各工作线程之和
+struct TableExportStats {
+    int64_t tables = 0;
+    int64_t tasks = 0;
+    int64_t rows = 0;
+    uint64_t output_bytes = 0;
+    double total_s = 0;       // 列出表和设备到写完最后一个文件
+    double read_s = 0;        // 打开读取器、查询和 next_batch
+    double format_s = 0;
+    double write_s = 0;
+    int threads = 0;
+};
+
+// 追加整数或浮点数的文本（std::to_chars，浮点数为能精确还原的最短表示）
+template <typename T>
+inline void append_number(std::string& out, T value) {
+    char buf[64];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+// 追加 CSV 字段：含分隔符、引号或换行时用双引号包围，引号写为两个引号
+inline void append_csv_text(std::string& out, std::string_view text, char delimiter) {
+    bool quote = false;
+    for (char c : text) {
+        if (c == delimiter || c == '"' || c == '\n' || c == '\r') {
+            quote = true;
+            break;
+        }
+    }
+    if (!quote) {
+        out.append(text.data(), text.size());
+        return;
+    }
+    out.push_back('"');
+    for (char c : text) {
+        if (c == '"') {
+            out.push_back('"');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+// 追加 0x 开头的十六进制
+inline void append_hex(std::string& out, std::string_view bytes) {
+    static const char digits[] = "0123456789abcdef";
+    out += "0x";
+    for (unsigned char c : bytes) {
+        out.push_back(digits[c >> 4]);
+        out.push_back(digits[c & 15]);
+    }
+}
+
+// yyyyMMdd 整数追加为 YYYY-MM-DD
+inline void append_date(std::string& out, int32_t value) {
+    char buf[16];
+    int n = std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d", value / 10000, value / 100 % 100,
+                          value % 100);
+    out.append(buf, n);
+}
+
+// CSV 表头
+inline void format_csv_header(const std::vector<std::string>& columns, char delimiter,
+                              std::string& out) {
+    out += "time";
+    for (const std::string& column : columns) {
+        out.push_back(delimiter);
+        append_csv_text(out, column, delimiter);
+    }
+    out.push_back('\n');
+}
+
+// 追加一个单元格（非空值）
+inline void append_csv_value(std::string& out, const ColumnBatch& batch, uint32_t column,
+                             uint32_t row, char delimiter) {
+    switch (batch.column_type(column)) {
+        case common::BOOLEAN:
+            out += batch.values<bool>(column)[row] ? "true" : "false";
+            break;
+        case common::INT32:
+            append_number(out, batch.values<int32_t>(column)[row]);
+            break;
+        case common::DATE:
+            append_date(out, batch.values<int32_t>(column)[row]);
+            break;
+        case common::INT64:
+        case common::TIMESTAMP:
+            append_number(out, batch.values<int64_t>(column)[row]);
+            break;
+        case common::FLOAT:
+            append_number(out, batch.values<float>(column)[row]);
+            break;
+        case common::DOUBLE:
+            append_number(out, batch.values<double>(column)[row]);
+            break;
+        case common::BLOB:
+            append_hex(out, batch.string_value(column, row));
+            break;
+        default:
+            append_csv_text(out, batch.string_value(column, row), delimiter);
+            break;
+    }
+}
+
+// 把一批数据格式化为 CSV 行（第 1 列为时间列）
+inline void format_csv_batch(const ColumnBatch& batch, char delimiter, std::string& out) {
+    for (uint32_t row = 0; row < batch.row_count(); row++) {
+        append_number(out, batch.values<int64_t>(1)[row]);
+        for (uint32_t column = 2; column <= batch.column_count(); column++) {
+            out.push_back(delimiter);
+            if (!batch.is_null(column, row)) {
+                append_csv_value(out, batch, column, row, delimiter);
+            }
+        }
+        out.push_back('\n');
+    }
+}
+
+template <typename T>
+inline void append_binary(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// 按列二进制格式的文件头，columns 和 types 均含时间列
+inline void format_columnar_header(const std::vector<std::string>& columns,
+                                   const std::vector<common::TSDataType>& types,
+                                   std::string& out) {
+    out += "TSCB";
+    append_binary<uint32_t>(out, 1);
+    append_binary<uint32_t>(out, static_cast<uint32_t>(columns.size()));
+    for (size_t i = 0; i < columns.size(); i++) {
+        append_binary<uint8_t>(out, static_cast<uint8_t>(types[i]));
+        append_binary<uint32_t>(out, static_cast<uint32_t>(columns[i].size()));
+        out += columns[i];
+    }
+}
+
+// 按列二进制格式的一批
+inline void format_columnar_batch(const ColumnBatch& batch, std::string& out) {
+    uint32_t rows = batch.row_count();
+    append_binary<uint32_t>(out, rows);
+    for (uint32_t column = 1; column <= batch.column_count(); column++) {
+        const uint8_t* nulls = batch.null_bitmap(column);
+        out.append(reinterpret_cast<const char*>(nulls), (rows + 7) / 8);
+        uint32_t width = ColumnBatch::value_width(batch.column_type(column));
+        if (width > 0) {
+            out.append(batch.values<char>(column), static_cast<size_t>(rows) * width);
+        } else {
+            const int32_t* offsets = batch.string_offsets(column);
+            out.append(reinterpret_cast<const char*>(offsets), (rows + 1) * sizeof(int32_t));
+            out.append(batch.string_data(column), static_cast<size_t>(offsets[rows]));
+        }
+    }
+}
+
+class TableExporter {
+   public:
+    TableExporter(const std::string& file_path, const TableExportConfig& config)
+        : file_path_(file_path), config_(config) {}
+
+    // 最近一次出错的说明
+    const std::string& error() const { return error_; }
+
+    /**
+     * 按配置列出导出任务（打开文件读取表结构和设备列表），输出文件位于 output_dir
+     * 返回错误码（E_OK 表示成功）
+     */
+    int plan(const std::string& output_dir, std::vector<ExportTask>& tasks) {
+        tasks.clear();
+        storage::TsFileReader reader;
+        int ret = reader.open(file_path_);
+        if (ret != common::E_OK) {
+            error_ = "cannot open " + file_path_;
+            return ret;
+        }
+        std::vector<std::string> tables = config_.tables;
+        if (tables.empty()) {
+            for (const auto& schema : reader.get_all_table_schemas()) {
+                tables.push_back(schema->get_table_name());
+            }
+        }
+        const char* extension = export_format_extension(config_.format);
+        for (const std::string& table_name : tables) {
+            std::shared_ptr<storage::TableSchema> schema = reader.get_table_schema(table_name);
+            if (schema == nullptr) {
+                error_ = "table not found: " + table_name;
+                ret = kTableExportError;
+                break;
+            }
+            ExportTask task;
+            task.table_name = table_name;
+            task.columns = schema->get_measurement_names();
+            if (config_.partition == ExportPartition::TABLE) {
+                task.output_path = output_dir + "/" + table_name + "." + extension;
+                tasks.push_back(task);
+                continue;
+            }
+            std::vector<common::ColumnCategory> categories = schema->get_column_categories();
+            for (size_t i = 0; i < task.columns.size() && i < categories.size(); i++) {
+                if (categories[i] == common::ColumnCategory::TAG) {
+                    task.tag_columns.push_back(task.columns[i]);
+                }
+            }
+            std::vector<std::vector<std::string>> devices;
+            if ((ret = list_devices(reader, table_name, task.tag_columns.size(), devices)) !=
+                common::E_OK) {
+                break;
+            }
+            size_t group = static_cast<size_t>(std::max<int64_t>(1, config_.devices_per_task));
+            for (size_t start = 0; start < devices.size(); start += group) {
+                ExportTask part = task;
+                part.devices.assign(devices.begin() + start,
+                                    devices.begin() + std::min(devices.size(), start + group));
+                char suffix[32];
+                std::snprintf(suffix, sizeof(suffix), ".part-%05zu.", start / group);
+                part.output_path = output_dir + "/" + table_name + suffix + extension;
+                tasks.push_back(std::move(part));
+            }
+        }
+        reader.close();
+        return ret;
+    }
+
+    /**
+     * 列出任务并由多个工作线程并行导出，返回第一个错误码（E_OK 表示全部成功）
+     */
+    int run(const std::string& output_dir, TableExportStats& stats) {
+        Stopwatch total;
+        stats = TableExportStats();
+        std::vector<ExportTask> tasks;
+        int ret = plan(output_dir, tasks);
+        if (ret != common::E_OK) {
+            return ret;
+        }
+        stats.tasks = static_cast<int64_t>(tasks.size());
+        for (size_t i = 0; i < tasks.size(); i++) {
+            stats.tables += i == 0 || tasks[i].table_name != tasks[i - 1].table_name ? 1 : 0;
+        }
+        int threads = config_.threads > 0
+                          ? config_.threads
+                          : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        stats.threads = std::max(1, std::min<int>(threads, static_cast<int>(tasks.size())));
+
+        std::atomic<size_t> next_task(0);
+        std::atomic<int> error(common::E_OK);
+        std::mutex mutex;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < stats.threads; t++) {
+            workers.emplace_back([&]() {
+                TableExportStats local;
+                storage::TsFileReader reader;
+                std::string message;
+                Stopwatch watch;
+                int code = reader.open(file_path_);
+                local.read_s += watch.elapsed_s();
+                if (code != common::E_OK) {
+                    message = "cannot open " + file_path_;
+                }
+                while (code == common::E_OK && error == common::E_OK) {
+                    size_t i = next_task++;
+                    if (i >= tasks.size()) {
+                        break;
+                    }
+                    code = export_task(reader, tasks[i], local, message);
+                }
+                reader.close();
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.rows += local.rows;
+                stats.output_bytes += local.output_bytes;
+                stats.read_s += local.read_s;
+                stats.format_s += local.format_s;
+                stats.write_s += local.write_s;
+                int expected = common::E_OK;
+                if (code != common::E_OK && error.compare_exchange_strong(expected, code)) {
+                    error_ = message;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        stats.total_s = total.elapsed_s();
+        return error;
+    }
+
+   private:
+    // 表的全部设备的 TAG 值；设备的 TAG 值个数与 TAG 列数不一致（含空值）时无法转换为等值条件
+    int list_devices(storage::TsFileReader& reader, const std::string& table_name, size_t tag_count,
+                     std::vector<std::vector<std::string>>& devices) {
+        for (const auto& device : reader.get_all_devices(table_name)) {
+            const std::vector<std::string*>& segments = device->get_segments();
+            std::vector<std::string> values;
+            for (size_t i = 1; i < segments.size(); i++) {
+                if (segments[i] == nullptr) {
+                    break;
+                }
+                values.push_back(*segments[i]);
+            }
+            if (values.size() != tag_count) {
+                error_ = "device " + device->get_device_name() +
+                         " has null tags, export it with the table partition";
+                return kTableExportError;
+            }
+            devices.push_back(std::move(values));
+        }
+        return common::E_OK;
+    }
+
+    // DEVICE 模式的过滤器：每个设备为各 TAG 列等值条件的 AND，设备之间为 OR
+    static storage::Filter* device_filter(storage::TableSchema* schema, const ExportTask& task) {
+        storage::TagFilterBuilder builder(schema);
+        storage::Filter* filter = nullptr;
+        for (const std::vector<std::string>& device : task.devices) {
+            storage::Filter* current = nullptr;
+            for (size_t i = 0; i < task.tag_columns.size(); i++) {
+                storage::Filter* eq = builder.eq(task.tag_columns[i], device[i]);
+                current = current == nullptr ? eq : storage::TagFilterBuilder::and_filter(current, eq);
+            }
+            if (current != nullptr) {
+                filter = filter == nullptr ? current
+                                           : storage::TagFilterBuilder::or_filter(filter, current);
+            }
+        }
+        return filter;
+    }
+
+    // 把缓冲区写入文件并清空
+    static bool write_buffer(std::FILE* out, std::string& buffer, TableExportStats& stats) {
+        Stopwatch watch;
+        bool ok = buffer.empty() || std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+        stats.write_s += watch.elapsed_s();
+        stats.output_bytes += buffer.size();
+        buffer.clear();
+        return ok;
+    }
+
+    int export_task(storage::TsFileReader& reader, const ExportTask& task, TableExportStats& stats,
+                    std::string& message) {
+        std::FILE* out = std::fopen(task.output_path.c_str(), "wb");
+        if (out == nullptr) {
+            message = "cannot create " + task.output_path;
+            return kTableExportError;
+        }
+        Stopwatch watch;
+        std::unique_ptr<storage::Filter> filter;
+        storage::ResultSet* temp_ret = nullptr;
+        int ret;
+        if (task.devices.empty()) {
+            ret = reader.query(task.table_name, task.columns, INT64_MIN, INT64_MAX, temp_ret);
+        } else {
+            std::shared_ptr<storage::TableSchema> schema = reader.get_table_schema(task.table_name);
+            filter.reset(device_filter(schema.get(), task));
+            ret = reader.query(task.table_name, task.columns, INT64_MIN, INT64_MAX, temp_ret,
+                               filter.get());
+        }
+        stats.read_s += watch.elapsed_s();
+        if (ret != common::E_OK) {
+            std::fclose(out);
+            message = "query " + task.table_name + " failed";
+            return ret;
+        }
+        auto* table_ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+        ColumnBatchReader batch_reader(table_ret);
+        ColumnBatch batch = batch_reader.create_batch(config_.batch_rows);
+        std::string buffer;
+        buffer.reserve(config_.buffer_bytes + 64 * 1024);
+        if (config_.format == ExportFormat::CSV) {
+            format_csv_header(task.columns, config_.delimiter, buffer);
+        } else {
+            std::vector<std::string> names = {"time"};
+            names.insert(names.end(), task.columns.begin(), task.columns.end());
+            format_columnar_header(names, batch_reader.column_types(), buffer);
+        }
+        bool written = true;
+        while (written) {
+            watch.reset();
+            ret = batch_reader.next_batch(batch);
+            stats.read_s += watch.elapsed_s();
+            if (ret != common::E_OK || batch.row_count() == 0) {
+                break;
+            }
+            watch.reset();
+            if (config_.format == ExportFormat::CSV) {
+                format_csv_batch(batch, config_.delimiter, buffer);
+            } else {
+                format_columnar_batch(batch, buffer);
+            }
+            stats.format_s += watch.elapsed_s();
+            stats.rows += batch.row_count();
+            if (buffer.size() >= config_.buffer_bytes) {
+                written = write_buffer(out, buffer, stats);
+            }
+        }
+        table_ret->close();
+        written = written && write_buffer(out, buffer, stats);
+        written = std::fclose(out) == 0 && written;
+        if (ret != common::E_OK) {
+            message = "read " + task.table_name + " failed";
+            return ret;
+        }
+        if (!written) {
+            message = "write " + task.output_path + " failed";
+            return kTableExportError;
+        }
+        return common::E_OK;
+    }
+
+    std::string file_path_;
+    TableExportConfig config_;
+    std::string error_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_TABLE_EXPORT_H
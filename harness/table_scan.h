@@ -0,0 +1,163 @@
+#ifndef HARNESS_TABLE_SCAN_H
+#define HARNESS_TABLE_SCAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+
+/**
+ * 表模型逐行读取：与测试用例 query_data_table 相同的 next + get_value<T>(i) 读取方式，
+ * 读取的值累加为校验和而不输出，用于读取性能测试的基准路径；
+ * 以及对 ColumnBatch 按列遍历的相同统计
+ */
+namespace harness {
+
+// 读取统计
+struct ScanStats {
+    int64_t rows = 0;           // 行数
+    int64_t cells = 0;          // 非时间列单元格数
+    int64_t null_cells = 0;     // 空值单元格数
+    uint64_t checksum = 0;      // 值的校验和，防止读取被优化掉
+    int64_t min_time = INT64_MAX;
+    int64_t max_time = INT64_MIN;
+    double first_row_s = 0;     // 从开始读取到取得第一行的耗时
+    double scan_s = 0;          // 读取全部行的耗时
+};
+
+// 将任意值按位累加到校验和
+template <typename T>
+inline void checksum_mix(uint64_t& checksum, T value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+    checksum = checksum * 31 + bits;
+}
+
+/**
+ * 逐行读取结果集中的全部数据，第 1 列为时间列（树模型按路径查询的结果集同样适用）
+ * watch 为调用方开始计时的计时器（通常在 query 调用之前启动），用于计算首行耗时
+ */
+inline int scan_table_rows(storage::ResultSet* ret, ScanStats& stats,
+                           const Stopwatch& watch) {
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    std::vector<common::TSDataType> types(column_count + 1);
+    for (uint32_t i = 1; i <= column_count; i++) {
+        types[i] = metadata->get_column_type(i);
+    }
+    bool has_next = false;
+    int code = common::E_OK;
+    while ((code = ret->next(has_next)) == common::E_OK && has_next) {
+        if (stats.rows == 0) {
+            stats.first_row_s = watch.elapsed_s();
+        }
+        int64_t timestamp = ret->get_value<int64_t>(1);
+        stats.min_time = std::min(stats.min_time, timestamp);
+        stats.max_time = std::max(stats.max_time, timestamp);
+        for (uint32_t i = 2; i <= column_count; i++) {
+            stats.cells++;
+            if (ret->is_null(i)) {
+                stats.null_cells++;
+                continue;
+            }
+            switch (types[i]) {
+                case common::DATE:
+                case common::INT32:
+                    checksum_mix(stats.checksum, ret->get_value<int32_t>(i));
+                    break;
+                case common::TIMESTAMP:
+                case common::INT64:
+                    checksum_mix(stats.checksum, ret->get_value<int64_t>(i));
+                    break;
+                case common::FLOAT:
+                    checksum_mix(stats.checksum, ret->get_value<float>(i));
+                    break;
+                case common::DOUBLE:
+                    checksum_mix(stats.checksum, ret->get_value<double>(i));
+                    break;
+                case common::BOOLEAN:
+                    checksum_mix(stats.checksum, ret->get_value<bool>(i));
+                    break;
+                case common::BLOB:
+                case common::TEXT:
+                case common::STRING:
+                    checksum_mix(stats.checksum,
+                                 string_view_of(ret->get_value<common::String*>(i)).size());
+                    break;
+                default:
+                    return -1;
+            }
+        }
+        stats.rows++;
+    }
+    stats.scan_s = watch.elapsed_s();
+    return code;
+}
+
+// 遍历一列定长值并累加校验和
+template <typename T>
+inline void scan_fixed_column(const ColumnBatch& batch, uint32_t column, ScanStats& stats) {
+    const T* values = batch.values<T>(column);
+    const uint8_t* nulls = batch.null_bitmap(column);
+    for (uint32_t r = 0; r < batch.row_count(); r++) {
+        if (!((nulls[r >> 3] >> (r & 7)) & 1)) {
+            checksum_mix(stats.checksum, values[r]);
+        }
+    }
+}
+
+// 按列遍历一批数据并累加校验和，类型分支在列级别而非单元格级别，第 1 列为时间列
+inline void scan_column_batch(const ColumnBatch& batch, ScanStats& stats) {
+    uint32_t rows = batch.row_count();
+    const int64_t* timestamps = batch.values<int64_t>(1);
+    for (uint32_t r = 0; r < rows; r++) {
+        stats.min_time = std::min(stats.min_time, timestamps[r]);
+        stats.max_time = std::max(stats.max_time, timestamps[r]);
+    }
+    for (uint32_t c = 1; c <= batch.column_count(); c++) {
+        switch (batch.column_type(c)) {
+            case common::DATE:
+            case common::INT32:
+                scan_fixed_column<int32_t>(batch, c, stats);
+                break;
+            case common::TIMESTAMP:
+            case common::INT64:
+                scan_fixed_column<int64_t>(batch, c, stats);
+                break;
+            case common::FLOAT:
+                scan_fixed_column<float>(batch, c, stats);
+                break;
+            case common::DOUBLE:
+                scan_fixed_column<double>(batch, c, stats);
+                break;
+            case common::BOOLEAN:
+                scan_fixed_column<bool>(batch, c, stats);
+                break;
+            default:
+                for (uint32_t r = 0; r < rows; r++) {
+                    if (!batch.is_null(c, r)) {
+                        checksum_mix(stats.checksum, batch.string_value(c, r).size());
+                    }
+                }
+                break;
+        }
+        if (c > 1) {
+            stats.cells += rows;
+            for (uint32_t r = 0; r < rows; r++) {
+                stats.null_cells += batch.is_null(c, r);
+            }
+        }
+    }
+    stats.rows += rows;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TABLE_SCAN_H
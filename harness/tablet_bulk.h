@@ -0,0 +1,135 @@
+#ifndef HARNESS_TABLET_BULK_H
+#define HARNESS_TABLET_BULK_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/tablet.h"
+
+/**
+ * Tablet 按列批量写入：按列下标（或预先解析的列句柄）一次写入一段连续的值，
+ * 可选空值位图；以及批量写入时间戳。
+ * 空值位图与 ColumnBatch::null_bitmap 的布局和含义相同（1 表示空值），按批读取的数据可以直接写回 tablet；
+ * 只有导出为 Arrow 时才取反为有效位图（见 harness/arrow_export.h）。
+ *
+ * Tablet 的存储由 tsfile 库管理，这里基于 add_value(row, schema_index, value) 实现，
+ * 避免 add_value(row, "column_name", value) 每个单元格按列名查找列。
+ */
+namespace harness {
+
+// 预先解析的列句柄
+struct ColumnHandle {
+    uint32_t index = 0;
+    common::TSDataType type = common::TSDataType::INVALID_DATATYPE;
+};
+
+// 按列名解析列句柄，列名与构造 Tablet 时的顺序一致
+class TabletColumnIndex {
+   public:
+    TabletColumnIndex(const std::vector<std::string>& column_names,
+                      const std::vector<common::TSDataType>& data_types) {
+        for (size_t i = 0; i < column_names.size(); i++) {
+            ColumnHandle handle;
+            handle.index = static_cast<uint32_t>(i);
+            handle.type = data_types[i];
+            handles_[column_names[i]] = handle;
+        }
+    }
+
+    // 列名不存在时返回 false
+    bool resolve(const std::string& column_name, ColumnHandle& handle) const {
+        auto it = handles_.find(column_name);
+        if (it == handles_.end()) {
+            return false;
+        }
+        handle = it->second;
+        return true;
+    }
+
+   private:
+    std::unordered_map<std::string, ColumnHandle> handles_;
+};
+
+// 空值位图：第 i 个值对应第 i / 8 个字节的第 i % 8 位，1 表示空值；位图为空表示全部有值
+inline bool bitmap_is_null(const uint8_t* null_bitmap, uint32_t i) {
+    return null_bitmap != nullptr && ((null_bitmap[i >> 3] >> (i & 7)) & 1);
+}
+
+/**
+ * 从 start_row 开始批量写入时间戳，返回错误码（E_OK 表示成功）
+ */
+inline int set_timestamps(storage::Tablet& tablet, uint32_t start_row, const int64_t* timestamps,
+                          uint32_t count) {
+    int ret = common::E_OK;
+    for (uint32_t i = 0; i < count && ret == common::E_OK; i++) {
+        ret = tablet.add_timestamp(start_row + i, timestamps[i]);
+    }
+    return ret;
+}
+
+/**
+ * 从 start_row 开始向第 column_index 列批量写入 count 个定长值，
+ * null_bitmap 为空表示全部有值；空值位置不写入，保持为空值
+ */
+template <typename T>
+inline int append_column(storage::Tablet& tablet, uint32_t column_index, uint32_t start_row,
+                         const T* values, uint32_t count, const uint8_t* null_bitmap = nullptr) {
+    int ret = common::E_OK;
+    if (null_bitmap == nullptr) {
+        for (uint32_t i = 0; i < count && ret == common::E_OK; i++) {
+            ret = tablet.add_value(start_row + i, column_index, values[i]);
+        }
+        return ret;
+    }
+    for (uint32_t i = 0; i < count && ret == common::E_OK; i++) {
+        if (!bitmap_is_null(null_bitmap, i)) {
+            ret = tablet.add_value(start_row + i, column_index, values[i]);
+        }
+    }
+    return ret;
+}
+
+// 变长列（STRING/TEXT/BLOB）批量写入
+inline int append_column(storage::Tablet& tablet, uint32_t column_index, uint32_t start_row,
+                         const std::string* values, uint32_t count,
+                         const uint8_t* null_bitmap = nullptr) {
+    int ret = common::E_OK;
+    for (uint32_t i = 0; i < count && ret == common::E_OK; i++) {
+        if (!bitmap_is_null(null_bitmap, i)) {
+            ret = tablet.add_value(start_row + i, column_index, values[i].c_str());
+        }
+    }
+    return ret;
+}
+
+/**
+ * 变长列按字节区和偏移数组批量写入（与 ColumnBatch::string_data / string_offsets 的布局相同），
+ * 第 i 个值为 [offsets[i], offsets[i + 1])；add_value 需要以 '\0' 结尾的字符串，每个值复制到复用的缓冲区
+ */
+inline int append_column(storage::Tablet& tablet, uint32_t column_index, uint32_t start_row,
+                         const char* data, const int32_t* offsets, uint32_t count,
+                         const uint8_t* null_bitmap = nullptr) {
+    int ret = common::E_OK;
+    std::string value;
+    for (uint32_t i = 0; i < count && ret == common::E_OK; i++) {
+        if (!bitmap_is_null(null_bitmap, i)) {
+            value.assign(data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+            ret = tablet.add_value(start_row + i, column_index, value.c_str());
+        }
+    }
+    return ret;
+}
+
+// 使用列句柄批量写入
+template <typename T>
+inline int append_column(storage::Tablet& tablet, const ColumnHandle& handle, uint32_t start_row,
+                         const T* values, uint32_t count, const uint8_t* null_bitmap = nullptr) {
+    return append_column(tablet, handle.index, start_row, values, count, null_bitmap);
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TABLET_BULK_H
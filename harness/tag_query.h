@@ -0,0 +1,282 @@
+#ifndef HARNESS_TAG_QUERY_H
+#define HARNESS_TAG_QUERY_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "reader/filter/tag_filter.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/bench_util.h"
+#include "harness/io_accounting.h"
+#include "harness/table_scan.h"
+
+/**
+ * 按 TAG 列条件查询表：TagPredicate 描述一个 TAG 列上的条件（等值、IN、前缀、正则），
+ * 多个条件之间为 AND，转换为 TagFilterBuilder 构造的过滤器传给 TsFileReader::query，
+ * 读取器按设备索引跳过不满足条件的设备，不读取这些设备的数据 chunk。
+ * 同时提供在客户端逐行判断条件的读取方式（全表扫描后过滤），作为对照和正确性校验。
+ *
+ * 正则条件的匹配方式由库决定，模式应以 ^ 和 $ 锚定，使客户端判断与库的结果一致；
+ * 前缀条件转换为 "^<转义后的前缀>.*"。
+ */
+namespace harness {
+
+// 查询的表不存在或条件中的列不是该表的列
+constexpr int kTagQueryError = -101;
+
+enum class TagMatch { EQ, IN, PREFIX, REGEX };
+
+// 一个 TAG 列上的条件
+struct TagPredicate {
+    TagMatch match = TagMatch::EQ;
+    std::string column;
+    std::vector<std::string> values;   // EQ / PREFIX / REGEX 只使用第一个值
+    mutable std::shared_ptr<const std::regex> compiled;   // 客户端判断时编译的正则表达式
+
+    static TagPredicate eq(const std::string& column, const std::string& value) {
+        return {TagMatch::EQ, column, {value}, nullptr};
+    }
+    static TagPredicate in(const std::string& column, const std::vector<std::string>& values) {
+        return {TagMatch::IN, column, values, nullptr};
+    }
+    static TagPredicate prefix(const std::string& column, const std::string& prefix) {
+        return {TagMatch::PREFIX, column, {prefix}, nullptr};
+    }
+    static TagPredicate regex(const std::string& column, const std::string& pattern) {
+        return {TagMatch::REGEX, column, {pattern}, nullptr};
+    }
+
+    // 客户端判断：value 是否满足条件
+    bool matches(std::string_view value) const {
+        switch (match) {
+            case TagMatch::EQ:
+                return !values.empty() && value == values[0];
+            case TagMatch::IN:
+                return std::find(values.begin(), values.end(), value) != values.end();
+            case TagMatch::PREFIX:
+                return !values.empty() && value.substr(0, values[0].size()) == values[0];
+            case TagMatch::REGEX:
+                if (values.empty()) {
+                    return false;
+                }
+                if (compiled == nullptr) {
+                    compiled = std::make_shared<const std::regex>(values[0]);
+                }
+                return std::regex_search(value.begin(), value.end(), *compiled);
+        }
+        return false;
+    }
+};
+
+// 所有条件都满足（空条件列表表示全部满足），predicates 和 values 一一对应
+inline bool tag_predicates_match(const std::vector<TagPredicate>& predicates,
+                                 const std::vector<std::string>& values) {
+    for (size_t i = 0; i < predicates.size(); i++) {
+        if (!predicates[i].matches(values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 转义正则表达式中的特殊字符
+inline std::string regex_escape(const std::string& text) {
+    static const std::string special = "\\^$.|?*+()[]{}";
+    std::string escaped;
+    for (char c : text) {
+        if (special.find(c) != std::string::npos) {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+/**
+ * 把条件列表转换为过滤器，条件之间为 AND，IN 转换为等值条件的 OR
+ * 无条件时 filter 为空；返回 kTagQueryError 表示条件中的列不存在或 IN 的取值为空
+ */
+inline int build_tag_filter(storage::TableSchema* schema,
+                            const std::vector<TagPredicate>& predicates,
+                            storage::Filter*& filter) {
+    filter = nullptr;
+    storage::TagFilterBuilder builder(schema);
+    for (const TagPredicate& predicate : predicates) {
+        if (predicate.values.empty() || schema->find_column_index(predicate.column) < 0) {
+            return kTagQueryError;
+        }
+        storage::Filter* current = nullptr;
+        switch (predicate.match) {
+            case TagMatch::EQ:
+                current = builder.eq(predicate.column, predicate.values[0]);
+                break;
+            case TagMatch::IN:
+                for (const std::string& value : predicate.values) {
+                    storage::Filter* eq = builder.eq(predicate.column, value);
+                    current = current == nullptr ? eq
+                                                 : storage::TagFilterBuilder::or_filter(current, eq);
+                }
+                break;
+            case TagMatch::PREFIX:
+                current = builder.reg_exp(predicate.column,
+                                          "^" + regex_escape(predicate.values[0]) + ".*");
+                break;
+            case TagMatch::REGEX:
+                current = builder.reg_exp(predicate.column, predicate.values[0]);
+                break;
+        }
+        filter = filter == nullptr ? current : storage::TagFilterBuilder::and_filter(filter, current);
+    }
+    return common::E_OK;
+}
+
+/**
+ * 带 TAG 条件查询：条件转换为过滤器后下推给读取器
+ * filter 持有过滤器，调用方在关闭结果集之后释放
+ */
+inline int query_with_tags(storage::TsFileReader& reader, const std::string& table_name,
+                           const std::vector<std::string>& columns, int64_t start_time,
+                           int64_t end_time, const std::vector<TagPredicate>& predicates,
+                           storage::ResultSet*& result, std::unique_ptr<storage::Filter>& filter) {
+    if (predicates.empty()) {
+        return reader.query(table_name, columns, start_time, end_time, result);
+    }
+    std::shared_ptr<storage::TableSchema> schema = reader.get_table_schema(table_name);
+    if (schema == nullptr) {
+        return kTagQueryError;
+    }
+    storage::Filter* tag_filter = nullptr;
+    int ret = build_tag_filter(schema.get(), predicates, tag_filter);
+    filter.reset(tag_filter);
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    return reader.query(table_name, columns, start_time, end_time, result, tag_filter);
+}
+
+// 列名比较（不区分大小写，库中的表模型列名不区分大小写）
+inline bool same_column_name(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+/**
+ * 客户端过滤：逐行读取结果集，只统计满足全部条件的行（行数、时间范围、非时间列单元格数）
+ * 条件中的列必须在查询的列中；返回 kTagQueryError 表示条件中的列不在结果集中
+ */
+inline int scan_table_rows_matching(storage::TableResultSet* ret,
+                                    const std::vector<TagPredicate>& predicates, ScanStats& stats,
+                                    const Stopwatch& watch) {
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    std::vector<uint32_t> predicate_columns;
+    for (const TagPredicate& predicate : predicates) {
+        uint32_t index = 0;
+        for (uint32_t i = 2; i <= column_count && index == 0; i++) {
+            if (same_column_name(metadata->get_column_name(i), predicate.column)) {
+                index = i;
+            }
+        }
+        if (index == 0) {
+            return kTagQueryError;
+        }
+        predicate_columns.push_back(index);
+    }
+    bool has_next = false;
+    int code = common::E_OK;
+    while ((code = ret->next(has_next)) == common::E_OK && has_next) {
+        bool matched = true;
+        for (size_t p = 0; p < predicates.size() && matched; p++) {
+            matched = !ret->is_null(predicate_columns[p]) &&
+                      predicates[p].matches(
+                          string_view_of(ret->get_value<common::String*>(predicate_columns[p])));
+        }
+        if (!matched) {
+            continue;
+        }
+        if (stats.rows == 0) {
+            stats.first_row_s = watch.elapsed_s();
+        }
+        int64_t timestamp = ret->get_value<int64_t>(1);
+        stats.min_time = std::min(stats.min_time, timestamp);
+        stats.max_time = std::max(stats.max_time, timestamp);
+        stats.cells += column_count - 1;
+        stats.rows++;
+    }
+    stats.scan_s = watch.elapsed_s();
+    return code;
+}
+
+// 一次带 TAG 条件查询的统计
+struct TagQueryResult {
+    double open_s = 0;
+    double query_s = 0;
+    double total_s = 0;   // 打开文件到读完最后一行
+    ScanStats scan;
+    IoReport io;          // 未定义 I/O 拦截函数或未启用统计时全为 0
+};
+
+/**
+ * 打开文件并按条件查询全部时间范围，读取全部结果
+ * pushdown 为 true 时条件下推给读取器，否则全表扫描后在客户端过滤（条件中的列须在 columns 中）
+ */
+inline int run_tag_query(const std::string& file_path, const std::string& table_name,
+                         const std::vector<std::string>& columns,
+                         const std::vector<TagPredicate>& predicates, bool pushdown,
+                         TagQueryResult& result) {
+    IoAccounting& accounting = IoAccounting::instance();
+    IoReport io_before = accounting.report();
+    Stopwatch total;
+    Stopwatch watch;
+    storage::TsFileReader reader;
+    int ret;
+    {
+        IoPhaseScope phase(IoPhase::OPEN);
+        ret = reader.open(file_path);
+    }
+    result.open_s = watch.elapsed_s();
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    storage::ResultSet* temp_ret = nullptr;
+    std::unique_ptr<storage::Filter> filter;
+    watch.reset();
+    {
+        IoPhaseScope phase(IoPhase::QUERY);
+        ret = query_with_tags(reader, table_name, columns, INT64_MIN, INT64_MAX,
+                              pushdown ? predicates : std::vector<TagPredicate>(), temp_ret, filter);
+    }
+    result.query_s = watch.elapsed_s();
+    auto* table_ret = ret == common::E_OK ? dynamic_cast<storage::TableResultSet*>(temp_ret) : nullptr;
+    if (table_ret != nullptr) {
+        IoPhaseScope phase(IoPhase::NEXT);
+        ret = pushdown ? scan_table_rows(table_ret, result.scan, watch)
+                       : scan_table_rows_matching(table_ret, predicates, result.scan, watch);
+    }
+    {
+        IoPhaseScope phase(IoPhase::CLOSE);
+        if (table_ret != nullptr) {
+            table_ret->close();
+        }
+        reader.close();
+    }
+    result.total_s = total.elapsed_s();
+    result.io = accounting.report().since(io_before);
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TAG_QUERY_H
@@ -0,0 +1,246 @@
+#ifndef HARNESS_TIME_WINDOW_H
+#define HARNESS_TIME_WINDOW_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "reader/tsfile_reader.h"
+#include "writer/tsfile_table_writer.h"
+
+#include "harness/bench_util.h"
+#include "harness/data_generator.h"
+#include "harness/io_accounting.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+/**
+ * 时间范围下推验证：按采集场景写入覆盖一段时间（默认一天）的数据，
+ * 所有设备按时间顺序写入，每写入 flush_interval 的数据 flush 一次（每个设备每段时间一个 chunk group），
+ * 然后在数据的开始、中间、结束位置执行窄时间窗口查询，统计耗时和读取的字节数，
+ * 用于验证 chunk / page 统计信息使读取器跳过时间窗口以外的数据。
+ */
+namespace harness {
+
+// 数据集配置（时间单位为毫秒）
+struct TimeSeriesDatasetConfig {
+    std::string table_name = "time_table";
+    int64_t devices = 100;                       // 设备数量，TAG 列 device 的取值为 device_<i>
+    int64_t field_count = 4;                     // FIELD 列数量，命名为 s0..sN
+    std::string type_name = "DOUBLE";            // FIELD 列数据类型，MIXED 表示多种类型轮换
+    std::string field_shape = "RANDOM_WALK";     // FIELD 列的数据形态，见 data_generator.h
+    int64_t start_time = 0;                      // 第一个点的时间戳
+    int64_t interval = 1000;                     // 每个设备的采样间隔
+    int64_t duration = 24LL * 3600 * 1000;       // 数据覆盖的时间长度
+    int64_t flush_interval = 3600LL * 1000;      // 每写入这么长时间的数据 flush 一次
+    int64_t tablet_rows = 1024;                  // 每个 tablet 的最大行数
+    uint64_t seed = 42;
+};
+
+// 每个设备的点数
+inline int64_t time_series_points(const TimeSeriesDatasetConfig& config) {
+    return std::max<int64_t>(1, config.duration / std::max<int64_t>(1, config.interval));
+}
+
+// 最后一个点的时间戳
+inline int64_t time_series_end_time(const TimeSeriesDatasetConfig& config) {
+    return config.start_time + (time_series_points(config) - 1) * config.interval;
+}
+
+inline TableDatasetSchema time_series_schema(const TimeSeriesDatasetConfig& config) {
+    TableDatasetConfig fields;
+    fields.tag_count = 0;
+    fields.field_count = config.field_count;
+    fields.type_name = config.type_name;
+    TableDatasetSchema schema = dataset_schema(fields);
+    schema.column_names.insert(schema.column_names.begin(), "device");
+    schema.data_types.insert(schema.data_types.begin(), common::TSDataType::STRING);
+    schema.column_categories.insert(schema.column_categories.begin(), common::ColumnCategory::TAG);
+    schema.column_schemas.insert(schema.column_schemas.begin(),
+                                 common::ColumnSchema("device", common::TSDataType::STRING,
+                                                      common::ColumnCategory::TAG));
+    return schema;
+}
+
+/**
+ * 写入数据集：按 flush_interval 划分时间段，每段内依次写入每个设备的数据后 flush
+ */
+inline int write_time_series_dataset(const std::string& file_path,
+                                     const TimeSeriesDatasetConfig& config,
+                                     TableDatasetStats& stats) {
+    TableDatasetSchema dataset = time_series_schema(config);
+    std::vector<common::TSDataType> field_types(dataset.data_types.begin() + 1,
+                                                dataset.data_types.end());
+    int64_t points = time_series_points(config);
+    int64_t interval = std::max<int64_t>(1, config.interval);
+    int64_t segment_points = std::max<int64_t>(1, config.flush_interval / interval);
+    int64_t tablet_rows = std::max<int64_t>(1, config.tablet_rows);
+
+    // 每个设备每个 FIELD 列一个生成器，设备之间使用不同的种子
+    ColumnGenSpec spec;
+    if (!string_to_shape(config.field_shape, spec.shape)) {
+        spec.shape = ValueShape::ROW;
+    }
+    std::vector<std::string> device_names;
+    std::vector<std::vector<ColumnGenerator>> generators(config.devices);
+    SplitMix64 seeds(config.seed);
+    for (int64_t d = 0; d < config.devices; d++) {
+        device_names.push_back("device_" + std::to_string(d));
+        for (common::TSDataType type : field_types) {
+            generators[d].emplace_back(type, spec, seeds.next());
+        }
+    }
+
+    storage::WriteFile file;
+    int ret = file.create(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    auto* schema = new storage::TableSchema(config.table_name, dataset.column_schemas);
+    auto* writer = new storage::TsFileTableWriter(&file, schema);
+
+    Stopwatch watch;
+    for (int64_t segment = 0; segment < points && ret == common::E_OK; segment += segment_points) {
+        int64_t segment_end = std::min(points, segment + segment_points);
+        for (int64_t d = 0; d < config.devices && ret == common::E_OK; d++) {
+            for (int64_t start = segment; start < segment_end && ret == common::E_OK;
+                 start += tablet_rows) {
+                int64_t rows = std::min(tablet_rows, segment_end - start);
+                watch.reset();
+                storage::Tablet tablet(config.table_name, dataset.column_names, dataset.data_types,
+                                       dataset.column_categories, static_cast<int>(rows));
+                for (int64_t r = 0; r < rows && ret == common::E_OK; r++) {
+                    uint32_t row = static_cast<uint32_t>(r);
+                    ret = tablet.add_timestamp(row, config.start_time + (start + r) * interval);
+                    if (ret == common::E_OK) {
+                        ret = tablet.add_value(row, 0, device_names[d].c_str());
+                    }
+                    for (size_t f = 0; f < field_types.size() && ret == common::E_OK; f++) {
+                        ret = generators[d][f].fill(tablet, row, static_cast<uint32_t>(f + 1));
+                    }
+                }
+                stats.fill_s += watch.elapsed_s();
+                if (ret != common::E_OK) {
+                    break;
+                }
+                watch.reset();
+                ret = writer->write_table(tablet);
+                stats.write_s += watch.elapsed_s();
+            }
+        }
+        if (ret == common::E_OK) {
+            watch.reset();
+            ret = writer->flush();
+            stats.flush_close_s += watch.elapsed_s();
+        }
+    }
+    if (ret == common::E_OK) {
+        watch.reset();
+        ret = writer->close();
+        stats.flush_close_s += watch.elapsed_s();
+    }
+    delete writer;
+    delete schema;
+    stats.file_bytes = file_size_bytes(file_path);
+    return ret;
+}
+
+/**
+ * 计算窗口位置对应的时间范围 [start, end]（闭区间，宽度为 width）：
+ *   start  —— 从第一个点开始
+ *   middle —— 以数据时间区间的中点为中心
+ *   end    —— 到最后一个点结束（例如"最近 5 分钟"）
+ *   before / after —— 完全位于数据之前 / 之后（不应读取任何数据）
+ * 无法识别的位置返回 false
+ */
+inline bool time_window(const TimeSeriesDatasetConfig& config, const std::string& position,
+                        int64_t width, int64_t& start, int64_t& end) {
+    width = std::max<int64_t>(1, width);
+    int64_t first = config.start_time;
+    int64_t last = time_series_end_time(config);
+    if (position == "start") {
+        start = first;
+    } else if (position == "middle") {
+        start = first + (last - first) / 2 - width / 2;
+    } else if (position == "end") {
+        start = last - width + 1;
+    } else if (position == "before") {
+        start = first - width;
+    } else if (position == "after") {
+        start = last + 1;
+    } else {
+        return false;
+    }
+    end = start + width - 1;
+    return true;
+}
+
+// 时间范围 [start, end] 内应读出的行数
+inline int64_t time_window_expected_rows(const TimeSeriesDatasetConfig& config, int64_t start,
+                                         int64_t end) {
+    int64_t interval = std::max<int64_t>(1, config.interval);
+    int64_t first = std::max<int64_t>(0, start - config.start_time + interval - 1) / interval;
+    int64_t last = std::min(time_series_points(config) - 1,
+                            end < config.start_time ? -1 : (end - config.start_time) / interval);
+    return last >= first ? (last - first + 1) * config.devices : 0;
+}
+
+// 一次窗口查询的统计
+struct WindowQueryResult {
+    double open_s = 0;
+    double query_s = 0;
+    double total_s = 0;   // 打开文件到读完最后一行
+    ScanStats scan;
+    IoReport io;          // 未定义 I/O 拦截函数或未启用统计时全为 0
+};
+
+// 打开文件、按时间范围查询并逐行读取全部结果，各步骤分别计入 I/O 统计的 open / query / next / close 阶段
+inline int run_window_query(const std::string& file_path, const std::string& table_name,
+                            const std::vector<std::string>& columns, int64_t start_time,
+                            int64_t end_time, WindowQueryResult& result) {
+    IoAccounting& accounting = IoAccounting::instance();
+    IoReport io_before = accounting.report();
+    Stopwatch total;
+    Stopwatch watch;
+    storage::TsFileReader reader;
+    int ret;
+    {
+        IoPhaseScope phase(IoPhase::OPEN);
+        ret = reader.open(file_path);
+    }
+    result.open_s = watch.elapsed_s();
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    storage::ResultSet* temp_ret = nullptr;
+    watch.reset();
+    {
+        IoPhaseScope phase(IoPhase::QUERY);
+        ret = reader.query(table_name, columns, start_time, end_time, temp_ret);
+    }
+    result.query_s = watch.elapsed_s();
+    auto* table_ret = ret == common::E_OK ? dynamic_cast<storage::TableResultSet*>(temp_ret) : nullptr;
+    if (table_ret != nullptr) {
+        IoPhaseScope phase(IoPhase::NEXT);
+        ret = scan_table_rows(table_ret, result.scan, watch);
+    }
+    {
+        IoPhaseScope phase(IoPhase::CLOSE);
+        if (table_ret != nullptr) {
+            table_ret->close();
+        }
+        reader.close();
+    }
+    result.total_s = total.elapsed_s();
+    result.io = accounting.report().since(io_before);
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TIME_WINDOW_H
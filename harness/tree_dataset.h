@@ -0,0 +1,303 @@
+#ifndef HARNESS_TREE_DATASET_H
+#define HARNESS_TREE_DATASET_H
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "common/tablet.h"
+#include "reader/tsfile_reader.h"
+#include "writer/tsfile_writer.h"
+
+#include "harness/alloc_counter.h"
+#include "harness/bench_util.h"
+#include "harness/table_dataset.h"
+#include "harness/table_scan.h"
+
+/**
+ * 树模型数据集：devices 个设备（root.db1.d0、root.db1.d1……），每个设备 measurements 个测点（s0、s1……），
+ * 每个设备写入 rows_per_device 行，时间戳为 0、1、2……（各设备相同）。
+ * 写入时先为所有设备注册全部时间序列，再按设备依次构造 tablet（一个 tablet 只属于一个设备，
+ * 超过 tablet_rows 行时拆分为多个）并调用 write_tablet，最后 flush 和 close。
+ * 测点的数据类型和取值与表模型数据集的 FIELD 列相同（见 table_dataset.h 的 dataset_field_types）。
+ *
+ * aligned 为 true 时每个设备以 register_aligned_timeseries 注册为对齐设备，以 write_tablet_aligned 写入：
+ * 同一设备的测点共用一个时间列（一个 time chunk 加每个测点一个 value chunk），
+ * 非对齐时每个测点各自保存时间戳。两种方式写入的数据相同，读取结果相同。
+ *
+ * 第 d 个设备第 m 个测点在时间戳 t 的取值为 d + v(t) + m：v(t) 默认为 t（取值随时间单调增长，
+ * chunk 和 page 的统计信息范围互不重叠）；scrambled 为 true 时 v 为 [0, rows_per_device) 上的一个
+ * 伪随机排列（取值集合不变，统计信息范围覆盖全部取值），用于比较值条件查询能否按统计信息跳过数据。
+ */
+namespace harness {
+
+struct TreeDatasetConfig {
+    std::string device_prefix = "root.db1.d";
+    int64_t devices = 100;            // 设备数量
+    int64_t measurements = 10;        // 每个设备的测点数量
+    int64_t rows_per_device = 100;    // 每个设备写入的行数
+    int64_t tablet_rows = 1024;       // 每个 tablet 的最大行数
+    std::string type_name = "INT64";  // 测点数据类型，MIXED 表示多种类型轮换
+    bool aligned = false;             // 对齐设备
+    bool scrambled = false;           // 取值为时间戳的伪随机排列，而不是随时间单调增长
+    int64_t flush_tablets = 0;        // 每写入该数量的 tablet 后 flush 一次，0 表示只在最后 flush
+};
+
+// 写入耗时和内存统计（未定义 harness/alloc_counter.h 的替换函数时分配统计为 0）
+struct TreeDatasetStats {
+    double register_s = 0;        // register_timeseries 耗时
+    double fill_s = 0;            // 构造 tablet 耗时
+    double write_s = 0;           // write_tablet 耗时
+    double flush_s = 0;           // 全部 flush 的耗时（含 flush_tablets 触发的 flush）
+    double close_s = 0;
+    uint64_t file_bytes = 0;
+    AllocStats register_allocs;   // 注册阶段的分配，live_bytes 为注册后堆内存的净增长
+    AllocStats write_allocs;      // write_tablet 的分配（不含构造 tablet），live_bytes 为写入器缓存的数据
+    AllocStats flush_close_allocs;
+    uint64_t peak_live_bytes = 0; // 注册到关闭期间堆内存占用峰值高出开始时的部分
+    long rss_growth_kb = 0;       // 同一期间进程峰值常驻内存高出开始时的部分（无法重置峰值时为 -1）
+
+    int64_t series(const TreeDatasetConfig& config) const {
+        return config.devices * config.measurements;
+    }
+    int64_t points(const TreeDatasetConfig& config) const {
+        return config.devices * config.rows_per_device * config.measurements;
+    }
+};
+
+inline std::string tree_device_id(const TreeDatasetConfig& config, int64_t device) {
+    return config.device_prefix + std::to_string(device);
+}
+
+// 设备的全部时间序列路径（device.s0、device.s1……）
+inline std::vector<std::string> tree_series_paths(const TreeDatasetConfig& config, int64_t device) {
+    std::vector<std::string> paths;
+    std::string device_id = tree_device_id(config, device);
+    for (int64_t m = 0; m < config.measurements; m++) {
+        paths.push_back(device_id + ".s" + std::to_string(m));
+    }
+    return paths;
+}
+
+// 测点的数据类型，与表模型数据集 FIELD 列的类型轮换方式相同
+inline std::vector<common::TSDataType> tree_measurement_types(const TreeDatasetConfig& config) {
+    TableDatasetConfig fields;
+    fields.field_count = config.measurements;
+    fields.type_name = config.type_name;
+    return dataset_field_types(fields);
+}
+
+// 所有设备共用的测点定义
+inline std::shared_ptr<std::vector<storage::MeasurementSchema>> tree_measurement_schemas(
+    const TreeDatasetConfig& config) {
+    std::vector<common::TSDataType> types = tree_measurement_types(config);
+    auto schemas = std::make_shared<std::vector<storage::MeasurementSchema>>();
+    for (int64_t m = 0; m < config.measurements; m++) {
+        schemas->emplace_back("s" + std::to_string(m), types[m]);
+    }
+    return schemas;
+}
+
+// scrambled 时使用的乘数：与 rows_per_device 互质，v(t) = t × 乘数 mod rows_per_device 为一个排列
+inline int64_t tree_scramble_multiplier(const TreeDatasetConfig& config) {
+    int64_t n = std::max<int64_t>(1, config.rows_per_device);
+    int64_t multiplier = 2654435761LL % n;
+    while (n > 1 && (multiplier == 0 || std::gcd(multiplier, n) != 1)) {
+        multiplier = (multiplier + 1) % n;
+    }
+    return multiplier;
+}
+
+// 时间戳对应的 v(t)，multiplier 为 tree_scramble_multiplier 的结果
+inline int64_t tree_value_base(const TreeDatasetConfig& config, int64_t multiplier,
+                               int64_t timestamp) {
+    if (!config.scrambled) {
+        return timestamp;
+    }
+    // 乘积可能超过 int64_t，按 128 位计算
+    return static_cast<int64_t>(static_cast<unsigned __int128>(timestamp) * multiplier %
+                                static_cast<uint64_t>(std::max<int64_t>(1, config.rows_per_device)));
+}
+
+// 第 d 个设备第 m 个测点在时间戳 timestamp 的取值（按测点类型转换前）
+inline int64_t tree_value(const TreeDatasetConfig& config, int64_t multiplier, int64_t device,
+                          int64_t measurement, int64_t timestamp) {
+    return device + tree_value_base(config, multiplier, timestamp) + measurement;
+}
+
+// 第 device 个设备第 [start, start + rows) 行写入 tablet 的第 [0, rows) 行
+inline int tree_fill_tablet(storage::Tablet& tablet, const TreeDatasetConfig& config,
+                            const std::vector<common::TSDataType>& types,
+                            const std::vector<std::string>& text_pool, int64_t device,
+                            int64_t start, int64_t rows) {
+    int64_t multiplier = tree_scramble_multiplier(config);
+    int ret = common::E_OK;
+    for (int64_t r = 0; r < rows && ret == common::E_OK; r++) {
+        uint32_t row = static_cast<uint32_t>(r);
+        int64_t timestamp = start + r;
+        ret = tablet.add_timestamp(row, timestamp);
+        int64_t base = tree_value(config, multiplier, device, 0, timestamp);
+        for (size_t m = 0; m < types.size() && ret == common::E_OK; m++) {
+            ret = dataset_fill_value(tablet, row, static_cast<uint32_t>(m), types[m],
+                                     base + static_cast<int64_t>(m), timestamp, text_pool);
+        }
+    }
+    return ret;
+}
+
+// 生成树模型数据集并写入 file_path，返回错误码（E_OK 表示成功）
+inline int write_tree_dataset(const std::string& file_path, const TreeDatasetConfig& config,
+                              TreeDatasetStats& stats) {
+    std::shared_ptr<std::vector<storage::MeasurementSchema>> schemas =
+        tree_measurement_schemas(config);
+    std::vector<common::TSDataType> types = tree_measurement_types(config);
+    std::vector<std::string> text_pool;
+    for (int i = 0; i < 16; i++) {
+        text_pool.push_back("value_" + std::to_string(i));
+    }
+    std::vector<std::string> device_ids;
+    for (int64_t d = 0; d < config.devices; d++) {
+        device_ids.push_back(tree_device_id(config, d));
+    }
+    int64_t tablet_rows = std::max<int64_t>(1, config.tablet_rows);
+    int64_t tablets = 0;
+
+    auto* writer = new storage::TsFileWriter();
+    int ret = writer->open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (ret != common::E_OK) {
+        delete writer;
+        return ret;
+    }
+    bool rss_reset = reset_peak_rss();
+    long rss_before = peak_rss_kb();
+    AllocScope alloc_scope;
+    Stopwatch watch;
+    {
+        AllocScope register_scope;
+        for (int64_t d = 0; d < config.devices && ret == common::E_OK; d++) {
+            if (config.aligned) {
+                // 对齐注册传入的测点定义由写入器持有并在关闭时释放
+                std::vector<storage::MeasurementSchema*> aligned_schemas;
+                for (const storage::MeasurementSchema& schema : *schemas) {
+                    aligned_schemas.push_back(new storage::MeasurementSchema(
+                        schema.measurement_name_, schema.data_type_));
+                }
+                ret = writer->register_aligned_timeseries(device_ids[d], aligned_schemas);
+                continue;
+            }
+            for (int64_t m = 0; m < config.measurements && ret == common::E_OK; m++) {
+                ret = writer->register_timeseries(device_ids[d], (*schemas)[m]);
+            }
+        }
+        stats.register_s = watch.elapsed_s();
+        stats.register_allocs = register_scope.stats();
+    }
+    for (int64_t d = 0; d < config.devices && ret == common::E_OK; d++) {
+        for (int64_t start = 0; start < config.rows_per_device && ret == common::E_OK;
+             start += tablet_rows) {
+            int64_t rows = std::min(tablet_rows, config.rows_per_device - start);
+            watch.reset();
+            storage::Tablet tablet(device_ids[d], schemas, static_cast<int>(rows));
+            ret = tree_fill_tablet(tablet, config, types, text_pool, d, start, rows);
+            stats.fill_s += watch.elapsed_s();
+            if (ret != common::E_OK) {
+                break;
+            }
+            AllocStats alloc_before = AllocCounter::snapshot();
+            watch.reset();
+            ret = config.aligned ? writer->write_tablet_aligned(tablet) : writer->write_tablet(tablet);
+            stats.write_s += watch.elapsed_s();
+            stats.write_allocs.add(AllocCounter::snapshot().since(alloc_before));
+            if (ret == common::E_OK && config.flush_tablets > 0 &&
+                ++tablets % config.flush_tablets == 0) {
+                watch.reset();
+                ret = writer->flush();
+                stats.flush_s += watch.elapsed_s();
+            }
+        }
+    }
+    if (ret == common::E_OK) {
+        AllocScope flush_scope;
+        watch.reset();
+        ret = writer->flush();
+        stats.flush_s += watch.elapsed_s();
+        if (ret == common::E_OK) {
+            watch.reset();
+            ret = writer->close();
+            stats.close_s = watch.elapsed_s();
+        }
+        stats.flush_close_allocs = flush_scope.stats();
+    }
+    stats.peak_live_bytes = alloc_scope.stats().peak_live_bytes;
+    long rss_after = peak_rss_kb();
+    stats.rss_growth_kb = rss_reset ? std::max(0L, rss_after - rss_before) : -1;
+    delete writer;
+    stats.file_bytes = file_size_bytes(file_path);
+    return ret;
+}
+
+// 按设备读取的统计
+struct TreeReadStats {
+    int64_t queries = 0;
+    double open_s = 0;
+    double query_s = 0;     // query 调用耗时之和
+    double scan_s = 0;      // 读取全部行的耗时之和
+    double total_s = 0;     // 打开文件到关闭
+    ScanStats scan;         // 全部查询的行数、单元格数和校验和之和
+};
+
+/**
+ * 打开文件，对 read_devices 个设备（在全部设备中均匀选取，0 表示全部）各执行一次查询，
+ * 每次查询该设备的前 read_measurements 个测点（0 表示全部）的全部时间范围并读取全部行
+ */
+inline int read_tree_dataset(const std::string& file_path, const TreeDatasetConfig& config,
+                             int64_t read_devices, int64_t read_measurements,
+                             TreeReadStats& stats) {
+    Stopwatch total;
+    storage::TsFileReader reader;
+    int ret = reader.open(file_path);
+    stats.open_s = total.elapsed_s();
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    int64_t devices = read_devices > 0 ? std::min(read_devices, config.devices) : config.devices;
+    int64_t measurements = read_measurements > 0
+                               ? std::min(read_measurements, config.measurements)
+                               : config.measurements;
+    for (int64_t i = 0; i < devices && ret == common::E_OK; i++) {
+        int64_t device = i * config.devices / devices;
+        std::vector<std::string> paths = tree_series_paths(config, device);
+        paths.resize(measurements);
+        storage::ResultSet* result_set = nullptr;
+        Stopwatch watch;
+        ret = reader.query(paths, INT64_MIN, INT64_MAX, result_set);
+        stats.query_s += watch.elapsed_s();
+        if (ret != common::E_OK) {
+            break;
+        }
+        ScanStats scan;
+        watch.reset();
+        ret = scan_table_rows(result_set, scan, watch);
+        stats.scan_s += scan.scan_s;
+        stats.scan.rows += scan.rows;
+        stats.scan.cells += scan.cells;
+        stats.scan.null_cells += scan.null_cells;
+        checksum_mix(stats.scan.checksum, scan.checksum);
+        reader.destroy_query_data_set(result_set);
+        stats.queries++;
+    }
+    reader.close();
+    stats.total_s = total.elapsed_s();
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_TREE_DATASET_H
@@ -0,0 +1,510 @@
+#ifndef HARNESS_TSFILE_LAYOUT_H
+#define HARNESS_TSFILE_LAYOUT_H
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+
+/**
+ * TsFile 物理结构解析：不依赖 tsfile 库的读取接口，直接按文件格式顺序解析
+ * chunk group、chunk、page 的头部，page 数据只跳过不读取，内存占用与文件大小无关。
+ *
+ * 文件结构（大端序，varint 为 7 位一组的变长整数）：
+ *   "TsFile" + 版本号（1 字节，3 或 4）
+ *   chunk group：标记 0 + 设备（版本 3 为字符串；版本 4 为 varint 段数 + 每段字符串）
+ *   chunk：标记 + 测点名 + 数据大小（varint）+ 数据类型 + 压缩方式 + 编码方式，随后为 page
+ *     标记 1 / 5：非对齐 chunk（多个 page / 只有一个 page）
+ *     标记 0x81 / 0x85：对齐时间列 chunk，标记 0x41 / 0x45：对齐值列 chunk
+ *   page：未压缩大小（varint）+ 压缩后大小（varint）+ 统计信息（多 page 的 chunk 才有）+ 数据，
+ *     对齐值列未压缩大小为 0 时表示全空的 page，之后没有其他字段
+ *   标记 4：写入操作的序号范围（2 个 int64）
+ *   标记 2：数据区结束，之后为索引区（TimeseriesMetadata 和 MetadataIndexNode）
+ *   文件尾：TsFileMetadata + TsFileMetadata 大小（int32）+ "TsFile"
+ *
+ * 字符串：zigzag varint 长度 + 内容（长度为 -1 表示 null）；统计信息中的二进制值为 int32 长度 + 内容。
+ * 统计信息的格式与数据类型相关，解析后 page 的结束位置与 chunk 数据大小不一致时，
+ * 认为该 chunk 的统计信息格式无法识别，跳过该 chunk 剩余的 page。
+ */
+namespace harness {
+
+// chunk 标记
+const uint8_t kChunkGroupHeaderMarker = 0;
+const uint8_t kChunkHeaderMarker = 1;
+const uint8_t kSeparatorMarker = 2;
+const uint8_t kOperationIndexRangeMarker = 4;
+const uint8_t kOnlyOnePageChunkHeaderMarker = 5;
+const uint8_t kTimeColumnMask = 0x80;
+const uint8_t kValueColumnMask = 0x40;
+
+// 统计信息（数值按文本输出，二进制值截断到 32 字节）
+struct LayoutStatistics {
+    bool present = false;
+    uint64_t count = 0;
+    int64_t start_time = 0;
+    int64_t end_time = 0;
+    std::string min_value;
+    std::string max_value;
+    std::string first_value;
+    std::string last_value;
+    std::string sum_value;
+};
+
+struct LayoutChunkGroup {
+    uint64_t offset = 0;
+    std::string device;       // 设备各段以 "." 连接
+    std::string table_name;   // 版本 4 为设备的第一段（表模型的表名）
+};
+
+struct LayoutChunk {
+    uint64_t offset = 0;
+    uint64_t header_size = 0;
+    uint64_t data_size = 0;          // page 头部和数据的总大小
+    uint8_t marker = 0;
+    std::string measurement;
+    uint8_t data_type = 0;
+    uint8_t compression = 0;
+    uint8_t encoding = 0;
+    bool aligned_time = false;
+    bool aligned_value = false;
+    bool single_page = false;
+    uint64_t page_count = 0;
+    uint64_t empty_pages = 0;
+    uint64_t uncompressed_bytes = 0;  // 全部 page 的未压缩大小
+    uint64_t compressed_bytes = 0;    // 全部 page 的压缩后大小
+    uint64_t point_count = 0;         // 多 page 的 chunk 为统计信息中的点数之和
+    bool pages_parsed = true;         // false 表示统计信息格式无法识别，page 未完整解析
+};
+
+struct LayoutPage {
+    uint64_t offset = 0;
+    uint64_t header_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint64_t compressed_size = 0;
+    bool empty = false;
+    LayoutStatistics statistics;
+};
+
+struct LayoutMetadata {
+    uint64_t file_size = 0;
+    uint64_t data_end = 0;          // 标记 2 的位置
+    uint64_t index_size = 0;        // TimeseriesMetadata + MetadataIndexNode
+    uint64_t tsfile_metadata_size = 0;
+    uint64_t tail_size = 10;        // TsFileMetadata 大小（4 字节）+ "TsFile"
+};
+
+// 解析过程中的回调，返回非 E_OK 时停止解析
+class LayoutVisitor {
+   public:
+    virtual ~LayoutVisitor() {}
+    virtual int on_chunk_group(const LayoutChunkGroup&) { return common::E_OK; }
+    virtual int on_page(const LayoutChunkGroup&, const LayoutChunk&, const LayoutPage&) {
+        return common::E_OK;
+    }
+    // chunk 的全部 page 解析完成后调用，page_count 等汇总字段已填充
+    virtual int on_chunk(const LayoutChunkGroup&, const LayoutChunk&) { return common::E_OK; }
+    virtual int on_metadata(const LayoutMetadata&) { return common::E_OK; }
+};
+
+class TsFileLayoutReader {
+   public:
+    // 解析错误码：文件格式不符合预期
+    static const int kFormatError = -100;
+
+    explicit TsFileLayoutReader(size_t buffer_size = 64 * 1024) : buffer_(buffer_size) {}
+
+    ~TsFileLayoutReader() { close(); }
+
+    int open(const std::string& path) {
+        close();
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            return -1;
+        }
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            return -1;
+        }
+        file_size_ = static_cast<uint64_t>(st.st_size);
+        pos_ = 0;
+        buffer_start_ = 0;
+        buffer_len_ = 0;
+        char magic[6];
+        if (!read_bytes(magic, 6) || std::memcmp(magic, "TsFile", 6) != 0 ||
+            !read_u8(version_)) {
+            return kFormatError;
+        }
+        return common::E_OK;
+    }
+
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    uint8_t version() const { return version_; }
+    uint64_t file_size() const { return file_size_; }
+    const std::string& error_message() const { return error_; }
+
+    // 从文件头之后顺序解析全部数据，依次回调 visitor
+    int scan(LayoutVisitor& visitor) {
+        LayoutChunkGroup group;
+        bool has_group = false;
+        uint64_t tail_start = file_size_ >= 10 ? file_size_ - 10 : 0;
+        while (pos_ < tail_start) {
+            uint64_t marker_offset = pos_;
+            uint8_t marker = 0;
+            if (!read_u8(marker)) {
+                return fail("unexpected end of file");
+            }
+            int ret = common::E_OK;
+            if (marker == kChunkGroupHeaderMarker) {
+                group = LayoutChunkGroup();
+                group.offset = marker_offset;
+                if (!read_device(group)) {
+                    return fail("invalid chunk group header");
+                }
+                has_group = true;
+                ret = visitor.on_chunk_group(group);
+            } else if (marker == kOperationIndexRangeMarker) {
+                if (!skip(16)) {
+                    return fail("invalid operation index range");
+                }
+            } else if (marker == kSeparatorMarker) {
+                return scan_metadata(marker_offset, visitor);
+            } else if (is_chunk_marker(marker)) {
+                if (!has_group) {
+                    return fail("chunk before chunk group header");
+                }
+                ret = scan_chunk(group, marker, marker_offset, visitor);
+            } else {
+                return fail("unknown marker " + std::to_string(marker) + " at offset " +
+                            std::to_string(marker_offset));
+            }
+            if (ret != common::E_OK) {
+                return ret;
+            }
+        }
+        return fail("separator marker not found");
+    }
+
+   private:
+    static bool is_chunk_marker(uint8_t marker) {
+        uint8_t base = marker & 0x3F;
+        uint8_t mask = marker & 0xC0;
+        return (base == kChunkHeaderMarker || base == kOnlyOnePageChunkHeaderMarker) &&
+               (mask == 0 || mask == kTimeColumnMask || mask == kValueColumnMask);
+    }
+
+    int scan_chunk(const LayoutChunkGroup& group, uint8_t marker, uint64_t offset,
+                   LayoutVisitor& visitor) {
+        LayoutChunk chunk;
+        chunk.offset = offset;
+        chunk.marker = marker;
+        chunk.aligned_time = (marker & kTimeColumnMask) != 0;
+        chunk.aligned_value = (marker & kValueColumnMask) != 0;
+        chunk.single_page = (marker & 0x3F) == kOnlyOnePageChunkHeaderMarker;
+        if (!read_string(chunk.measurement) || !read_var_uint(chunk.data_size) ||
+            !read_u8(chunk.data_type) || !read_u8(chunk.compression) ||
+            !read_u8(chunk.encoding)) {
+            return fail("invalid chunk header at offset " + std::to_string(offset));
+        }
+        chunk.header_size = pos_ - offset;
+        uint64_t data_end = pos_ + chunk.data_size;
+        if (data_end > file_size_) {
+            return fail("chunk data exceeds file size at offset " + std::to_string(offset));
+        }
+        while (pos_ < data_end) {
+            LayoutPage page;
+            page.offset = pos_;
+            bool ok = read_var_uint(page.uncompressed_size);
+            if (ok && page.uncompressed_size == 0 && chunk.aligned_value) {
+                page.empty = true;
+            } else if (ok) {
+                ok = read_var_uint(page.compressed_size);
+                if (ok && !chunk.single_page) {
+                    ok = read_statistics(chunk.data_type, page.statistics);
+                }
+            }
+            page.header_size = pos_ - page.offset;
+            if (!ok || pos_ + page.compressed_size > data_end) {
+                chunk.pages_parsed = false;
+                break;
+            }
+            skip(page.compressed_size);
+            chunk.page_count++;
+            chunk.empty_pages += page.empty ? 1 : 0;
+            chunk.uncompressed_bytes += page.uncompressed_size;
+            chunk.compressed_bytes += page.compressed_size;
+            chunk.point_count += page.statistics.count;
+            int ret = visitor.on_page(group, chunk, page);
+            if (ret != common::E_OK) {
+                return ret;
+            }
+        }
+        seek(data_end);
+        return visitor.on_chunk(group, chunk);
+    }
+
+    int scan_metadata(uint64_t separator_offset, LayoutVisitor& visitor) {
+        LayoutMetadata metadata;
+        metadata.file_size = file_size_;
+        metadata.data_end = separator_offset;
+        seek(file_size_ - 10);
+        int32_t tsfile_metadata_size = 0;
+        if (!read_i32(tsfile_metadata_size) || tsfile_metadata_size < 0 ||
+            static_cast<uint64_t>(tsfile_metadata_size) + 10 > file_size_ - separator_offset - 1) {
+            return fail("invalid file tail");
+        }
+        metadata.tsfile_metadata_size = static_cast<uint64_t>(tsfile_metadata_size);
+        metadata.index_size =
+            file_size_ - 10 - metadata.tsfile_metadata_size - separator_offset - 1;
+        return visitor.on_metadata(metadata);
+    }
+
+    bool read_device(LayoutChunkGroup& group) {
+        if (version_ <= 3) {
+            bool is_null = false;
+            if (!read_string(group.device, &is_null)) {
+                return false;
+            }
+            group.table_name = group.device.substr(0, group.device.find('.'));
+            return true;
+        }
+        uint64_t segments = 0;
+        if (!read_var_uint(segments) || segments > 1024) {
+            return false;
+        }
+        for (uint64_t i = 0; i < segments; i++) {
+            std::string segment;
+            bool is_null = false;
+            if (!read_string(segment, &is_null)) {
+                return false;
+            }
+            if (i == 0) {
+                group.table_name = segment;
+            }
+            group.device += (i == 0 ? "" : ".") + (is_null ? std::string("null") : segment);
+        }
+        return true;
+    }
+
+    bool read_statistics(uint8_t data_type, LayoutStatistics& stats) {
+        stats.present = true;
+        if (!read_var_uint(stats.count) || !read_i64(stats.start_time) ||
+            !read_i64(stats.end_time)) {
+            return false;
+        }
+        switch (data_type) {
+            case common::TSDataType::VECTOR:
+            case common::TSDataType::BLOB:
+                return true;
+            case common::TSDataType::BOOLEAN: {
+                uint8_t first = 0;
+                uint8_t last = 0;
+                int64_t sum = 0;
+                if (!read_u8(first) || !read_u8(last) || !read_i64(sum)) {
+                    return false;
+                }
+                stats.first_value = first ? "true" : "false";
+                stats.last_value = last ? "true" : "false";
+                stats.sum_value = std::to_string(sum);
+                return true;
+            }
+            case common::TSDataType::INT32:
+            case common::TSDataType::DATE:
+                return read_numeric_statistics<int32_t>(stats, false);
+            case common::TSDataType::INT64:
+            case common::TSDataType::TIMESTAMP:
+                return read_numeric_statistics<int64_t>(stats, true);
+            case common::TSDataType::FLOAT:
+                return read_numeric_statistics<float>(stats, true);
+            case common::TSDataType::DOUBLE:
+                return read_numeric_statistics<double>(stats, true);
+            case common::TSDataType::TEXT:
+                return read_binary(stats.first_value) && read_binary(stats.last_value);
+            case common::TSDataType::STRING:
+                return read_binary(stats.first_value) && read_binary(stats.last_value) &&
+                       read_binary(stats.min_value) && read_binary(stats.max_value);
+            default:
+                return false;
+        }
+    }
+
+    // min、max、first、last 各一个值，sum 为 int64（INT32）或 double（其他类型）
+    template <typename T>
+    bool read_numeric_statistics(LayoutStatistics& stats, bool double_sum) {
+        T values[4];
+        for (auto& value : values) {
+            if (!read_fixed(value)) {
+                return false;
+            }
+        }
+        stats.min_value = std::to_string(values[0]);
+        stats.max_value = std::to_string(values[1]);
+        stats.first_value = std::to_string(values[2]);
+        stats.last_value = std::to_string(values[3]);
+        if (double_sum) {
+            double sum = 0;
+            if (!read_fixed(sum)) {
+                return false;
+            }
+            stats.sum_value = std::to_string(sum);
+        } else {
+            int64_t sum = 0;
+            if (!read_fixed(sum)) {
+                return false;
+            }
+            stats.sum_value = std::to_string(sum);
+        }
+        return true;
+    }
+
+    // 大端序定长值
+    template <typename T>
+    bool read_fixed(T& value) {
+        uint8_t bytes[sizeof(T)];
+        if (!read_bytes(reinterpret_cast<char*>(bytes), sizeof(T))) {
+            return false;
+        }
+        uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bits = (bits << 8) | bytes[i];
+        }
+        if (sizeof(T) == 4) {
+            uint32_t narrow = static_cast<uint32_t>(bits);
+            std::memcpy(&value, &narrow, sizeof(T));
+        } else {
+            std::memcpy(&value, &bits, sizeof(T));
+        }
+        return true;
+    }
+
+    bool read_i32(int32_t& value) { return read_fixed(value); }
+    bool read_i64(int64_t& value) { return read_fixed(value); }
+
+    bool read_u8(uint8_t& value) { return read_bytes(reinterpret_cast<char*>(&value), 1); }
+
+    bool read_var_uint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!read_u8(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool read_var_int(int64_t& value) {
+        uint64_t raw = 0;
+        if (!read_var_uint(raw)) {
+            return false;
+        }
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return true;
+    }
+
+    // zigzag varint 长度 + 内容，长度为 -1 表示 null
+    bool read_string(std::string& value, bool* is_null = nullptr) {
+        int64_t length = 0;
+        if (!read_var_int(length) || length < -1 ||
+            static_cast<uint64_t>(length < 0 ? 0 : length) > file_size_ - pos_) {
+            return false;
+        }
+        if (is_null != nullptr) {
+            *is_null = length < 0;
+        }
+        value.assign(static_cast<size_t>(length < 0 ? 0 : length), '\0');
+        return length <= 0 || read_bytes(&value[0], static_cast<size_t>(length));
+    }
+
+    // int32 长度 + 内容，只保留前 32 字节
+    bool read_binary(std::string& value) {
+        int32_t length = 0;
+        if (!read_i32(length) || length < 0 || static_cast<uint64_t>(length) > file_size_ - pos_) {
+            return false;
+        }
+        size_t kept = std::min<size_t>(static_cast<size_t>(length), 32);
+        value.assign(kept, '\0');
+        if (kept > 0 && !read_bytes(&value[0], kept)) {
+            return false;
+        }
+        if (static_cast<size_t>(length) > kept) {
+            value += "...";
+            return skip(static_cast<size_t>(length) - kept);
+        }
+        return true;
+    }
+
+    bool read_bytes(char* out, size_t length) {
+        while (length > 0) {
+            if (pos_ < buffer_start_ || pos_ >= buffer_start_ + buffer_len_) {
+                if (!fill_buffer()) {
+                    return false;
+                }
+            }
+            size_t offset = static_cast<size_t>(pos_ - buffer_start_);
+            size_t n = std::min(length, buffer_len_ - offset);
+            std::memcpy(out, buffer_.data() + offset, n);
+            out += n;
+            length -= n;
+            pos_ += n;
+        }
+        return true;
+    }
+
+    bool skip(uint64_t length) {
+        if (length > file_size_ - pos_) {
+            return false;
+        }
+        pos_ += length;
+        return true;
+    }
+
+    void seek(uint64_t position) { pos_ = position; }
+
+    bool fill_buffer() {
+        if (pos_ >= file_size_) {
+            return false;
+        }
+        ssize_t n = pread(fd_, buffer_.data(), buffer_.size(), static_cast<off_t>(pos_));
+        if (n <= 0) {
+            return false;
+        }
+        buffer_start_ = pos_;
+        buffer_len_ = static_cast<size_t>(n);
+        return true;
+    }
+
+    int fail(const std::string& message) {
+        error_ = message;
+        return kFormatError;
+    }
+
+    std::vector<char> buffer_;
+    int fd_ = -1;
+    uint64_t file_size_ = 0;
+    uint64_t pos_ = 0;
+    uint64_t buffer_start_ = 0;
+    size_t buffer_len_ = 0;
+    uint8_t version_ = 0;
+    std::string error_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_TSFILE_LAYOUT_H
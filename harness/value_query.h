@@ -0,0 +1,263 @@
+#ifndef HARNESS_VALUE_QUERY_H
+#define HARNESS_VALUE_QUERY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/path.h"
+#include "reader/expression.h"
+#include "reader/filter/eq.h"
+#include "reader/filter/gt.h"
+#include "reader/filter/gt_eq.h"
+#include "reader/filter/lt.h"
+#include "reader/filter/lt_eq.h"
+#include "reader/tsfile_reader.h"
+
+#include "harness/bench_util.h"
+#include "harness/io_accounting.h"
+#include "harness/table_scan.h"
+
+/**
+ * 按测点取值条件查询树模型设备：ValuePredicate 描述一个 INT64 测点上的比较条件，
+ * 多个条件之间为 AND，转换为 SERIES_EXPR 表达式组成的 QueryExpression 传给 TsFileReader::query，
+ * 读取器返回基于时间生成器的结果集（QDSWithTimeGenerator）：先读取条件测点得到满足条件的时间戳，
+ * 再只读取和解码这些时间戳上的其余测点，并可按 chunk / page 统计信息跳过不可能满足条件的数据。
+ * 同时提供在客户端逐行判断条件的读取方式（按路径读取全部行后过滤），作为对照和正确性校验。
+ *
+ * 条件中的测点须为 INT64 类型，且须在查询的测点中。
+ */
+namespace harness {
+
+// 条件为空、条件中的测点不在查询的测点中
+constexpr int kValueQueryError = -104;
+
+enum class ValueOp { GT, GT_EQ, LT, LT_EQ, EQ };
+
+// 一个测点上的比较条件：测点值 op value
+struct ValuePredicate {
+    std::string measurement;
+    ValueOp op = ValueOp::EQ;
+    int64_t value = 0;
+
+    static ValuePredicate gt(const std::string& measurement, int64_t value) {
+        return {measurement, ValueOp::GT, value};
+    }
+    static ValuePredicate gt_eq(const std::string& measurement, int64_t value) {
+        return {measurement, ValueOp::GT_EQ, value};
+    }
+    static ValuePredicate lt(const std::string& measurement, int64_t value) {
+        return {measurement, ValueOp::LT, value};
+    }
+    static ValuePredicate lt_eq(const std::string& measurement, int64_t value) {
+        return {measurement, ValueOp::LT_EQ, value};
+    }
+    static ValuePredicate eq(const std::string& measurement, int64_t value) {
+        return {measurement, ValueOp::EQ, value};
+    }
+
+    // 客户端判断：v 是否满足条件
+    bool matches(int64_t v) const {
+        switch (op) {
+            case ValueOp::GT:
+                return v > value;
+            case ValueOp::GT_EQ:
+                return v >= value;
+            case ValueOp::LT:
+                return v < value;
+            case ValueOp::LT_EQ:
+                return v <= value;
+            case ValueOp::EQ:
+                return v == value;
+        }
+        return false;
+    }
+
+    // 转换为库的值过滤器，调用方持有返回的对象
+    storage::Filter* to_filter() const {
+        switch (op) {
+            case ValueOp::GT:
+                return new storage::Gt<int64_t>(value, storage::VALUE_FILTER);
+            case ValueOp::GT_EQ:
+                return new storage::GtEq<int64_t>(value, storage::VALUE_FILTER);
+            case ValueOp::LT:
+                return new storage::Lt<int64_t>(value, storage::VALUE_FILTER);
+            case ValueOp::LT_EQ:
+                return new storage::LtEq<int64_t>(value, storage::VALUE_FILTER);
+            case ValueOp::EQ:
+                return new storage::Eq<int64_t>(value, storage::VALUE_FILTER);
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * 把条件列表转换为表达式：每个条件一个 SERIES_EXPR，条件之间以 AND_EXPR 连接
+ * filters 持有创建的过滤器，调用方在关闭结果集之后释放；返回 kValueQueryError 表示条件为空
+ */
+inline int build_value_expression(const std::string& device_id,
+                                  const std::vector<ValuePredicate>& predicates,
+                                  std::vector<std::unique_ptr<storage::Filter>>& filters,
+                                  storage::Expression*& expression) {
+    expression = nullptr;
+    if (predicates.empty()) {
+        return kValueQueryError;
+    }
+    for (const ValuePredicate& predicate : predicates) {
+        filters.emplace_back(predicate.to_filter());
+        storage::Path path(device_id, predicate.measurement);
+        auto* current = new storage::Expression(storage::SERIES_EXPR, path, filters.back().get());
+        expression = expression == nullptr
+                         ? current
+                         : new storage::Expression(storage::AND_EXPR, expression, current);
+    }
+    return common::E_OK;
+}
+
+/**
+ * 带取值条件查询设备的测点：有条件时转换为表达式下推给读取器，否则按路径读取全部时间范围
+ * 表达式随结果集一起由 destroy_query_data_set 释放；filters 持有过滤器，调用方在释放结果集之后释放
+ */
+inline int query_with_values(storage::TsFileReader& reader, const std::string& device_id,
+                             const std::vector<std::string>& measurements,
+                             const std::vector<ValuePredicate>& predicates,
+                             storage::ResultSet*& result,
+                             std::vector<std::unique_ptr<storage::Filter>>& filters) {
+    if (predicates.empty()) {
+        std::vector<std::string> paths;
+        for (const std::string& measurement : measurements) {
+            paths.push_back(device_id + "." + measurement);
+        }
+        return reader.query(paths, INT64_MIN, INT64_MAX, result);
+    }
+    storage::Expression* expression = nullptr;
+    int ret = build_value_expression(device_id, predicates, filters, expression);
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    std::vector<storage::Path> paths;
+    for (const std::string& measurement : measurements) {
+        paths.emplace_back(device_id, measurement);
+    }
+    storage::QueryExpression* query = storage::QueryExpression::create(paths, expression);
+    return reader.query(query, result);
+}
+
+/**
+ * 客户端过滤：逐行读取结果集，只统计满足全部条件的行（行数、时间范围、非时间列单元格数）
+ * rows_read 返回读取器返回的总行数（过滤前）；返回 kValueQueryError 表示条件中的测点不在结果集中
+ */
+inline int scan_tree_rows_matching(storage::ResultSet* ret, const std::string& device_id,
+                                   const std::vector<ValuePredicate>& predicates,
+                                   ScanStats& stats, int64_t& rows_read, const Stopwatch& watch) {
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    std::vector<uint32_t> predicate_columns;
+    for (const ValuePredicate& predicate : predicates) {
+        std::string path = device_id + "." + predicate.measurement;
+        uint32_t index = 0;
+        for (uint32_t i = 2; i <= column_count && index == 0; i++) {
+            if (metadata->get_column_name(i) == path) {
+                index = i;
+            }
+        }
+        if (index == 0) {
+            return kValueQueryError;
+        }
+        predicate_columns.push_back(index);
+    }
+    bool has_next = false;
+    int code = common::E_OK;
+    while ((code = ret->next(has_next)) == common::E_OK && has_next) {
+        rows_read++;
+        bool matched = true;
+        for (size_t p = 0; p < predicates.size() && matched; p++) {
+            matched = !ret->is_null(predicate_columns[p]) &&
+                      predicates[p].matches(ret->get_value<int64_t>(predicate_columns[p]));
+        }
+        if (!matched) {
+            continue;
+        }
+        if (stats.rows == 0) {
+            stats.first_row_s = watch.elapsed_s();
+        }
+        int64_t timestamp = ret->get_value<int64_t>(1);
+        stats.min_time = std::min(stats.min_time, timestamp);
+        stats.max_time = std::max(stats.max_time, timestamp);
+        stats.cells += column_count - 1;
+        stats.rows++;
+    }
+    stats.scan_s = watch.elapsed_s();
+    return code;
+}
+
+// 一次带取值条件查询的统计
+struct ValueQueryResult {
+    double open_s = 0;
+    double query_s = 0;
+    double total_s = 0;      // 打开文件到读完最后一行
+    int64_t rows_read = 0;   // 客户端过滤时读取器返回的行数（过滤前），下推时为 0
+    ScanStats scan;
+    IoReport io;             // 未定义 I/O 拦截函数或未启用统计时全为 0
+                             // 库不提供解码计数，数据 page 在 NEXT 阶段读取，该阶段的读取量近似解码量
+};
+
+/**
+ * 打开文件并按条件查询设备的测点，读取全部结果（测点须为 INT64 类型）
+ * pushdown 为 true 时条件下推给读取器，否则读取全部行后在客户端过滤（条件中的测点须在 measurements 中）
+ */
+inline int run_value_query(const std::string& file_path, const std::string& device_id,
+                           const std::vector<std::string>& measurements,
+                           const std::vector<ValuePredicate>& predicates, bool pushdown,
+                           ValueQueryResult& result) {
+    IoAccounting& accounting = IoAccounting::instance();
+    IoReport io_before = accounting.report();
+    Stopwatch total;
+    Stopwatch watch;
+    storage::TsFileReader reader;
+    int ret;
+    {
+        IoPhaseScope phase(IoPhase::OPEN);
+        ret = reader.open(file_path);
+    }
+    result.open_s = watch.elapsed_s();
+    if (ret != common::E_OK) {
+        return ret;
+    }
+    storage::ResultSet* result_set = nullptr;
+    std::vector<std::unique_ptr<storage::Filter>> filters;
+    watch.reset();
+    {
+        IoPhaseScope phase(IoPhase::QUERY);
+        ret = query_with_values(reader, device_id, measurements,
+                                pushdown ? predicates : std::vector<ValuePredicate>(), result_set,
+                                filters);
+    }
+    result.query_s = watch.elapsed_s();
+    if (ret == common::E_OK) {
+        IoPhaseScope phase(IoPhase::NEXT);
+        if (pushdown) {
+            ret = scan_table_rows(result_set, result.scan, watch);
+        } else {
+            ret = scan_tree_rows_matching(result_set, device_id, predicates, result.scan,
+                                          result.rows_read, watch);
+        }
+    }
+    {
+        IoPhaseScope phase(IoPhase::CLOSE);
+        if (result_set != nullptr) {
+            reader.destroy_query_data_set(result_set);
+        }
+        reader.close();
+    }
+    result.total_s = total.elapsed_s();
+    result.io = accounting.report().since(io_before);
+    return ret;
+}
+
+}  // namespace harness
+
+#endif  // HARNESS_VALUE_QUERY_H
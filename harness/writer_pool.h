@@ -0,0 +1,127 @@
+#ifndef HARNESS_WRITER_POOL_H
+#define HARNESS_WRITER_POOL_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/schema.h"
+#include "common/tablet.h"
+#include "file/write_file.h"
+#include "writer/tsfile_table_writer.h"
+
+/**
+ * 分片写入池：持有 N 个 TsFileTableWriter，分别写入 N 个文件，
+ * 按设备（TAG 值组合）哈希把 tablet 路由到对应分片。
+ *
+ * 线程安全约定：
+ *   - libtsfile_init 初始化全局配置，只能执行一次且必须在任何写入器创建之前完成，
+ *     通过 init_tsfile_once 保证（多线程同时调用也只执行一次）；
+ *   - TsFileTableWriter 的构造会设置全局的缓存阈值配置，所有分片在 WriterPool
+ *     构造函数中串行创建，构造完成后不再修改全局配置；
+ *   - 单个 TsFileTableWriter 不是线程安全的，每个分片有自己的互斥锁，
+ *     不同分片之间写入互不影响，可以并行。
+ */
+namespace harness {
+
+// 只执行一次 libtsfile_init，可在多个线程中调用
+inline void init_tsfile_once() {
+    static std::once_flag flag;
+    std::call_once(flag, []() { storage::libtsfile_init(); });
+}
+
+class WriterPool {
+   public:
+    /**
+     * file_prefix 为文件路径前缀，第 i 个分片写入 file_prefix + "_" + i + ".tsfile"
+     * 返回前已创建全部分片，创建失败时 init_code() 不为 E_OK，且不再创建后续分片
+     */
+    WriterPool(const std::string& file_prefix, const std::string& table_name,
+               const std::vector<common::ColumnSchema>& column_schemas, size_t shard_count,
+               uint64_t memory_threshold = 128 * 1024 * 1024) {
+        init_tsfile_once();
+        for (size_t i = 0; i < shard_count; i++) {
+            std::unique_ptr<Shard> shard(new Shard());
+            shard->file_path = file_prefix + "_" + std::to_string(i) + ".tsfile";
+            int flags = O_WRONLY | O_CREAT | O_TRUNC;
+            mode_t mode = 0666;
+            int ret = shard->file.create(shard->file_path, flags, mode);
+            if (ret != common::E_OK) {
+                // 文件未打开时不创建写入器，已创建的分片由 close 关闭
+                init_code_ = ret;
+                break;
+            }
+            shard->schema.reset(new storage::TableSchema(table_name, column_schemas));
+            shard->writer.reset(
+                new storage::TsFileTableWriter(&shard->file, shard->schema.get(), memory_threshold));
+            shards_.push_back(std::move(shard));
+        }
+    }
+
+    ~WriterPool() { close(); }
+
+    int init_code() const { return init_code_; }
+    size_t shard_count() const { return shards_.size(); }
+    const std::string& file_path(size_t shard) const { return shards_[shard]->file_path; }
+
+    // 设备对应的分片
+    size_t shard_for(const std::string& device_key) const {
+        return std::hash<std::string>()(device_key) % shards_.size();
+    }
+
+    // 写入指定分片
+    int write(size_t shard, storage::Tablet& tablet) {
+        Shard& s = *shards_[shard];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.closed) {
+            return -1;
+        }
+        return s.writer->write_table(tablet);
+    }
+
+    // 按设备路由写入，tablet 中的数据需属于同一设备
+    int write(const std::string& device_key, storage::Tablet& tablet) {
+        return write(shard_for(device_key), tablet);
+    }
+
+    // flush 并关闭全部分片，返回第一个错误码
+    int close() {
+        int result = common::E_OK;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            if (shard->closed) {
+                continue;
+            }
+            int ret = shard->writer->flush();
+            if (ret == common::E_OK) {
+                ret = shard->writer->close();
+            }
+            shard->closed = true;
+            if (ret != common::E_OK && result == common::E_OK) {
+                result = ret;
+            }
+        }
+        return result;
+    }
+
+   private:
+    struct Shard {
+        std::string file_path;
+        storage::WriteFile file;
+        std::unique_ptr<storage::TableSchema> schema;
+        std::unique_ptr<storage::TsFileTableWriter> writer;
+        std::mutex mutex;
+        bool closed = false;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    int init_code_ = common::E_OK;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_WRITER_POOL_H
@@ -0,0 +1,228 @@
+#ifndef HARNESS_WRITER_STATS_H
+#define HARNESS_WRITER_STATS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/db_common.h"
+#include "common/tablet.h"
+#include "writer/tsfile_table_writer.h"
+
+#include "harness/bench_util.h"
+
+/**
+ * TsFileTableWriter 写入统计：缓存字节数（按表、按列）、自动/显式 flush 次数、
+ * 每次 flush 写入的字节数和 flush 耗时分布。
+ *
+ * 写入器内部的缓存不对外暴露，统计方式如下：
+ *   - 缓存字节数按写入 tablet 的原始数据大小估算（时间列 8 字节，定长列按类型宽度，
+ *     变长列按 set_string_width 设置的平均长度），flush 后清零；
+ *   - write_table 调用前后文件变大，说明写入器超过 memory_threshold 自动执行了 flush；
+ *   - flush 写入的字节数为调用前后的文件大小之差。
+ */
+namespace harness {
+
+// flush 耗时分布：第 i 个桶统计耗时在 [2^i, 2^(i+1)) 微秒内的次数
+class LatencyHistogram {
+   public:
+    static const int kBucketCount = 32;
+
+    void add(int64_t latency_us) {
+        int bucket = 0;
+        while (bucket + 1 < kBucketCount && (int64_t(1) << (bucket + 1)) <= latency_us) {
+            bucket++;
+        }
+        buckets_[bucket]++;
+        count_++;
+        max_us_ = std::max(max_us_, latency_us);
+    }
+
+    uint64_t count() const { return count_; }
+    int64_t max_us() const { return max_us_; }
+    uint64_t bucket(int i) const { return buckets_[i]; }
+
+    // 分位数（0-1），返回所在桶的上界（微秒）
+    int64_t percentile_us(double p) const {
+        uint64_t target = static_cast<uint64_t>(p * count_ + 0.5);
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; i++) {
+            seen += buckets_[i];
+            if (seen >= target && seen > 0) {
+                return std::min(max_us_, (int64_t(1) << (i + 1)) - 1);
+            }
+        }
+        return max_us_;
+    }
+
+    // 输出非空的桶，例如 [64us,128us):3
+    std::string to_string() const {
+        std::string result;
+        for (int i = 0; i < kBucketCount; i++) {
+            if (buckets_[i] == 0) {
+                continue;
+            }
+            result += "[" + std::to_string(int64_t(1) << i) + "us," +
+                      std::to_string(int64_t(1) << (i + 1)) + "us):" +
+                      std::to_string(buckets_[i]) + " ";
+        }
+        return result;
+    }
+
+   private:
+    uint64_t buckets_[kBucketCount] = {0};
+    uint64_t count_ = 0;
+    int64_t max_us_ = 0;
+};
+
+// 一次 flush 的记录
+struct FlushRecord {
+    bool automatic = false;         // true：write_table 中自动触发；false：显式调用 flush
+    uint64_t bytes_written = 0;     // 写入文件的字节数
+    uint64_t buffered_bytes = 0;    // flush 前估算的缓存字节数
+    int64_t latency_us = 0;         // 耗时（自动 flush 为触发它的 write_table 的耗时）
+};
+
+// 写入统计
+struct WriterStats {
+    uint64_t auto_flushes = 0;
+    uint64_t explicit_flushes = 0;
+    uint64_t buffered_bytes = 0;        // 当前估算的缓存字节数
+    uint64_t peak_buffered_bytes = 0;   // 估算的缓存字节数峰值（flush 前）
+    uint64_t total_bytes_written = 0;
+    std::map<std::string, std::map<std::string, uint64_t>> column_buffered_bytes;  // 表 -> 列 -> 字节数
+    std::vector<FlushRecord> flushes;
+    LatencyHistogram flush_latency;
+};
+
+// 带统计的表模型写入器，写入器和文件的生命周期由调用方管理
+class StatsTableWriter {
+   public:
+    /**
+     * writer 为已创建的写入器，file_path 为其写入的文件路径（用于统计文件大小）
+     * column_names / data_types 为写入的表结构，与 tablet 的列顺序一致
+     */
+    StatsTableWriter(storage::TsFileTableWriter* writer, const std::string& file_path,
+                     const std::string& table_name, const std::vector<std::string>& column_names,
+                     const std::vector<common::TSDataType>& data_types)
+        : writer_(writer), file_path_(file_path), table_name_(table_name),
+          column_names_(column_names), data_types_(data_types),
+          last_file_size_(file_size_bytes(file_path)) {
+        for (const auto& name : column_names_) {
+            stats_.column_buffered_bytes[table_name_][name] = 0;
+        }
+    }
+
+    // 设置变长列的平均长度（字节），默认 16
+    void set_string_width(uint32_t width) { string_width_ = width; }
+
+    /**
+     * 写入 tablet，row_count 为 tablet 中的有效行数
+     */
+    int write_table(storage::Tablet& tablet, uint32_t row_count) {
+        add_buffered(row_count);
+        Stopwatch watch;
+        int ret = writer_->write_table(tablet);
+        int64_t latency_us = watch.elapsed_us();
+        uint64_t written = take_written_bytes();
+        if (ret == common::E_OK && written > 0) {
+            record_flush(true, written, latency_us);
+        }
+        return ret;
+    }
+
+    // 显式 flush
+    int flush() {
+        Stopwatch watch;
+        int ret = writer_->flush();
+        int64_t latency_us = watch.elapsed_us();
+        if (ret == common::E_OK) {
+            record_flush(false, take_written_bytes(), latency_us);
+        }
+        return ret;
+    }
+
+    // 关闭写入器，关闭时写入的索引等数据计入 total_bytes_written
+    int close() {
+        int ret = writer_->close();
+        stats_.total_bytes_written += take_written_bytes();
+        return ret;
+    }
+
+    const WriterStats& stats() const { return stats_; }
+
+   private:
+    // 按 tablet 的原始数据大小累加缓存字节数
+    void add_buffered(uint32_t row_count) {
+        uint64_t total = static_cast<uint64_t>(row_count) * sizeof(int64_t);
+        auto& columns = stats_.column_buffered_bytes[table_name_];
+        for (size_t i = 0; i < column_names_.size(); i++) {
+            uint64_t width = value_width(data_types_[i]);
+            uint64_t bytes = static_cast<uint64_t>(row_count) * width;
+            columns[column_names_[i]] += bytes;
+            total += bytes;
+        }
+        stats_.buffered_bytes += total;
+        stats_.peak_buffered_bytes = std::max(stats_.peak_buffered_bytes, stats_.buffered_bytes);
+    }
+
+    uint32_t value_width(common::TSDataType type) const {
+        switch (type) {
+            case common::BOOLEAN:
+                return 1;
+            case common::DATE:
+            case common::INT32:
+            case common::FLOAT:
+                return 4;
+            case common::TIMESTAMP:
+            case common::INT64:
+            case common::DOUBLE:
+                return 8;
+            default:
+                return string_width_;
+        }
+    }
+
+    // 距上次统计写入文件的字节数
+    uint64_t take_written_bytes() {
+        uint64_t size = file_size_bytes(file_path_);
+        uint64_t written = size > last_file_size_ ? size - last_file_size_ : 0;
+        last_file_size_ = size;
+        return written;
+    }
+
+    void record_flush(bool automatic, uint64_t written, int64_t latency_us) {
+        FlushRecord record;
+        record.automatic = automatic;
+        record.bytes_written = written;
+        record.buffered_bytes = stats_.buffered_bytes;
+        record.latency_us = latency_us;
+        stats_.flushes.push_back(record);
+        stats_.flush_latency.add(latency_us);
+        stats_.total_bytes_written += written;
+        if (automatic) {
+            stats_.auto_flushes++;
+        } else {
+            stats_.explicit_flushes++;
+        }
+        stats_.buffered_bytes = 0;
+        for (auto& column : stats_.column_buffered_bytes[table_name_]) {
+            column.second = 0;
+        }
+    }
+
+    storage::TsFileTableWriter* writer_;
+    std::string file_path_;
+    std::string table_name_;
+    std::vector<std::string> column_names_;
+    std::vector<common::TSDataType> data_types_;
+    uint64_t last_file_size_ = 0;
+    uint32_t string_width_ = 16;
+    WriterStats stats_;
+};
+
+}  // namespace harness
+
+#endif  // HARNESS_WRITER_STATS_H
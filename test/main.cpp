@@ -1,6 +1,39 @@
+#include <cstdio>
+#include <optional>
+
 #include "gtest/gtest.h"
 
+// 在测试套件中定义文件 I/O 拦截函数（见 harness/io_accounting.h），测试用例按需启用统计
+#define HARNESS_IO_ACCOUNTING_HOOKS
+#include "harness/io_accounting.h"
+
+// 可选定义内存分配计数的替换函数（见 harness/alloc_counter.h，CMake 选项 ENABLE_ALLOC_COUNTER）
+#ifdef HARNESS_ENABLE_ALLOC_COUNTER
+#define HARNESS_ALLOC_COUNTER_HOOKS
+#endif
+#include "harness/alloc_counter.h"
+
+// 每个测试用例结束时输出该用例的分配次数、分配字节数和堆内存占用峰值增量
+class AllocReportListener : public ::testing::EmptyTestEventListener {
+   public:
+    void OnTestStart(const ::testing::TestInfo&) override { scope_.emplace(); }
+
+    void OnTestEnd(const ::testing::TestInfo& info) override {
+        harness::AllocStats stats = scope_->stats();
+        scope_.reset();
+        printf("[  ALLOC   ] %s.%s allocations=%llu bytes=%llu peak_live_KB=%.1f\n",
+               info.test_suite_name(), info.name(), (unsigned long long)stats.allocations,
+               (unsigned long long)stats.bytes, stats.peak_live_bytes / 1024.0);
+    }
+
+   private:
+    std::optional<harness::AllocScope> scope_;
+};
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
+    if (harness::AllocCounter::installed()) {
+        ::testing::UnitTest::GetInstance()->listeners().Append(new AllocReportListener());
+    }
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
@@ -16,12 +16,32 @@
 #include "writer/tsfile_writer.h"
 #include "cwrapper/tsfile_cwrapper.h"
 #include "cwrapper/errno_define_c.h"
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <ostream>
 #include <writer/tsfile_table_writer.h>
 #include <string>
 #include <filesystem>
+#include <fstream>
+#include <optional>
+
+#include "harness/alloc_counter.h"
+#include "harness/arrow_export.h"
+#include "harness/async_writer.h"
+#include "harness/bench_util.h"
+#include "harness/column_batch.h"
+#include "harness/csv_load.h"
+#include "harness/data_generator.h"
+#include "harness/io_accounting.h"
+#include "harness/mmap_read.h"
+#include "harness/table_dataset.h"
+#include "harness/table_export.h"
+#include "harness/table_scan.h"
+#include "harness/tablet_bulk.h"
+#include "harness/tag_query.h"
+#include "harness/time_window.h"
+#include "harness/writer_stats.h"
 
 using namespace storage;
 using namespace common;
@@ -569,339 +589,1363 @@ TEST_F(TsFileWriterTableTest, TestTsFileTableWriter2) {
 }
 
 
-// // 测试6：1万TAG和FIELD列，1行
-// TEST_F(TsFileWriterTableTest, TestTsFileTableWriter6) {
-//     string table_name = "table1"; // 表名
-//     vector<string> columnNames; // 列名
-//     vector<common::ColumnSchema> column_schemas; // 列的元数据信息
-//     vector<common::TSDataType> data_types; // 数据类型
-//     size_t tag_count = 1000; // tag列数量
-//     size_t field_count = 1000; // field列数量
-//     size_t column_count = tag_count + field_count * 4; // 总列数
-//     // Tag 列
-//     for (size_t i = 0; i < tag_count; i++)
-//     {
-//         string tag_name = "tag_" + to_string(i);
-//         columnNames.emplace_back(tag_name);
-//         data_types.emplace_back(common::TSDataType::STRING);
-//         column_schemas.emplace_back(tag_name, common::TSDataType::STRING, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::TAG);
-//     }
-//     // Field 列
-//     for (size_t i = 0; i < field_count; i++)
-//     {
-//         string field_name1 = "int64_" + to_string(i);
-//         columnNames.emplace_back(field_name1);
-//         data_types.emplace_back(common::TSDataType::INT64);
-//         column_schemas.emplace_back(field_name1, common::TSDataType::INT64, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name2 = "int32_" + to_string(i);
-//         columnNames.emplace_back(field_name2);
-//         data_types.emplace_back(common::TSDataType::INT32);
-//         column_schemas.emplace_back(field_name2, common::TSDataType::INT32, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name3 = "float_" + to_string(i);
-//         columnNames.emplace_back(field_name3);
-//         data_types.emplace_back(common::TSDataType::FLOAT);
-//         column_schemas.emplace_back(field_name3, common::TSDataType::FLOAT, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name4 = "double_" + to_string(i);
-//         columnNames.emplace_back(field_name4);
-//         data_types.emplace_back(common::TSDataType::DOUBLE);
-//         column_schemas.emplace_back(field_name4, common::TSDataType::DOUBLE, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//     }
-//     // 构建表的元数据
-//     auto* schema = new storage::TableSchema(table_name,column_schemas); 
+// 写入统计测试：按指定缓存阈值写入多个 tablet，返回写入统计
+// pre_flush_growth 不为空时返回显式 flush 之前文件增长的字节数（写入期间自动 flush 写入的数据）
+void write_with_stats(uint64_t memory_threshold, int tablet_count, int tablet_rows, harness::WriterStats& stats,
+                      uint64_t* pre_flush_growth = nullptr) {
+    string table_name = "table_stats";
+    vector<string> column_names = {"tag1"};
+    vector<common::TSDataType> data_types = {common::TSDataType::STRING};
+    vector<common::ColumnCategory> column_categories = {common::ColumnCategory::TAG};
+    for (int i = 0; i < 10; i++) {
+        column_names.push_back("s" + to_string(i));
+        data_types.push_back(common::TSDataType::INT64);
+        column_categories.push_back(common::ColumnCategory::FIELD);
+    }
+    // 使用 PLAIN 编码且不压缩，使缓存大小与原始数据大小一致
+    vector<common::ColumnSchema> column_schemas;
+    for (size_t i = 0; i < column_names.size(); i++) {
+        column_schemas.emplace_back(column_names[i], data_types[i], common::UNCOMPRESSED, common::PLAIN, column_categories[i]);
+    }
+    auto* schema = new storage::TableSchema(table_name, column_schemas);
+    auto* writer = new storage::TsFileTableWriter(&writer_file_, schema, memory_threshold);
+    harness::StatsTableWriter stats_writer(writer, table_file_path, table_name, column_names, data_types);
+    uint64_t initial_size = harness::file_size_bytes(table_file_path);
 
-//     // 构建写入器
-//     auto* writer = new storage::TsFileTableWriter(&writer_file_,schema); 
+    int64_t timestamp = 0;
+    for (int t = 0; t < tablet_count; t++) {
+        storage::Tablet tablet(table_name, column_names, data_types, column_categories, tablet_rows);
+        for (int row = 0; row < tablet_rows; row++) {
+            ASSERT_EQ(E_OK, tablet.add_timestamp(row, timestamp++));
+            ASSERT_EQ(E_OK, tablet.add_value(row, 0u, "d1"));
+            for (uint32_t i = 1; i < column_names.size(); i++) {
+                ASSERT_EQ(E_OK, tablet.add_value(row, i, timestamp * i));
+            }
+        }
+        ASSERT_EQ(E_OK, stats_writer.write_table(tablet, tablet_rows));
+    }
+    if (pre_flush_growth != nullptr) {
+        *pre_flush_growth = harness::file_size_bytes(table_file_path) - initial_size;
+    }
+    ASSERT_EQ(E_OK, stats_writer.flush());
+    ASSERT_EQ(E_OK, stats_writer.close());
+    stats = stats_writer.stats();
+    delete writer;
+    delete schema;
 
-//     // 创建 tablet 以插入数据。
-//     int max_rows = 1; // 最大行数
-//     storage::Tablet tablet(columnNames,data_types,max_rows);
-//     int64_t timestamp = 0;
-//     for (int row = 0; row < max_rows; row++) {
-//         ASSERT_EQ(0, tablet.add_timestamp(row, timestamp++));
-//         for (size_t i = 0; i < data_types.size(); i++)
-//         {
-//             switch (data_types[i])
-//             {
-//                 case common::TSDataType::INT64:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int64_t>(row)));
-//                     break;
-//                 case common::TSDataType::INT32:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int32_t>(row)));
-//                     break;
-//                 case common::TSDataType::FLOAT:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<float>(row)));
-//                     break;
-//                 case common::TSDataType::DOUBLE:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<double>(row)));
-//                     break;
-//                 case common::TSDataType::STRING:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], ("tag" + to_string(row)).c_str()));
-//                     break;
-//                 default:
-//                     break;
-//             }
-//         }  
-//     }
-//     ASSERT_EQ(0, writer->write_table(tablet)); // 写入数据
-//     ASSERT_EQ(0, writer->flush()); // 刷新数据
-//     ASSERT_EQ(0, writer->close()); // 关闭写入
+    // 验证数据完整
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(table_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(table_name, column_names, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ScanStats scan;
+    ASSERT_EQ(E_OK, harness::scan_table_rows(ret, scan, harness::Stopwatch()));
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(scan.rows, static_cast<int64_t>(tablet_count) * tablet_rows);
+}
 
-//     // 释放动态分配的内存
-//     delete writer;
-//     delete schema;
+// 测试12：缓存阈值较小时自动 flush，且每次自动 flush 前的缓存大小不明显超过阈值
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterMemoryThreshold) {
+    uint64_t memory_threshold = 1024 * 1024;
+    int tablet_rows = 1000;
+    harness::WriterStats stats;
+    write_with_stats(memory_threshold, 100, tablet_rows, stats);
+    if (HasFatalFailure()) {
+        return;
+    }
+    cout << "auto_flushes=" << stats.auto_flushes << " explicit_flushes=" << stats.explicit_flushes
+         << " peak_buffered_bytes=" << stats.peak_buffered_bytes
+         << " flush_latency: " << stats.flush_latency.to_string() << endl;
+    // 约 10MB 数据、1MB 阈值，应自动 flush 多次
+    ASSERT_GE(stats.auto_flushes, 5u);
+    ASSERT_EQ(stats.explicit_flushes, 1u);
+    // 阈值按 tablet 粒度检查：允许超出阈值一倍和一个 tablet 的大小。
+    // buffered_bytes 是按原始数据大小估算的缓存字节数（写入器不暴露内部缓存），该上界针对估算值
+    uint64_t tablet_bytes = static_cast<uint64_t>(tablet_rows) * (8 + 16 + 10 * 8);
+    for (const auto& flush : stats.flushes) {
+        if (flush.automatic) {
+            ASSERT_GT(flush.bytes_written, 0u);
+            ASSERT_LE(flush.buffered_bytes, memory_threshold * 2 + tablet_bytes);
+        }
+    }
+    ASSERT_EQ(stats.flush_latency.count(), stats.flushes.size());
+}
 
-//     // 验证数据正确性
-//     query_data_table(table_name, columnNames);
-// }
+// 测试13：缓存阈值大于写入数据量时不自动 flush
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterNoAutoFlush) {
+    harness::WriterStats stats;
+    uint64_t pre_flush_growth = 0;
+    write_with_stats(128 * 1024 * 1024, 10, 1000, stats, &pre_flush_growth);
+    if (HasFatalFailure()) {
+        return;
+    }
+    // 显式 flush 之前文件没有增长，全部数据由唯一一次显式 flush 写入
+    ASSERT_EQ(pre_flush_growth, 0u);
+    ASSERT_EQ(stats.auto_flushes, 0u);
+    ASSERT_EQ(stats.explicit_flushes, 1u);
+    ASSERT_EQ(stats.flushes.size(), 1u);
+    // FIELD 列使用 PLAIN 编码且不压缩，flush 写入的字节数不少于 10 列 × 1 万行 INT64 的原始大小
+    ASSERT_GE(stats.flushes[0].bytes_written, 10u * 1000 * 10 * 8);
+    ASSERT_LE(stats.flushes[0].bytes_written, stats.total_bytes_written);
+}
 
-// // 测试7：10个TAG和FIELD列，1万行写入
-// TEST_F(TsFileWriterTableTest, TestTsFileTableWriter7) {
-//     string table_name = "table7"; // 表名
-//     vector<string> columnNames; // 列名
-//     vector<common::ColumnSchema> column_schemas; // 列的元数据信息
-//     vector<common::TSDataType> data_types; // 数据类型
-//     size_t tag_count = 2; // tag列数量
-//     size_t field_count = 1; // field列数量
-//     size_t column_count = tag_count + field_count * 4; // 总列数
-//     // Tag 列
-//     for (size_t i = 0; i < tag_count; i++)
-//     {
-//         string tag_name = "tag_" + to_string(i);
-//         columnNames.emplace_back(tag_name);
-//         data_types.emplace_back(common::TSDataType::STRING);
-//         column_schemas.emplace_back(tag_name, common::TSDataType::STRING, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::TAG);
-//     }
-//     // Field 列
-//     for (size_t i = 0; i < field_count; i++)
-//     {
-//         string field_name1 = "int64_" + to_string(i);
-//         columnNames.emplace_back(field_name1);
-//         data_types.emplace_back(common::TSDataType::INT64);
-//         column_schemas.emplace_back(field_name1, common::TSDataType::INT64, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name2 = "int32_" + to_string(i);
-//         columnNames.emplace_back(field_name2);
-//         data_types.emplace_back(common::TSDataType::INT32);
-//         column_schemas.emplace_back(field_name2, common::TSDataType::INT32, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name3 = "float_" + to_string(i);
-//         columnNames.emplace_back(field_name3);
-//         data_types.emplace_back(common::TSDataType::FLOAT);
-//         column_schemas.emplace_back(field_name3, common::TSDataType::FLOAT, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name4 = "double_" + to_string(i);
-//         columnNames.emplace_back(field_name4);
-//         data_types.emplace_back(common::TSDataType::DOUBLE);
-//         column_schemas.emplace_back(field_name4, common::TSDataType::DOUBLE, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//     }
-//     // 构建表的元数据
-//     auto* schema = new storage::TableSchema(table_name,column_schemas); 
-//     // 构建写入器
-//     auto* writer = new storage::TsFileTableWriter(&writer_file_,schema); 
-//     // 创建 tablet 以插入数据。
-//     int max_rows = 10000; // 最大行数
-//     storage::Tablet tablet(columnNames,data_types,max_rows);
-//     int64_t timestamp = 0;
-//     for (int row = 0; row < max_rows; row++) {
-//         ASSERT_EQ(0, tablet.add_timestamp(row, timestamp++));
-//         for (size_t i = 0; i < data_types.size(); i++)
-//         {
-//             switch (data_types[i])
-//             {
-//                 case common::TSDataType::INT64:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int64_t>(row)));
-//                     break;
-//                 case common::TSDataType::INT32:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int32_t>(row)));
-//                     break;
-//                 case common::TSDataType::FLOAT:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<float>(row)));
-//                     break;
-//                 case common::TSDataType::DOUBLE:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<double>(row)));
-//                     break;
-//                 case common::TSDataType::STRING:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], ("tag" + to_string(row)).c_str()));
-//                     break;
-//                 default:
-//                     break;
-//             }
-//         }  
-//     }
-//     ASSERT_EQ(0, writer->write_table(tablet)); // 写入数据
-//     ASSERT_EQ(0, writer->flush()); // 刷新数据
-//     ASSERT_EQ(0, writer->close()); // 关闭写入
-//     // 释放动态分配的内存
-//     delete writer;
-//     delete schema;
-//     // 验证数据正确性
-//     query_data_table(table_name, columnNames);
-// }
+// 测试14：异步写入器按提交顺序写入全部 tablet，每个 tablet 和 flush 的 future 均返回 E_OK
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterAsync) {
+    string table_name = "table_async";
+    vector<string> column_names = {"tag1", "s0", "s1"};
+    vector<common::TSDataType> data_types = {common::TSDataType::STRING, common::TSDataType::INT64, common::TSDataType::DOUBLE};
+    vector<common::ColumnCategory> column_categories = {common::ColumnCategory::TAG, common::ColumnCategory::FIELD, common::ColumnCategory::FIELD};
+    vector<common::ColumnSchema> column_schemas;
+    for (size_t i = 0; i < column_names.size(); i++) {
+        column_schemas.emplace_back(column_names[i], data_types[i], column_categories[i]);
+    }
+    int tablet_count = 50;
+    int tablet_rows = 1000;
+    auto* schema = new storage::TableSchema(table_name, column_schemas);
+    auto* writer = new storage::TsFileTableWriter(&writer_file_, schema);
+    {
+        harness::AsyncTableWriter async_writer(writer, [&]() {
+            return std::unique_ptr<storage::Tablet>(new storage::Tablet(table_name, column_names, data_types, column_categories, tablet_rows));
+        }, 2);
+        vector<future<int>> results;
+        int64_t timestamp = 0;
+        for (int t = 0; t < tablet_count; t++) {
+            unique_ptr<storage::Tablet> tablet = async_writer.acquire();
+            for (int row = 0; row < tablet_rows; row++) {
+                ASSERT_EQ(E_OK, tablet->add_timestamp(row, timestamp));
+                ASSERT_EQ(E_OK, tablet->add_value(row, 0u, "d1"));
+                ASSERT_EQ(E_OK, tablet->add_value(row, 1u, timestamp));
+                ASSERT_EQ(E_OK, tablet->add_value(row, 2u, timestamp * 0.5));
+                timestamp++;
+            }
+            results.push_back(async_writer.submit(std::move(tablet)));
+        }
+        future<int> flushed = async_writer.flush();
+        ASSERT_EQ(E_OK, flushed.get());
+        // flush 完成时之前提交的 tablet 都已写入
+        for (auto& result : results) {
+            ASSERT_EQ(future_status::ready, result.wait_for(chrono::seconds(0)));
+            ASSERT_EQ(E_OK, result.get());
+        }
+        ASSERT_EQ(E_OK, async_writer.close());
+        ASSERT_EQ(static_cast<uint64_t>(tablet_count), async_writer.stats().tablets);
+    }
+    ASSERT_EQ(E_OK, writer->close());
+    delete writer;
+    delete schema;
 
-// // 测试8：1万设备（TAG列），10测点（FIELD列），100行写入
-// TEST_F(TsFileWriterTableTest, TestTsFileTableWriter8) {
-//     string table_name = "table1"; // 表名
-//     vector<string> columnNames; // 列名
-//     vector<common::ColumnSchema> column_schemas; // 列的元数据信息
-//     vector<common::TSDataType> data_types; // 数据类型
-//     size_t tag_count = 10000; // tag列数量
-//     size_t field_count = 10; // field列数量
-//     size_t column_count = tag_count + field_count * 4; // 总列数
-//     // Tag 列
-//     for (size_t i = 0; i < tag_count; i++)
-//     {
-//         string tag_name = "tag_" + to_string(i);
-//         columnNames.emplace_back(tag_name);
-//         data_types.emplace_back(common::TSDataType::STRING);
-//         column_schemas.emplace_back(tag_name, common::TSDataType::STRING, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::TAG);
-//     }
-//     // Field 列
-//     for (size_t i = 0; i < field_count; i++)
-//     {
-//         string field_name1 = "int64_" + to_string(i);
-//         columnNames.emplace_back(field_name1);
-//         data_types.emplace_back(common::TSDataType::INT64);
-//         column_schemas.emplace_back(field_name1, common::TSDataType::INT64, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name2 = "int32_" + to_string(i);
-//         columnNames.emplace_back(field_name2);
-//         data_types.emplace_back(common::TSDataType::INT32);
-//         column_schemas.emplace_back(field_name2, common::TSDataType::INT32, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name3 = "float_" + to_string(i);
-//         columnNames.emplace_back(field_name3);
-//         data_types.emplace_back(common::TSDataType::FLOAT);
-//         column_schemas.emplace_back(field_name3, common::TSDataType::FLOAT, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name4 = "double_" + to_string(i);
-//         columnNames.emplace_back(field_name4);
-//         data_types.emplace_back(common::TSDataType::DOUBLE);
-//         column_schemas.emplace_back(field_name4, common::TSDataType::DOUBLE, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//     }
-//     // 构建表的元数据
-//     auto* schema = new storage::TableSchema(table_name,column_schemas); 
-//     // 构建写入器
-//     auto* writer = new storage::TsFileTableWriter(&writer_file_,schema); 
-//     // 创建 tablet 以插入数据。
-//     int max_rows = 100; // 最大行数
-//     storage::Tablet tablet(columnNames,data_types,max_rows);
-//     int64_t timestamp = 0;
-//     for (int row = 0; row < max_rows; row++) {
-//         ASSERT_EQ(0, tablet.add_timestamp(row, timestamp++));
-//         for (size_t i = 0; i < data_types.size(); i++)
-//         {
-//             switch (data_types[i])
-//             {
-//                 case common::TSDataType::INT64:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int64_t>(row)));
-//                     break;
-//                 case common::TSDataType::INT32:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int32_t>(row)));
-//                     break;
-//                 case common::TSDataType::FLOAT:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<float>(row)));
-//                     break;
-//                 case common::TSDataType::DOUBLE:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<double>(row)));
-//                     break;
-//                 case common::TSDataType::STRING:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], ("tag" + to_string(row)).c_str()));
-//                     break;
-//                 default:
-//                     break;
-//             }
-//         }  
-//     }
-//     ASSERT_EQ(0, writer->write_table(tablet)); // 写入数据
-//     ASSERT_EQ(0, writer->flush()); // 刷新数据
-//     ASSERT_EQ(0, writer->close()); // 关闭写入
-//     // 释放动态分配的内存
-//     delete writer;
-//     delete schema;
-//     // 验证数据正确性
-//     query_data_table(table_name, columnNames);
-// }
+    // 验证数据完整
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(table_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(table_name, column_names, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ScanStats scan;
+    ASSERT_EQ(E_OK, harness::scan_table_rows(ret, scan, harness::Stopwatch()));
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(scan.rows, static_cast<int64_t>(tablet_count) * tablet_rows);
+    ASSERT_EQ(scan.min_time, 0);
+    ASSERT_EQ(scan.max_time, static_cast<int64_t>(tablet_count) * tablet_rows - 1);
+    ASSERT_EQ(scan.null_cells, 0);
+}
 
-// // 测试9：10设备（TAG列），1万测点（FIELD列），100行写入
-// TEST_F(TsFileWriterTableTest, TestTsFileTableWriter9) {
-//     string table_name = "table10"; // 表名
-//     vector<string> columnNames; // 列名
-//     vector<common::ColumnSchema> column_schemas; // 列的元数据信息
-//     vector<common::TSDataType> data_types; // 数据类型
-//     vector<common::ColumnCategory> column_category; // 列类别
-//     size_t tag_count = 10; // tag列数量
-//     size_t field_count = 10000; // field列数量
-//     size_t column_count = tag_count + field_count * 4; // 总列数
-//     // Tag 列
-//     for (size_t i = 0; i < tag_count; i++)
-//     {
-//         string tag_name = "tag_" + to_string(i);
-//         columnNames.emplace_back(tag_name);
-//         data_types.emplace_back(common::TSDataType::STRING);
-//         column_category.emplace_back(common::ColumnCategory::TAG);
-//         column_schemas.emplace_back(tag_name, common::TSDataType::STRING, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::TAG);
-//     }
-//     // Field 列
-//     for (size_t i = 0; i < field_count; i++)
-//     {
-//         string field_name1 = "int64_" + to_string(i);
-//         columnNames.emplace_back(field_name1);
-//         data_types.emplace_back(common::TSDataType::INT64);
-//         column_category.emplace_back(common::ColumnCategory::FIELD);
-//         column_schemas.emplace_back(field_name1, common::TSDataType::INT64, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name2 = "int32_" + to_string(i);
-//         columnNames.emplace_back(field_name2);
-//         data_types.emplace_back(common::TSDataType::INT32);
-//         column_category.emplace_back(common::ColumnCategory::FIELD);
-//         column_schemas.emplace_back(field_name2, common::TSDataType::INT32, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name3 = "float_" + to_string(i);
-//         columnNames.emplace_back(field_name3);
-//         data_types.emplace_back(common::TSDataType::FLOAT);
-//         column_category.emplace_back(common::ColumnCategory::FIELD);
-//         column_schemas.emplace_back(field_name3, common::TSDataType::FLOAT, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//         string field_name4 = "double_" + to_string(i);
-//         columnNames.emplace_back(field_name4);
-//         data_types.emplace_back(common::TSDataType::DOUBLE);
-//         column_category.emplace_back(common::ColumnCategory::FIELD);
-//         column_schemas.emplace_back(field_name4, common::TSDataType::DOUBLE, common::UNCOMPRESSED, common::PLAIN, common::ColumnCategory::FIELD);
-//     }
-//     // 构建表的元数据
-//     auto* schema = new storage::TableSchema(table_name,column_schemas); 
-//     // 构建写入器
-//     auto* writer = new storage::TsFileTableWriter(&writer_file_,schema); 
-//     // 创建 tablet 以插入数据。
-//     int max_rows = 100; // 最大行数
-//     storage::Tablet tablet(table_name,columnNames,data_types,column_category,max_rows);
-//     int64_t timestamp = 0;
-//     for (int row = 0; row < max_rows; row++) {
-//         ASSERT_EQ(0, tablet.add_timestamp(row, timestamp++));
-//         for (size_t i = 0; i < data_types.size(); i++)
-//         {
-//             switch (data_types[i])
-//             {
-//                 case common::TSDataType::INT64:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int64_t>(row)));
-//                     break;
-//                 case common::TSDataType::INT32:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<int32_t>(row)));
-//                     break;
-//                 case common::TSDataType::FLOAT:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<float>(row)));
-//                     break;
-//                 case common::TSDataType::DOUBLE:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], static_cast<double>(row)));
-//                     break;
-//                 case common::TSDataType::STRING:
-//                     ASSERT_EQ(0, tablet.add_value(row, columnNames[i], ("tag" + to_string(row)).c_str()));
-//                     break;
-//                 default:
-//                     break;
-//             }
-//         }  
-//     }
-//     ASSERT_EQ(0, writer->write_table(tablet)); // 写入数据
-//     ASSERT_EQ(0, writer->flush()); // 刷新数据
-//     ASSERT_EQ(0, writer->close()); // 关闭写入
-//     // 释放动态分配的内存
-//     delete writer;
-//     delete schema;
-//     // 验证数据正确性
-//     query_data_table(table_name, columnNames);
-// }
+// 测试15：数据生成器相同种子生成相同序列，各形态的数据均可写入并读回，空值比例符合配置
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterGenerator) {
+    // 相同种子生成相同序列，不同种子生成不同序列
+    harness::ColumnGenSpec walk;
+    walk.shape = harness::ValueShape::RANDOM_WALK;
+    harness::ColumnGenerator a(common::TSDataType::DOUBLE, walk, 7);
+    harness::ColumnGenerator b(common::TSDataType::DOUBLE, walk, 7);
+    harness::ColumnGenerator c(common::TSDataType::DOUBLE, walk, 8);
+    bool differs = false;
+    for (int i = 0; i < 1000; i++) {
+        a.next();
+        b.next();
+        c.next();
+        ASSERT_EQ(a.double_value(), b.double_value());
+        differs = differs || a.double_value() != c.double_value();
+    }
+    ASSERT_TRUE(differs);
+
+    // ZIPF 分布中第 0 个取值最频繁
+    harness::ColumnGenSpec zipf;
+    zipf.shape = harness::ValueShape::ZIPF;
+    zipf.cardinality = 100;
+    harness::ColumnGenerator z(common::TSDataType::STRING, zipf, 1);
+    vector<int> counts(zipf.cardinality, 0);
+    for (int i = 0; i < 10000; i++) {
+        z.next();
+        counts[z.int_value()]++;
+    }
+    ASSERT_EQ(max_element(counts.begin(), counts.end()) - counts.begin(), 0);
+
+    // 每种数据类型一列，依次使用各种形态，FIELD 列空值比例 20%
+    string table_name = "table_generator";
+    vector<string> column_names = {"tag1"};
+    vector<common::TSDataType> data_types = {common::TSDataType::STRING};
+    vector<common::ColumnCategory> column_categories = {common::ColumnCategory::TAG};
+    harness::ColumnGenSpec tag_spec;
+    tag_spec.shape = harness::ValueShape::ZIPF;
+    tag_spec.text_prefix = "device_";
+    vector<harness::ColumnGenSpec> specs = {tag_spec};
+    const vector<common::TSDataType> field_types = {
+        common::TSDataType::INT64, common::TSDataType::INT32, common::TSDataType::FLOAT,
+        common::TSDataType::DOUBLE, common::TSDataType::BOOLEAN, common::TSDataType::TEXT,
+        common::TSDataType::STRING, common::TSDataType::BLOB, common::TSDataType::DATE,
+        common::TSDataType::TIMESTAMP,
+    };
+    const vector<harness::ValueShape> shapes = {
+        harness::ValueShape::ROW, harness::ValueShape::COUNTER, harness::ValueShape::RANDOM_WALK,
+        harness::ValueShape::PERIODIC, harness::ValueShape::LOW_CARDINALITY, harness::ValueShape::ZIPF,
+    };
+    for (size_t i = 0; i < field_types.size(); i++) {
+        column_names.push_back("s" + to_string(i));
+        data_types.push_back(field_types[i]);
+        column_categories.push_back(common::ColumnCategory::FIELD);
+        harness::ColumnGenSpec spec;
+        spec.shape = shapes[i % shapes.size()];
+        spec.null_rate = 0.2;
+        specs.push_back(spec);
+    }
+    vector<common::ColumnSchema> column_schemas;
+    for (size_t i = 0; i < column_names.size(); i++) {
+        column_schemas.emplace_back(column_names[i], data_types[i], column_categories[i]);
+    }
+    auto* schema = new storage::TableSchema(table_name, column_schemas);
+    auto* writer = new storage::TsFileTableWriter(&writer_file_, schema);
+    harness::TabletGenerator generator(data_types, specs, 42);
+    int tablet_count = 10;
+    int tablet_rows = 1000;
+    for (int t = 0; t < tablet_count; t++) {
+        storage::Tablet tablet(table_name, column_names, data_types, column_categories, tablet_rows);
+        ASSERT_EQ(E_OK, generator.fill(tablet, tablet_rows));
+        ASSERT_EQ(E_OK, writer->write_table(tablet));
+    }
+    ASSERT_EQ(E_OK, writer->flush());
+    ASSERT_EQ(E_OK, writer->close());
+    delete writer;
+    delete schema;
+
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(table_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(table_name, column_names, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ScanStats scan;
+    ASSERT_EQ(E_OK, harness::scan_table_rows(ret, scan, harness::Stopwatch()));
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    int64_t rows = static_cast<int64_t>(tablet_count) * tablet_rows;
+    ASSERT_EQ(scan.rows, rows);
+    // TAG 列无空值，FIELD 列空值比例约为 20%
+    double null_rate = static_cast<double>(scan.null_cells) / (rows * field_types.size());
+    cout << "null_rate=" << null_rate << endl;
+    ASSERT_GT(null_rate, 0.15);
+    ASSERT_LT(null_rate, 0.25);
+}
+
+// 测试16：文件 I/O 统计按阶段记录写入和读取的系统调用，窄时间范围查询只读取文件的一小部分
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterIoAccounting) {
+    harness::IoAccounting& accounting = harness::IoAccounting::instance();
+    accounting.enable(".io.tsfile");
+    accounting.reset();
+    string io_file_path = table_file_path + ".io.tsfile";
+
+    // 单个设备，每个 tablet 写入后 flush，每个 tablet 对应一个 chunk group
+    string table_name = "table_io";
+    vector<string> column_names = {"tag1", "s1", "s2"};
+    vector<common::TSDataType> data_types = {common::TSDataType::STRING,
+                                             common::TSDataType::DOUBLE,
+                                             common::TSDataType::DOUBLE};
+    vector<common::ColumnCategory> column_categories = {common::ColumnCategory::TAG,
+                                                        common::ColumnCategory::FIELD,
+                                                        common::ColumnCategory::FIELD};
+    harness::ColumnGenSpec tag_spec;
+    tag_spec.shape = harness::ValueShape::LOW_CARDINALITY;
+    tag_spec.cardinality = 1;
+    harness::ColumnGenSpec field_spec;
+    field_spec.shape = harness::ValueShape::RANDOM_WALK;
+    vector<harness::ColumnGenSpec> specs = {tag_spec, field_spec, field_spec};
+    vector<common::ColumnSchema> column_schemas;
+    for (size_t i = 0; i < column_names.size(); i++) {
+        column_schemas.emplace_back(column_names[i], data_types[i], column_categories[i]);
+    }
+    int tablet_count = 50;
+    int tablet_rows = 1000;
+    storage::WriteFile io_file;
+    auto* schema = new storage::TableSchema(table_name, column_schemas);
+    storage::TsFileTableWriter* writer = nullptr;
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::OPEN);
+        ASSERT_EQ(E_OK, io_file.create(io_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0666));
+        writer = new storage::TsFileTableWriter(&io_file, schema);
+    }
+    harness::TabletGenerator generator(data_types, specs, 42);
+    for (int t = 0; t < tablet_count; t++) {
+        storage::Tablet tablet(table_name, column_names, data_types, column_categories, tablet_rows);
+        ASSERT_EQ(E_OK, generator.fill(tablet, tablet_rows));
+        ASSERT_EQ(E_OK, writer->write_table(tablet));
+        harness::IoPhaseScope phase(harness::IoPhase::FLUSH);
+        ASSERT_EQ(E_OK, writer->flush());
+    }
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::CLOSE);
+        ASSERT_EQ(E_OK, writer->close());
+    }
+    delete writer;
+    delete schema;
+    harness::IoReport write_report = accounting.report();
+    cout << "write:" << endl;
+    harness::print_io_report(write_report, "  ");
+    uint64_t file_size = harness::file_size_bytes(io_file_path);
+    ASSERT_EQ(write_report.total().opens, 1u);
+    ASSERT_GT(write_report.phase(harness::IoPhase::FLUSH).writes, 0u);
+    ASSERT_GE(write_report.total().write_bytes, file_size);
+    ASSERT_EQ(write_report.total().reads, 0u);
+
+    // 查询中间一个 tablet 的时间范围
+    int64_t start_time = static_cast<int64_t>(tablet_count / 2) * tablet_rows;
+    int64_t end_time = start_time + tablet_rows - 1;
+    storage::TsFileReader reader;
+    storage::ResultSet* temp_ret = nullptr;
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::OPEN);
+        ASSERT_EQ(E_OK, reader.open(io_file_path));
+    }
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::QUERY);
+        ASSERT_EQ(E_OK, reader.query(table_name, column_names, start_time, end_time, temp_ret));
+    }
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ScanStats scan;
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::NEXT);
+        ASSERT_EQ(E_OK, harness::scan_table_rows(ret, scan, harness::Stopwatch()));
+    }
+    {
+        harness::IoPhaseScope phase(harness::IoPhase::CLOSE);
+        ret->close();
+        ASSERT_EQ(E_OK, reader.close());
+    }
+    accounting.disable();
+    harness::IoReport read_report = accounting.report().since(write_report);
+    cout << "read:" << endl;
+    harness::print_io_report(read_report, "  ");
+    harness::print_io_sizes(read_report.total(), "  ");
+    ASSERT_EQ(scan.rows, tablet_rows);
+    ASSERT_EQ(read_report.total().writes, 0u);
+    ASSERT_EQ(read_report.total().opens, read_report.total().closes);
+    // 查询和读取数据阶段读取的字节数不超过文件大小的 20%（50 个 chunk group 中只有 1 个满足条件）
+    uint64_t query_bytes = read_report.phase(harness::IoPhase::QUERY).read_bytes +
+                           read_report.phase(harness::IoPhase::NEXT).read_bytes;
+    cout << "query_bytes=" << query_bytes << " file_size=" << file_size << endl;
+    ASSERT_GT(query_bytes, 0u);
+    ASSERT_LT(query_bytes, file_size / 5);
+    std::filesystem::remove(io_file_path);
+}
+
+// 测试17：时间范围下推，一天的数据中开始、中间、结束位置的 5 分钟窗口只读出窗口内的行，且只读取文件的一小部分
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterTimeRangePushdown) {
+    // 10 个设备，每 10 秒一个点，每小时 flush 一次（每个设备 24 个 chunk group）
+    harness::TimeSeriesDatasetConfig config;
+    config.devices = 10;
+    config.field_count = 2;
+    config.interval = 10 * 1000;
+    string window_file_path = table_file_path + ".window.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_time_series_dataset(window_file_path, config, stats));
+    vector<string> columns = harness::time_series_schema(config).column_names;
+    harness::IoAccounting& accounting = harness::IoAccounting::instance();
+    accounting.enable(window_file_path);
+
+    int64_t width = 5 * 60 * 1000;
+    for (const string position : {"start", "middle", "end", "before", "after"}) {
+        int64_t start_time = 0;
+        int64_t end_time = 0;
+        ASSERT_TRUE(harness::time_window(config, position, width, start_time, end_time));
+        harness::WindowQueryResult result;
+        ASSERT_EQ(E_OK, harness::run_window_query(window_file_path, config.table_name, columns,
+                                                  start_time, end_time, result));
+        int64_t expected_rows = harness::time_window_expected_rows(config, start_time, end_time);
+        uint64_t query_bytes = result.io.phase(harness::IoPhase::QUERY).read_bytes +
+                               result.io.phase(harness::IoPhase::NEXT).read_bytes;
+        cout << position << ": rows=" << result.scan.rows << " query_bytes=" << query_bytes
+             << " file_size=" << stats.file_bytes << endl;
+        ASSERT_EQ(result.scan.rows, expected_rows);
+        if (expected_rows > 0) {
+            // 窗口内 30 个时间点，中间位置的窗口跨越两个 flush 的时间段
+            ASSERT_EQ(expected_rows, config.devices * 30);
+            ASSERT_GE(result.scan.min_time, start_time);
+            ASSERT_LE(result.scan.max_time, end_time);
+        }
+        ASSERT_LT(query_bytes, stats.file_bytes / 5);
+    }
+    accounting.disable();
+    std::filesystem::remove(window_file_path);
+}
+
+// 测试18：TAG 条件（等值、IN、前缀、正则、多条件）下推查询的结果与客户端过滤一致，等值查询只读取少量数据
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterTagFilter) {
+    // 100 个设备（tag0_<i>、tag1_<i>），每个设备 1000 行
+    harness::TableDatasetConfig config;
+    config.table_name = "table_tag_filter";
+    config.rows = 100000;
+    config.tag_count = 2;
+    config.field_count = 2;
+    config.tag_cardinality = 100;
+    string tag_file_path = table_file_path + ".tag.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(tag_file_path, config, stats));
+    vector<string> columns = harness::dataset_schema(config).column_names;
+    harness::IoAccounting& accounting = harness::IoAccounting::instance();
+    accounting.enable(tag_file_path);
+
+    const vector<pair<string, vector<harness::TagPredicate>>> queries = {
+        {"eq", {harness::TagPredicate::eq("tag0", "tag0_42")}},
+        {"in", {harness::TagPredicate::in("tag0", {"tag0_1", "tag0_2", "tag0_3"})}},
+        {"prefix", {harness::TagPredicate::prefix("tag0", "tag0_1")}},
+        {"regex", {harness::TagPredicate::regex("tag0", "^tag0_[0-9]*7$")}},
+        {"and", {harness::TagPredicate::prefix("tag0", "tag0_1"),
+                 harness::TagPredicate::eq("tag1", "tag1_15")}},
+        {"missing", {harness::TagPredicate::eq("tag0", "tag0_100")}},
+    };
+    // 满足条件的设备数：1、3、11（1 和 10~19）、10（个位为 7）、1、0
+    const vector<int64_t> expected_devices = {1, 3, 11, 10, 1, 0};
+    harness::TagQueryResult full;
+    ASSERT_EQ(E_OK, harness::run_tag_query(tag_file_path, config.table_name, columns, {}, true, full));
+    ASSERT_EQ(full.scan.rows, config.rows);
+    for (size_t q = 0; q < queries.size(); q++) {
+        harness::TagQueryResult pushdown;
+        harness::TagQueryResult client;
+        ASSERT_EQ(E_OK, harness::run_tag_query(tag_file_path, config.table_name, columns,
+                                               queries[q].second, true, pushdown));
+        ASSERT_EQ(E_OK, harness::run_tag_query(tag_file_path, config.table_name, columns,
+                                               queries[q].second, false, client));
+        cout << queries[q].first << ": rows=" << pushdown.scan.rows
+             << " read_bytes=" << pushdown.io.total().read_bytes
+             << " full_scan_read_bytes=" << full.io.total().read_bytes << endl;
+        ASSERT_EQ(pushdown.scan.rows, expected_devices[q] * config.rows / config.tag_cardinality);
+        ASSERT_EQ(pushdown.scan.rows, client.scan.rows);
+        if (pushdown.scan.rows > 0) {
+            ASSERT_EQ(pushdown.scan.min_time, client.scan.min_time);
+            ASSERT_EQ(pushdown.scan.max_time, client.scan.max_time);
+        }
+    }
+
+    // 等值查询跳过其他设备：读取的字节数小于全表扫描的 20%
+    harness::TagQueryResult eq;
+    ASSERT_EQ(E_OK, harness::run_tag_query(tag_file_path, config.table_name, columns,
+                                           queries[0].second, true, eq));
+    ASSERT_LT(eq.io.total().read_bytes, full.io.total().read_bytes / 5);
+
+    // 条件中的列不存在
+    harness::TagQueryResult invalid;
+    ASSERT_EQ(harness::kTagQueryError,
+              harness::run_tag_query(tag_file_path, config.table_name, columns,
+                                     {harness::TagPredicate::eq("no_such_tag", "x")}, true, invalid));
+    accounting.disable();
+    std::filesystem::remove(tag_file_path);
+}
+
+// 测试19：内存映射读取模式与 pread 读取的结果一致，读取器的 pread 由内存映射处理
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterMmapRead) {
+    harness::TableDatasetConfig config;
+    config.table_name = "table_mmap";
+    config.rows = 100000;
+    config.field_count = 4;
+    config.type_name = "MIXED";
+    string mmap_file_path = table_file_path + ".mmap.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(mmap_file_path, config, stats));
+    vector<string> columns = harness::dataset_schema(config).column_names;
+
+    // 全表扫描和窄时间范围查询
+    const vector<pair<int64_t, int64_t>> ranges = {{INT64_MIN, INT64_MAX}, {100, 199}};
+    vector<harness::WindowQueryResult> expected(ranges.size());
+    for (size_t r = 0; r < ranges.size(); r++) {
+        ASSERT_EQ(E_OK, harness::run_window_query(mmap_file_path, config.table_name, columns,
+                                                  ranges[r].first, ranges[r].second, expected[r]));
+    }
+    ASSERT_EQ(expected[0].scan.rows, config.rows);
+
+    harness::MmapReadMode& mmap_mode = harness::MmapReadMode::instance();
+    mmap_mode.reset_counters();
+    for (harness::MmapAdvice advice : {harness::MmapAdvice::NORMAL, harness::MmapAdvice::SEQUENTIAL,
+                                       harness::MmapAdvice::RANDOM, harness::MmapAdvice::WILLNEED}) {
+        mmap_mode.enable(mmap_file_path, advice);
+        for (size_t r = 0; r < ranges.size(); r++) {
+            harness::WindowQueryResult result;
+            ASSERT_EQ(E_OK, harness::run_window_query(mmap_file_path, config.table_name, columns,
+                                                      ranges[r].first, ranges[r].second, result));
+            ASSERT_EQ(result.scan.rows, expected[r].scan.rows);
+            ASSERT_EQ(result.scan.null_cells, expected[r].scan.null_cells);
+            ASSERT_EQ(result.scan.checksum, expected[r].scan.checksum);
+            ASSERT_EQ(result.scan.min_time, expected[r].scan.min_time);
+            ASSERT_EQ(result.scan.max_time, expected[r].scan.max_time);
+        }
+    }
+    mmap_mode.disable();
+    cout << "mapped_files=" << mmap_mode.mapped_files() << " served_reads=" << mmap_mode.served_reads()
+         << " served_bytes=" << mmap_mode.served_bytes() << endl;
+    ASSERT_GT(mmap_mode.mapped_files(), 0u);
+    ASSERT_GT(mmap_mode.served_reads(), 0u);
+    ASSERT_GT(mmap_mode.served_bytes(), 0u);
+    std::filesystem::remove(mmap_file_path);
+}
+
+// 测试20：按批读取时变长列的值存放在复用的字节区中，按视图读取的值和空值与逐行读取一致
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterStringArena) {
+    harness::TableDatasetConfig config;
+    config.table_name = "table_string_arena";
+    config.rows = 10000;
+    config.tag_count = 2;
+    config.field_count = 4;
+    config.type_name = "STRING";
+    config.field_shape = "ZIPF";
+    config.null_rate = 0.2;
+    string arena_file_path = table_file_path + ".arena.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(arena_file_path, config, stats));
+    vector<string> columns = harness::dataset_schema(config).column_names;
+    uint32_t column_count = static_cast<uint32_t>(columns.size()) + 1;
+
+    // 逐行读取全部字符串，空值记为 nullopt
+    vector<vector<std::optional<string>>> expected(column_count + 1);
+    {
+        storage::TsFileReader reader;
+        ASSERT_EQ(E_OK, reader.open(arena_file_path));
+        storage::ResultSet* temp_ret = nullptr;
+        ASSERT_EQ(E_OK, reader.query(config.table_name, columns, INT64_MIN, INT64_MAX, temp_ret));
+        auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+        bool has_next = false;
+        while (ret->next(has_next) == E_OK && has_next) {
+            for (uint32_t i = 2; i <= column_count; i++) {
+                if (ret->is_null(i)) {
+                    expected[i].push_back(std::nullopt);
+                } else {
+                    expected[i].push_back(ret->get_value<common::String*>(i)->to_std_string());
+                }
+            }
+        }
+        ret->close();
+        ASSERT_EQ(E_OK, reader.close());
+    }
+    ASSERT_EQ(static_cast<int64_t>(expected[2].size()), config.rows);
+
+    // 按批读取，批大小不整除行数
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(arena_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(config.table_name, columns, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ColumnBatchReader batch_reader(ret);
+    harness::ColumnBatch batch = batch_reader.create_batch(333);
+    size_t row = 0;
+    int64_t null_cells = 0;
+    while (batch_reader.next_batch(batch) == E_OK && batch.row_count() > 0) {
+        for (uint32_t c = 2; c <= column_count; c++) {
+            const int32_t* offsets = batch.string_offsets(c);
+            ASSERT_EQ(offsets[0], 0);
+            for (uint32_t r = 0; r < batch.row_count(); r++) {
+                const std::optional<string>& value = expected[c][row + r];
+                ASSERT_EQ(batch.is_null(c, r), !value.has_value());
+                if (batch.is_null(c, r)) {
+                    null_cells++;
+                    ASSERT_TRUE(batch.string_value(c, r).empty());
+                } else {
+                    ASSERT_EQ(batch.string_value(c, r), *value);
+                }
+                ASSERT_EQ(static_cast<size_t>(offsets[r + 1] - offsets[r]),
+                          batch.string_value(c, r).size());
+                ASSERT_EQ(batch.string_data(c) + offsets[r], batch.string_value(c, r).data());
+            }
+        }
+        row += batch.row_count();
+    }
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(static_cast<int64_t>(row), config.rows);
+    // TAG 列无空值，FIELD 列空值比例约为 20%
+    double null_rate = static_cast<double>(null_cells) / (config.rows * config.field_count);
+    ASSERT_GT(null_rate, 0.15);
+    ASSERT_LT(null_rate, 0.25);
+    std::filesystem::remove(arena_file_path);
+}
+
+// 分配预算：稳态写入每个数据点、按批读取每行的分配次数和分配字节数上限（见 harness/alloc_counter.h）
+// 库按页、按 chunk 分配缓冲区，摊到每个数据点远小于上限；出现逐行分配时超出预算
+const harness::AllocBudget kSteadyWriteBudget = {0.05, 64, 0};
+const harness::AllocBudget kBatchReadBudget = {0.05, 256, 0};
+
+// 测试21：稳态写入和按批读取的分配次数、分配字节数不超过预算，关闭分配计数时跳过
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterAllocBudget) {
+    if (!harness::AllocCounter::installed()) {
+        GTEST_SKIP() << "alloc counter is disabled (ENABLE_ALLOC_COUNTER=OFF)";
+    }
+    harness::TableDatasetConfig config;
+    config.table_name = "table_alloc_budget";
+    config.rows = 64 * 1024;
+    config.tablet_rows = 1024;
+    config.tag_count = 1;
+    config.field_count = 4;
+    config.type_name = "INT64";
+    config.tag_cardinality = 16;
+    string alloc_file_path = table_file_path + ".alloc.tsfile";
+    harness::TableDatasetSchema dataset = harness::dataset_schema(config);
+    vector<TSDataType> field_types = harness::dataset_field_types(config);
+    harness::DatasetValuePool pool = harness::dataset_value_pool(config);
+
+    // 预先构造全部 tablet，写入阶段只统计 write_table 的分配
+    vector<unique_ptr<Tablet>> tablets;
+    for (int64_t start = 0; start < config.rows; start += config.tablet_rows) {
+        tablets.push_back(std::make_unique<Tablet>(config.table_name, dataset.column_names,
+                                                   dataset.data_types, dataset.column_categories,
+                                                   static_cast<int>(config.tablet_rows)));
+        ASSERT_EQ(E_OK, harness::dataset_fill_tablet(*tablets.back(), config, pool, field_types,
+                                                     start, config.tablet_rows));
+    }
+
+    storage::WriteFile file;
+    ASSERT_EQ(E_OK, file.create(alloc_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0666));
+    auto* schema = new TableSchema(config.table_name, dataset.column_schemas);
+    auto* writer = new TsFileTableWriter(&file, schema);
+    // 第一个 tablet 创建写入器内部的结构，之后为稳态写入
+    harness::AllocStats warmup;
+    {
+        harness::AllocScope scope;
+        ASSERT_EQ(E_OK, writer->write_table(*tablets[0]));
+        warmup = scope.stats();
+    }
+    ASSERT_GT(warmup.allocations, 0u);
+    harness::AllocStats steady;
+    {
+        harness::AllocScope scope;
+        for (size_t i = 1; i < tablets.size(); i++) {
+            ASSERT_EQ(E_OK, writer->write_table(*tablets[i]));
+        }
+        steady = scope.stats();
+    }
+    double points = static_cast<double>(config.rows - config.tablet_rows) * config.field_count;
+    string message;
+    EXPECT_TRUE(harness::check_alloc_budget(steady, points, kSteadyWriteBudget, message))
+        << "steady write: " << message;
+    ASSERT_EQ(E_OK, writer->flush());
+    ASSERT_EQ(E_OK, writer->close());
+    delete writer;
+    delete schema;
+    tablets.clear();
+
+    // 按批读取：第一批之后为稳态读取
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(alloc_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(config.table_name, dataset.column_names, INT64_MIN, INT64_MAX,
+                                 temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ColumnBatchReader batch_reader(ret);
+    harness::ColumnBatch batch = batch_reader.create_batch(1024);
+    ASSERT_EQ(E_OK, batch_reader.next_batch(batch));
+    int64_t first_rows = batch.row_count();
+    int64_t rows = first_rows;
+    harness::AllocStats read;
+    {
+        harness::AllocScope scope;
+        while (batch_reader.next_batch(batch) == E_OK && batch.row_count() > 0) {
+            rows += batch.row_count();
+        }
+        read = scope.stats();
+    }
+    ASSERT_EQ(rows, config.rows);
+    EXPECT_TRUE(harness::check_alloc_budget(read, static_cast<double>(rows - first_rows),
+                                            kBatchReadBudget, message))
+        << "batch read: " << message;
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    std::filesystem::remove(alloc_file_path);
+}
+
+// 测试22：多线程分块导入 CSV，推断列类型并处理空值、引号和转义，读回的取值与源文件一致，无法解析的值报告偏移
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterCsvLoad) {
+    // 5 个设备，temperature 每 7 行一个空值，note 含分隔符和转义的引号
+    const int64_t rows = 5000;
+    string csv_path = table_file_path + ".load.csv";
+    string load_file_path = table_file_path + ".load.tsfile";
+    {
+        std::ofstream csv(csv_path);
+        csv << "time,device,temperature,count,ok,note\r\n";
+        for (int64_t i = 0; i < rows; i++) {
+            csv << i / 5 << ",dev" << i % 5 << ",";
+            if (i % 7 != 0) {
+                csv << i * 0.25;
+            }
+            csv << "," << i << "," << (i % 2 == 0 ? "true" : "false") << ",\"a \"\"" << i
+                << "\"\", b\"\r\n";
+        }
+    }
+
+    harness::CsvLoadConfig config;
+    config.table_name = "table_csv_load";
+    config.tag_columns = {"device"};
+    config.block_bytes = 4096;
+    config.tablet_rows = 100;
+    config.threads = 4;
+    harness::CsvLoader loader(config);
+    ASSERT_EQ(E_OK, loader.open(csv_path)) << loader.error();
+    const vector<TSDataType> expected_types = {TSDataType::STRING, TSDataType::DOUBLE,
+                                               TSDataType::INT64, TSDataType::BOOLEAN,
+                                               TSDataType::STRING};
+    ASSERT_EQ(loader.columns().size(), expected_types.size());
+    for (size_t i = 0; i < expected_types.size(); i++) {
+        ASSERT_EQ(loader.columns()[i].type, expected_types[i]);
+        ASSERT_EQ(loader.columns()[i].category,
+                  i == 0 ? ColumnCategory::TAG : ColumnCategory::FIELD);
+    }
+    harness::CsvLoadStats stats;
+    ASSERT_EQ(E_OK, loader.load(load_file_path, stats)) << loader.error();
+    ASSERT_EQ(stats.rows, rows);
+    ASSERT_GT(stats.blocks, 1u);
+
+    // 读回：行数、count 之和、temperature 空值数、ok 为 true 的行数、note 的值
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(load_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    vector<string> columns = {"device", "temperature", "count", "ok", "note"};
+    ASSERT_EQ(E_OK, reader.query(config.table_name, columns, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    int64_t read_rows = 0;
+    int64_t count_sum = 0;
+    int64_t null_temperatures = 0;
+    int64_t true_rows = 0;
+    bool has_next = false;
+    while (ret->next(has_next) == E_OK && has_next) {
+        int64_t count = ret->get_value<int64_t>(4);
+        ASSERT_EQ(ret->get_value<int64_t>(1), count / 5);
+        ASSERT_EQ(ret->get_value<common::String*>(2)->to_std_string(), "dev" + to_string(count % 5));
+        if (ret->is_null(3)) {
+            null_temperatures++;
+        } else {
+            ASSERT_DOUBLE_EQ(ret->get_value<double>(3), count * 0.25);
+        }
+        true_rows += ret->get_value<bool>(5) ? 1 : 0;
+        ASSERT_EQ(ret->get_value<common::String*>(6)->to_std_string(),
+                  "a \"" + to_string(count) + "\", b");
+        count_sum += count;
+        read_rows++;
+    }
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(read_rows, rows);
+    ASSERT_EQ(count_sum, rows * (rows - 1) / 2);
+    ASSERT_EQ(null_temperatures, (rows + 6) / 7);
+    ASSERT_EQ(true_rows, rows / 2);
+
+    // 抽样（前 1000 行）之后出现无法解析的值：返回 kCsvLoadError，说明中包含出错行的偏移
+    {
+        std::ofstream csv(csv_path);
+        csv << "time,value\n";
+        for (int64_t i = 0; i < 2000; i++) {
+            csv << i << "," << (i == 1500 ? "bad" : to_string(i)) << "\n";
+        }
+    }
+    // 指定的 TAG 列不存在
+    harness::CsvLoader missing_tag_loader(config);
+    ASSERT_EQ(harness::kCsvLoadError, missing_tag_loader.open(csv_path));
+    config.tag_columns.clear();
+    harness::CsvLoader invalid_loader(config);
+    ASSERT_EQ(E_OK, invalid_loader.open(csv_path));
+    ASSERT_EQ(harness::kCsvLoadError, invalid_loader.load(load_file_path, stats));
+    ASSERT_NE(invalid_loader.error().find("offset"), string::npos);
+    std::filesystem::remove(csv_path);
+    std::filesystem::remove(load_file_path);
+}
+
+// 测试23：并行导出为 CSV（按表、按设备分组）和按列二进制格式，导出的行与写入一致，表不存在时返回 kTableExportError
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterExport) {
+    // 20 个设备、多种类型轮换、10% 空值
+    harness::TableDatasetConfig config;
+    config.table_name = "table_export";
+    config.rows = 5000;
+    config.tablet_rows = 500;
+    config.tag_count = 2;
+    config.field_count = 8;
+    config.type_name = "MIXED";
+    config.tag_cardinality = 20;
+    config.null_rate = 0.1;
+    string export_file_path = table_file_path + ".export.tsfile";
+    harness::TableDatasetStats write_stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(export_file_path, config, write_stats));
+
+    // 读取目录中全部 CSV 文件的数据行（检查并去掉表头），排序后返回
+    auto read_csv_rows = [](const string& dir, size_t& files) {
+        vector<string> lines;
+        files = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            std::ifstream in(entry.path());
+            string line;
+            EXPECT_TRUE(std::getline(in, line));
+            EXPECT_EQ(line.rfind("time,tag0,tag1,s0", 0), 0u);
+            while (std::getline(in, line)) {
+                lines.push_back(line);
+            }
+            files++;
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    };
+
+    harness::TableExportConfig export_config;
+    export_config.threads = 4;
+    export_config.batch_rows = 300;
+    export_config.buffer_bytes = 4096;
+    export_config.devices_per_task = 3;
+    string table_dir = table_file_path + ".export.table";
+    string device_dir = table_file_path + ".export.device";
+    string columnar_dir = table_file_path + ".export.columnar";
+    for (const string& dir : {table_dir, device_dir, columnar_dir}) {
+        std::filesystem::create_directories(dir);
+    }
+
+    // 按表导出：一个文件，行数与写入一致
+    harness::TableExportStats table_stats;
+    harness::TableExporter table_exporter(export_file_path, export_config);
+    ASSERT_EQ(E_OK, table_exporter.run(table_dir, table_stats)) << table_exporter.error();
+    size_t table_files = 0;
+    vector<string> table_rows = read_csv_rows(table_dir, table_files);
+    ASSERT_EQ(table_files, 1u);
+    ASSERT_EQ(table_stats.rows, config.rows);
+    ASSERT_EQ(static_cast<int64_t>(table_rows.size()), config.rows);
+
+    // 按设备分组导出：20 个设备每 3 个一个文件，数据行与按表导出相同
+    export_config.partition = harness::ExportPartition::DEVICE;
+    harness::TableExportStats device_stats;
+    harness::TableExporter device_exporter(export_file_path, export_config);
+    ASSERT_EQ(E_OK, device_exporter.run(device_dir, device_stats)) << device_exporter.error();
+    size_t device_files = 0;
+    vector<string> device_rows = read_csv_rows(device_dir, device_files);
+    ASSERT_EQ(device_files, 7u);
+    ASSERT_EQ(device_stats.tasks, 7);
+    ASSERT_EQ(device_rows, table_rows);
+
+    // 按列二进制格式：解析文件头和每批的行数，列数为时间列加全部列
+    export_config.partition = harness::ExportPartition::TABLE;
+    export_config.format = harness::ExportFormat::COLUMNAR;
+    harness::TableExportStats columnar_stats;
+    harness::TableExporter columnar_exporter(export_file_path, export_config);
+    ASSERT_EQ(E_OK, columnar_exporter.run(columnar_dir, columnar_stats))
+        << columnar_exporter.error();
+    std::ifstream in(columnar_dir + "/" + config.table_name + ".tscb", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(data.size(), columnar_stats.output_bytes);
+    ASSERT_EQ(data.substr(0, 4), "TSCB");
+    size_t pos = 4;
+    auto read_u32 = [&](uint32_t& value) {
+        ASSERT_LE(pos + 4, data.size());
+        std::memcpy(&value, data.data() + pos, 4);
+        pos += 4;
+    };
+    uint32_t version = 0;
+    uint32_t column_count = 0;
+    read_u32(version);
+    read_u32(column_count);
+    ASSERT_EQ(version, 1u);
+    ASSERT_EQ(column_count, static_cast<uint32_t>(1 + config.tag_count + config.field_count));
+    vector<uint32_t> widths;
+    for (uint32_t c = 0; c < column_count; c++) {
+        auto type = static_cast<TSDataType>(static_cast<uint8_t>(data[pos++]));
+        uint32_t name_size = 0;
+        read_u32(name_size);
+        pos += name_size;
+        widths.push_back(harness::ColumnBatch::value_width(type));
+    }
+    ASSERT_EQ(widths[0], sizeof(int64_t));
+    int64_t columnar_rows = 0;
+    while (pos < data.size()) {
+        uint32_t rows = 0;
+        read_u32(rows);
+        ASSERT_GT(rows, 0u);
+        for (uint32_t c = 0; c < column_count; c++) {
+            pos += (rows + 7) / 8;
+            if (widths[c] > 0) {
+                pos += static_cast<size_t>(rows) * widths[c];
+            } else {
+                ASSERT_LE(pos + (rows + 1) * 4, data.size());
+                int32_t end = 0;
+                std::memcpy(&end, data.data() + pos + rows * 4, sizeof(end));
+                pos += (rows + 1) * 4 + static_cast<size_t>(end);
+            }
+        }
+        ASSERT_LE(pos, data.size());
+        columnar_rows += rows;
+    }
+    ASSERT_EQ(columnar_rows, config.rows);
+
+    // 表不存在
+    export_config.tables = {"missing_table"};
+    harness::TableExporter missing_exporter(export_file_path, export_config);
+    ASSERT_EQ(harness::kTableExportError, missing_exporter.run(columnar_dir, columnar_stats));
+
+    for (const string& dir : {table_dir, device_dir, columnar_dir}) {
+        std::filesystem::remove_all(dir);
+    }
+    std::filesystem::remove(export_file_path);
+}
+
+// 测试24：按 Arrow C 数据接口分批导出查询结果，格式、空值位图和取值与逐行读取一致，子数组移出后可单独释放
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterArrowExport) {
+    // 多种类型轮换（含 BOOLEAN、STRING）、10% 空值
+    harness::TableDatasetConfig config;
+    config.table_name = "table_arrow";
+    config.rows = 3000;
+    config.tag_count = 2;
+    config.field_count = 6;
+    config.type_name = "MIXED";
+    config.tag_cardinality = 10;
+    config.null_rate = 0.1;
+    string arrow_file_path = table_file_path + ".arrow.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(arrow_file_path, config, stats));
+    harness::TableDatasetSchema schema = harness::dataset_schema(config);
+    uint32_t column_count = static_cast<uint32_t>(schema.column_names.size()) + 1;
+
+    // 逐行读取，每个单元格转换为文本，空值记为 nullopt
+    vector<vector<std::optional<string>>> expected(column_count);
+    {
+        storage::TsFileReader reader;
+        ASSERT_EQ(E_OK, reader.open(arrow_file_path));
+        storage::ResultSet* temp_ret = nullptr;
+        ASSERT_EQ(E_OK, reader.query(config.table_name, schema.column_names, INT64_MIN, INT64_MAX,
+                                     temp_ret));
+        auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+        auto metadata = ret->get_metadata();
+        bool has_next = false;
+        while (ret->next(has_next) == E_OK && has_next) {
+            for (uint32_t i = 1; i <= column_count; i++) {
+                std::optional<string> value;
+                if (!ret->is_null(i)) {
+                    switch (metadata->get_column_type(i)) {
+                        case TSDataType::BOOLEAN:
+                            value = to_string(ret->get_value<bool>(i));
+                            break;
+                        case TSDataType::INT32:
+                            value = to_string(ret->get_value<int32_t>(i));
+                            break;
+                        case TSDataType::INT64:
+                            value = to_string(ret->get_value<int64_t>(i));
+                            break;
+                        case TSDataType::FLOAT:
+                            value = to_string(ret->get_value<float>(i));
+                            break;
+                        case TSDataType::DOUBLE:
+                            value = to_string(ret->get_value<double>(i));
+                            break;
+                        default:
+                            value = ret->get_value<common::String*>(i)->to_std_string();
+                            break;
+                    }
+                }
+                expected[i - 1].push_back(value);
+            }
+        }
+        ret->close();
+        ASSERT_EQ(E_OK, reader.close());
+    }
+    ASSERT_EQ(static_cast<int64_t>(expected[0].size()), config.rows);
+
+    // 按 ArrowArrayStream 读取，批大小不整除行数
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(arrow_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(config.table_name, schema.column_names, INT64_MIN, INT64_MAX,
+                                 temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    ArrowArrayStream stream;
+    harness::export_arrow_stream(ret, 333, &stream);
+    ArrowSchema arrow_schema;
+    ASSERT_EQ(0, stream.get_schema(&stream, &arrow_schema));
+    ASSERT_STREQ(arrow_schema.format, "+s");
+    ASSERT_EQ(arrow_schema.n_children, static_cast<int64_t>(column_count));
+    ASSERT_STREQ(arrow_schema.children[0]->name, "time");
+    ASSERT_STREQ(arrow_schema.children[0]->format, "tsm:");
+    for (uint32_t c = 1; c < column_count; c++) {
+        ASSERT_STREQ(arrow_schema.children[c]->format,
+                     harness::arrow_format(schema.data_types[c - 1]));
+    }
+
+    size_t row = 0;
+    int64_t null_cells = 0;
+    ArrowArray last_string_column;
+    last_string_column.release = nullptr;
+    while (true) {
+        ArrowArray array;
+        ASSERT_EQ(0, stream.get_next(&stream, &array));
+        if (array.release == nullptr) {
+            break;
+        }
+        ASSERT_EQ(array.n_children, static_cast<int64_t>(column_count));
+        for (uint32_t c = 0; c < column_count; c++) {
+            const ArrowArray* child = array.children[c];
+            ASSERT_EQ(child->length, array.length);
+            const auto* validity = static_cast<const uint8_t*>(child->buffers[0]);
+            const string format = arrow_schema.children[c]->format;
+            int64_t child_nulls = 0;
+            for (int64_t r = 0; r < child->length; r++) {
+                const std::optional<string>& value = expected[c][row + r];
+                bool valid = validity == nullptr || ((validity[r >> 3] >> (r & 7)) & 1);
+                ASSERT_EQ(valid, value.has_value());
+                if (!valid) {
+                    child_nulls++;
+                    continue;
+                }
+                string actual;
+                if (format == "b") {
+                    actual = to_string(
+                        (static_cast<const uint8_t*>(child->buffers[1])[r >> 3] >> (r & 7)) & 1);
+                } else if (format == "i") {
+                    actual = to_string(static_cast<const int32_t*>(child->buffers[1])[r]);
+                } else if (format == "l" || format == "tsm:") {
+                    actual = to_string(static_cast<const int64_t*>(child->buffers[1])[r]);
+                } else if (format == "f") {
+                    actual = to_string(static_cast<const float*>(child->buffers[1])[r]);
+                } else if (format == "g") {
+                    actual = to_string(static_cast<const double*>(child->buffers[1])[r]);
+                } else {
+                    const auto* offsets = static_cast<const int32_t*>(child->buffers[1]);
+                    actual.assign(static_cast<const char*>(child->buffers[2]) + offsets[r],
+                                  offsets[r + 1] - offsets[r]);
+                }
+                ASSERT_EQ(actual, *value);
+            }
+            ASSERT_EQ(child->null_count, child_nulls);
+            null_cells += child_nulls;
+        }
+        // 移出最后一个字符串列，父数组释放后仍然有效
+        if (last_string_column.release != nullptr) {
+            last_string_column.release(&last_string_column);
+        }
+        last_string_column = *array.children[column_count - 1];
+        array.children[column_count - 1]->release = nullptr;
+        array.release(&array);
+        ASSERT_EQ(array.release, nullptr);
+        row += last_string_column.length;
+    }
+    arrow_schema.release(&arrow_schema);
+    stream.release(&stream);
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(static_cast<int64_t>(row), config.rows);
+    ASSERT_GT(null_cells, 0);
+
+    // 最后一批的字符串列在结果集关闭后仍可读取
+    ASSERT_NE(last_string_column.release, nullptr);
+    const auto* offsets = static_cast<const int32_t*>(last_string_column.buffers[1]);
+    int64_t last = last_string_column.length - 1;
+    if (expected[column_count - 1].back().has_value()) {
+        ASSERT_EQ(string(static_cast<const char*>(last_string_column.buffers[2]) + offsets[last],
+                         offsets[last + 1] - offsets[last]),
+                  *expected[column_count - 1].back());
+    }
+    last_string_column.release(&last_string_column);
+
+    // DATE 转换为 1970-01-01 起的天数
+    ASSERT_EQ(harness::date_to_epoch_days(19700101), 0);
+    ASSERT_EQ(harness::date_to_epoch_days(20000301), 11017);
+    ASSERT_EQ(harness::date_to_epoch_days(19691231), -1);
+    std::filesystem::remove(arrow_file_path);
+}
+
+// 逐行读取表的全部列（第 0 列为时间列），每个单元格转换为文本，空值记为 nullopt
+void read_table_as_text(const string& file_path, const string& table_name,
+                        const vector<string>& columns,
+                        vector<vector<std::optional<string>>>& cells) {
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(table_name, columns, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    auto metadata = ret->get_metadata();
+    uint32_t column_count = metadata->get_column_count();
+    cells.assign(column_count, {});
+    bool has_next = false;
+    while (ret->next(has_next) == E_OK && has_next) {
+        for (uint32_t i = 1; i <= column_count; i++) {
+            std::optional<string> value;
+            if (!ret->is_null(i)) {
+                switch (metadata->get_column_type(i)) {
+                    case TSDataType::BOOLEAN:
+                        value = to_string(ret->get_value<bool>(i));
+                        break;
+                    case TSDataType::INT32:
+                        value = to_string(ret->get_value<int32_t>(i));
+                        break;
+                    case TSDataType::INT64:
+                        value = to_string(ret->get_value<int64_t>(i));
+                        break;
+                    case TSDataType::FLOAT:
+                        value = to_string(ret->get_value<float>(i));
+                        break;
+                    case TSDataType::DOUBLE:
+                        value = to_string(ret->get_value<double>(i));
+                        break;
+                    default:
+                        value = ret->get_value<common::String*>(i)->to_std_string();
+                        break;
+                }
+            }
+            cells[i - 1].push_back(value);
+        }
+    }
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+}
+
+// 测试25：按批读取含空值的数据后，以批的空值位图按列批量写回 tablet，写出的文件与原文件的取值和空值位置一致
+TEST_F(TsFileWriterTableTest, TestTsFileTableWriterBatchToTablet) {
+    // 多种类型轮换（含 BOOLEAN、STRING）、20% 空值
+    harness::TableDatasetConfig config;
+    config.table_name = "table_batch_tablet";
+    config.rows = 3000;
+    config.tag_count = 2;
+    config.field_count = 6;
+    config.type_name = "MIXED";
+    config.tag_cardinality = 10;
+    config.null_rate = 0.2;
+    string source_file_path = table_file_path + ".batch_source.tsfile";
+    string copy_file_path = table_file_path + ".batch_copy.tsfile";
+    harness::TableDatasetStats stats;
+    ASSERT_EQ(E_OK, harness::write_table_dataset(source_file_path, config, stats));
+    harness::TableDatasetSchema dataset = harness::dataset_schema(config);
+    uint32_t column_count = static_cast<uint32_t>(dataset.column_names.size()) + 1;
+
+    // 按批读取原文件，每批写为一个 tablet，批大小不整除行数
+    storage::WriteFile file;
+    ASSERT_EQ(E_OK, file.create(copy_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0666));
+    auto* schema = new TableSchema(config.table_name, dataset.column_schemas);
+    auto* writer = new TsFileTableWriter(&file, schema);
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(source_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(config.table_name, dataset.column_names, INT64_MIN, INT64_MAX,
+                                 temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    harness::ColumnBatchReader batch_reader(ret);
+    harness::ColumnBatch batch = batch_reader.create_batch(700);
+    int64_t rows = 0;
+    int64_t null_cells = 0;
+    while (batch_reader.next_batch(batch) == E_OK && batch.row_count() > 0) {
+        uint32_t count = batch.row_count();
+        Tablet tablet(config.table_name, dataset.column_names, dataset.data_types,
+                      dataset.column_categories, static_cast<int>(count));
+        ASSERT_EQ(E_OK, harness::set_timestamps(tablet, 0, batch.values<int64_t>(1), count));
+        for (uint32_t c = 2; c <= column_count; c++) {
+            uint32_t index = c - 2;
+            const uint8_t* nulls = batch.null_bitmap(c);
+            for (uint32_t r = 0; r < count; r++) {
+                null_cells += harness::bitmap_is_null(nulls, r) ? 1 : 0;
+            }
+            int code = E_OK;
+            switch (batch.column_type(c)) {
+                case TSDataType::BOOLEAN:
+                    code = harness::append_column(tablet, index, 0, batch.values<bool>(c), count,
+                                                  nulls);
+                    break;
+                case TSDataType::INT32:
+                case TSDataType::DATE:
+                    code = harness::append_column(tablet, index, 0, batch.values<int32_t>(c),
+                                                  count, nulls);
+                    break;
+                case TSDataType::INT64:
+                case TSDataType::TIMESTAMP:
+                    code = harness::append_column(tablet, index, 0, batch.values<int64_t>(c),
+                                                  count, nulls);
+                    break;
+                case TSDataType::FLOAT:
+                    code = harness::append_column(tablet, index, 0, batch.values<float>(c), count,
+                                                  nulls);
+                    break;
+                case TSDataType::DOUBLE:
+                    code = harness::append_column(tablet, index, 0, batch.values<double>(c),
+                                                  count, nulls);
+                    break;
+                default:
+                    code = harness::append_column(tablet, index, 0, batch.string_data(c),
+                                                  batch.string_offsets(c), count, nulls);
+                    break;
+            }
+            ASSERT_EQ(E_OK, code);
+        }
+        ASSERT_EQ(E_OK, writer->write_table(tablet));
+        rows += count;
+    }
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    ASSERT_EQ(E_OK, writer->flush());
+    ASSERT_EQ(E_OK, writer->close());
+    delete writer;
+    delete schema;
+    ASSERT_EQ(rows, config.rows);
+    ASSERT_GT(null_cells, 0);
+
+    // 两个文件逐行读取的取值和空值位置一致
+    vector<vector<std::optional<string>>> expected;
+    vector<vector<std::optional<string>>> actual;
+    read_table_as_text(source_file_path, config.table_name, dataset.column_names, expected);
+    read_table_as_text(copy_file_path, config.table_name, dataset.column_names, actual);
+    ASSERT_EQ(expected.size(), static_cast<size_t>(column_count));
+    ASSERT_EQ(static_cast<int64_t>(expected[0].size()), config.rows);
+    for (uint32_t c = 0; c < column_count; c++) {
+        ASSERT_EQ(actual[c], expected[c]) << "column " << c;
+    }
+    std::filesystem::remove(source_file_path);
+    std::filesystem::remove(copy_file_path);
+}
+
+// 宽表测试参数：TAG 列数量、FIELD 列数量、行数
+struct WideSchemaParam {
+    size_t tag_count;
+    size_t field_count;
+    int max_rows;
+};
+
+// 参数名称，例如 tag2_field8_rows100，用作用例名的后缀
+string wide_schema_name(const WideSchemaParam& param) {
+    return "tag" + to_string(param.tag_count) + "_field" + to_string(param.field_count) + "_rows" +
+           to_string(param.max_rows);
+}
+
+// gtest 输出参数值（GetParam() 的打印形式，如失败信息中的 GetParam() = tag2_field8_rows100）
+void PrintTo(const WideSchemaParam& param, ostream* os) { *os << wide_schema_name(param); }
+
+// 宽表测试：每个用例前创建文件
+class TsFileWriterTableWideSchemaTest : public ::testing::TestWithParam<WideSchemaParam> {
+    protected:
+        // 在每个测试用例执行之前调用
+        void SetUp() override {
+            init_file_path_table();
+            storage::libtsfile_init();
+            int flags = O_WRONLY | O_CREAT | O_TRUNC;
+            mode_t mode = 0666;
+            writer_file_.create(table_file_path, flags, mode);
+        }
+};
+
+// 测试6~9：宽表扩展性（TAG 列和 FIELD 列从 10 列到 1 万列），统计各阶段耗时和峰值内存
+TEST_P(TsFileWriterTableWideSchemaTest, TestTsFileTableWriterWideSchema) {
+    const WideSchemaParam& param = GetParam();
+    string table_name = "table_wide"; // 表名
+    vector<string> column_names; // 列名
+    vector<common::TSDataType> data_types; // 数据类型
+    vector<common::ColumnCategory> column_categories; // 列类别
+    vector<common::ColumnSchema> column_schemas; // 列的元数据信息
+    // FIELD 列依次为 INT64、INT32、FLOAT、DOUBLE
+    const vector<common::TSDataType> field_types = {
+        common::TSDataType::INT64,
+        common::TSDataType::INT32,
+        common::TSDataType::FLOAT,
+        common::TSDataType::DOUBLE,
+    };
+    const vector<string> field_prefixes = {"int64_", "int32_", "float_", "double_"};
+    for (size_t i = 0; i < param.tag_count; i++) {
+        column_names.emplace_back("tag_" + to_string(i));
+        data_types.emplace_back(common::TSDataType::STRING);
+        column_categories.emplace_back(common::ColumnCategory::TAG);
+    }
+    for (size_t i = 0; i < param.field_count; i++) {
+        column_names.emplace_back(field_prefixes[i % 4] + to_string(i / 4));
+        data_types.emplace_back(field_types[i % 4]);
+        column_categories.emplace_back(common::ColumnCategory::FIELD);
+    }
+    vector<string> text_pool = {"tag"};
+    harness::reset_peak_rss();
+    harness::Stopwatch watch;
+
+    // 构建表的元数据
+    for (size_t i = 0; i < column_names.size(); i++) {
+        column_schemas.emplace_back(column_names[i], data_types[i], common::UNCOMPRESSED, common::PLAIN, column_categories[i]);
+    }
+    auto* schema = new storage::TableSchema(table_name, column_schemas);
+    double schema_s = watch.elapsed_s();
+
+    // 构建写入器
+    auto* writer = new storage::TsFileTableWriter(&writer_file_, schema);
+
+    // 创建 tablet 并按列下标填充数据
+    watch.reset();
+    storage::Tablet tablet(table_name, column_names, data_types, column_categories, param.max_rows);
+    int64_t timestamp = 0;
+    for (int row = 0; row < param.max_rows; row++) {
+        ASSERT_EQ(E_OK, tablet.add_timestamp(row, timestamp++));
+        for (size_t i = 0; i < column_names.size(); i++) {
+            ASSERT_EQ(E_OK, harness::dataset_fill_value(tablet, row, i, data_types[i], row, timestamp, text_pool));
+        }
+    }
+    double fill_s = watch.elapsed_s();
+
+    // 写入、刷新、关闭
+    watch.reset();
+    ASSERT_EQ(E_OK, writer->write_table(tablet));
+    double write_s = watch.elapsed_s();
+    watch.reset();
+    ASSERT_EQ(E_OK, writer->flush());
+    double flush_s = watch.elapsed_s();
+    watch.reset();
+    ASSERT_EQ(E_OK, writer->close());
+    double close_s = watch.elapsed_s();
+
+    // 释放动态分配的内存
+    delete writer;
+    delete schema;
+
+    // 查询全部列并验证行数
+    watch.reset();
+    storage::TsFileReader reader;
+    ASSERT_EQ(E_OK, reader.open(table_file_path));
+    storage::ResultSet* temp_ret = nullptr;
+    ASSERT_EQ(E_OK, reader.query(table_name, column_names, INT64_MIN, INT64_MAX, temp_ret));
+    auto ret = dynamic_cast<storage::TableResultSet*>(temp_ret);
+    ASSERT_EQ(ret->get_metadata()->get_column_count(), column_names.size() + 1);
+    harness::ScanStats scan;
+    ASSERT_EQ(E_OK, harness::scan_table_rows(ret, scan, watch));
+    ret->close();
+    ASSERT_EQ(E_OK, reader.close());
+    double query_s = watch.elapsed_s();
+    ASSERT_EQ(scan.rows, param.max_rows);
+    ASSERT_EQ(scan.null_cells, 0);
+
+    long peak_rss = harness::peak_rss_kb();
+    printf("columns=%zu tag=%zu field=%zu rows=%d schema_ms=%.3f fill_ms=%.3f write_ms=%.3f flush_ms=%.3f close_ms=%.3f query_ms=%.3f peak_rss_kb=%ld file_bytes=%llu\n",
+           column_names.size(), param.tag_count, param.field_count, param.max_rows,
+           schema_s * 1000, fill_s * 1000, write_s * 1000, flush_s * 1000, close_s * 1000,
+           query_s * 1000, peak_rss, (unsigned long long)harness::file_size_bytes(table_file_path));
+    RecordProperty("schema_us", static_cast<int>(schema_s * 1e6));
+    RecordProperty("fill_us", static_cast<int>(fill_s * 1e6));
+    RecordProperty("write_us", static_cast<int>(write_s * 1e6));
+    RecordProperty("flush_us", static_cast<int>(flush_s * 1e6));
+    RecordProperty("close_us", static_cast<int>(close_s * 1e6));
+    RecordProperty("query_us", static_cast<int>(query_s * 1e6));
+    RecordProperty("peak_rss_kb", static_cast<int>(peak_rss));
+}
+
+// 列数从 10 到 1 万：FIELD 列多、TAG 列多、单行超宽（原测试6：1000 TAG + 4000 FIELD，1 行）
+INSTANTIATE_TEST_SUITE_P(
+    WideSchemaScaling, TsFileWriterTableWideSchemaTest,
+    ::testing::Values(
+        WideSchemaParam{2, 8, 100},
+        WideSchemaParam{2, 98, 100},
+        WideSchemaParam{2, 998, 100},
+        WideSchemaParam{10, 9990, 100},
+        WideSchemaParam{8, 2, 100},
+        WideSchemaParam{98, 2, 100},
+        WideSchemaParam{998, 2, 100},
+        WideSchemaParam{9990, 10, 100},
+        WideSchemaParam{1000, 4000, 1},
+        WideSchemaParam{2, 4, 10000}),
+    // 用例名为 WideSchemaScaling/TsFileWriterTableWideSchemaTest.TestTsFileTableWriterWideSchema/tag2_field8_rows100 等
+    [](const ::testing::TestParamInfo<WideSchemaParam>& info) {
+        return wide_schema_name(info.param);
+    });
 
 // 测试10：各种编码和压缩方式
 // TEST_F(TsFileWriterTableTest, TestTsFileTableWriter10) {
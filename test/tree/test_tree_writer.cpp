@@ -23,6 +23,9 @@
 #include "writer/tsfile_table_writer.h"
 #include "writer/tsfile_writer.h"
 
+#include "harness/tree_dataset.h"
+#include "harness/value_query.h"
+
 using namespace storage;
 using namespace common;
 using namespace std;
@@ -278,4 +281,203 @@ TEST_F(TsFileWriterTreeTest, WriteTable1) {
 
     // 读取数据进行验证
     reader_tree(path_list, data_types, 0, max_rows, max_rows);
-}
\ No newline at end of file
+}
+
+/**
+ * 测试树模型数据集写入（harness/tree_dataset.h）：多设备、多测点、tablet 拆分，读回验证行数和取值
+ */
+TEST_F(TsFileWriterTreeTest, WriteTreeDataset) {
+    libtsfile_init();
+    harness::TreeDatasetConfig config;
+    config.devices = 50;
+    config.measurements = 20;
+    config.rows_per_device = 300;
+    config.tablet_rows = 128;
+    config.type_name = "MIXED";
+    string dataset_file_path = tree_file_path + ".dataset.tsfile";
+    harness::TreeDatasetStats stats;
+    ASSERT_EQ(harness::write_tree_dataset(dataset_file_path, config, stats), E_OK);
+    ASSERT_EQ(stats.series(config), 1000);
+    ASSERT_EQ(stats.points(config), 300000);
+    ASSERT_GT(stats.file_bytes, 0u);
+    if (harness::AllocCounter::installed()) {
+        // 注册的时间序列和缓存的数据占用堆内存
+        ASSERT_GT(stats.register_allocs.live_bytes, 0);
+        ASSERT_GT(stats.peak_live_bytes, 0u);
+    }
+
+    // 第一个和最后一个设备的 s0（INT64）、s1（INT32），取值为 设备编号 + 时间戳 + 测点编号
+    vector<string> path_list = {"root.db1.d0.s0", "root.db1.d49.s0", "root.db1.d49.s1"};
+    TsFileReader reader;
+    ASSERT_EQ(reader.open(dataset_file_path), E_OK);
+    ResultSet* result_set = nullptr;
+    ASSERT_EQ(reader.query(path_list, INT64_MIN, INT64_MAX, result_set), E_OK);
+    auto* qds = (QDSWithoutTimeGenerator*)result_set;
+    ASSERT_EQ(qds->get_metadata()->get_column_count(), 4u);
+    int64_t rows = 0;
+    bool has_next = false;
+    while (qds->next(has_next) == E_OK && has_next) {
+        int64_t timestamp = qds->get_value<int64_t>(1);
+        ASSERT_EQ(timestamp, rows);
+        ASSERT_EQ(qds->get_value<int64_t>(2), timestamp);
+        ASSERT_EQ(qds->get_value<int64_t>(3), 49 + timestamp);
+        ASSERT_EQ(qds->get_value<int32_t>(4), static_cast<int32_t>(50 + timestamp));
+        rows++;
+    }
+    ASSERT_EQ(rows, config.rows_per_device);
+    reader.destroy_query_data_set(qds);
+    ASSERT_EQ(reader.close(), E_OK);
+    std::filesystem::remove(dataset_file_path);
+}
+
+/**
+ * 测试对齐设备：register_aligned_timeseries + write_tablet_aligned 写入与非对齐相同的数据，
+ * 按设备查询多个测点，读出的行数、空值数和校验和与非对齐文件一致
+ */
+TEST_F(TsFileWriterTreeTest, WriteTreeDatasetAligned) {
+    libtsfile_init();
+    harness::TreeDatasetConfig config;
+    config.devices = 20;
+    config.measurements = 12;
+    config.rows_per_device = 500;
+    config.tablet_rows = 200;
+    config.type_name = "MIXED";
+    string nonaligned_file_path = tree_file_path + ".nonaligned.tsfile";
+    string aligned_file_path = tree_file_path + ".aligned.tsfile";
+    harness::TreeDatasetStats stats;
+    ASSERT_EQ(harness::write_tree_dataset(nonaligned_file_path, config, stats), E_OK);
+    config.aligned = true;
+    ASSERT_EQ(harness::write_tree_dataset(aligned_file_path, config, stats), E_OK);
+    ASSERT_GT(stats.file_bytes, 0u);
+
+    // 每个设备的全部测点、前 3 个测点
+    for (int64_t measurements : {int64_t(0), int64_t(3)}) {
+        harness::TreeReadStats nonaligned;
+        harness::TreeReadStats aligned;
+        ASSERT_EQ(harness::read_tree_dataset(nonaligned_file_path, config, 0, measurements,
+                                             nonaligned), E_OK);
+        ASSERT_EQ(harness::read_tree_dataset(aligned_file_path, config, 0, measurements, aligned),
+                  E_OK);
+        ASSERT_EQ(aligned.queries, config.devices);
+        ASSERT_EQ(aligned.scan.rows, config.devices * config.rows_per_device);
+        ASSERT_EQ(aligned.scan.cells,
+                  aligned.scan.rows * (measurements > 0 ? measurements : config.measurements));
+        ASSERT_EQ(aligned.scan.null_cells, 0);
+        ASSERT_EQ(aligned.scan.rows, nonaligned.scan.rows);
+        ASSERT_EQ(aligned.scan.min_time, nonaligned.scan.min_time);
+        ASSERT_EQ(aligned.scan.max_time, nonaligned.scan.max_time);
+        ASSERT_EQ(aligned.scan.checksum, nonaligned.scan.checksum);
+    }
+
+    // 对齐设备的取值：设备编号 + 时间戳 + 测点编号（s0 为 INT64，s2 为 FLOAT，值乘以 0.5）
+    vector<string> path_list = {"root.db1.d7.s0", "root.db1.d7.s2"};
+    TsFileReader reader;
+    ASSERT_EQ(reader.open(aligned_file_path), E_OK);
+    ResultSet* result_set = nullptr;
+    ASSERT_EQ(reader.query(path_list, INT64_MIN, INT64_MAX, result_set), E_OK);
+    int64_t rows = 0;
+    bool has_next = false;
+    while (result_set->next(has_next) == E_OK && has_next) {
+        int64_t timestamp = result_set->get_value<int64_t>(1);
+        ASSERT_EQ(result_set->get_value<int64_t>(2), 7 + timestamp);
+        ASSERT_FLOAT_EQ(result_set->get_value<float>(3), static_cast<float>(9 + timestamp) * 0.5f);
+        rows++;
+    }
+    ASSERT_EQ(rows, config.rows_per_device);
+    reader.destroy_query_data_set(result_set);
+    ASSERT_EQ(reader.close(), E_OK);
+    std::filesystem::remove(nonaligned_file_path);
+    std::filesystem::remove(aligned_file_path);
+}
+
+// 取值条件查询：条件下推（基于时间生成器的结果集）与客户端过滤的行数一致，且每行都满足条件
+TEST_F(TsFileWriterTreeTest, ValueFilterQuery) {
+    libtsfile_init();
+    harness::TreeDatasetConfig config;
+    config.devices = 2;
+    config.measurements = 3;
+    config.rows_per_device = 5000;
+    config.tablet_rows = 256;
+    config.flush_tablets = 4;
+    config.type_name = "INT64";
+    vector<string> measurements = {"s0", "s1", "s2"};
+
+    // 设备 1 的取值：s0 = 1 + v(t)，s1 = s0 + 1，s2 = s0 + 2
+    for (bool scrambled : {false, true}) {
+        config.scrambled = scrambled;
+        string file_path = tree_file_path + (scrambled ? ".scrambled.tsfile" : ".sorted.tsfile");
+        harness::TreeDatasetStats write_stats;
+        ASSERT_EQ(harness::write_tree_dataset(file_path, config, write_stats), E_OK);
+        string device_id = harness::tree_device_id(config, 1);
+        int64_t multiplier = harness::tree_scramble_multiplier(config);
+
+        // v 的取值范围 [low, low + width)：单个值、1%、10%、全部、空
+        vector<pair<int64_t, int64_t>> ranges = {
+            {2500, 1}, {1000, 50}, {100, 500}, {0, 5000}, {6000, 10}};
+        for (const auto& range : ranges) {
+            int64_t low = range.first;
+            int64_t width = range.second;
+            int64_t expected = max<int64_t>(0, min(low + width, config.rows_per_device) - low);
+            vector<harness::ValuePredicate> predicates = {
+                harness::ValuePredicate::gt_eq("s0", 1 + low),
+                harness::ValuePredicate::lt("s1", 2 + low + width)};
+            if (width == 1) {
+                predicates = {harness::ValuePredicate::eq("s0", 1 + low)};
+            }
+
+            harness::ValueQueryResult pushdown;
+            harness::ValueQueryResult client;
+            ASSERT_EQ(harness::run_value_query(file_path, device_id, measurements, predicates,
+                                               true, pushdown), E_OK);
+            ASSERT_EQ(harness::run_value_query(file_path, device_id, measurements, predicates,
+                                               false, client), E_OK);
+            ASSERT_EQ(pushdown.scan.rows, expected);
+            ASSERT_EQ(pushdown.scan.cells, expected * config.measurements);
+            ASSERT_EQ(client.scan.rows, expected);
+            ASSERT_EQ(client.rows_read, config.rows_per_device);
+            if (expected > 0) {
+                ASSERT_EQ(pushdown.scan.min_time, client.scan.min_time);
+                ASSERT_EQ(pushdown.scan.max_time, client.scan.max_time);
+            }
+
+            // 逐行检查下推查询的结果
+            TsFileReader reader;
+            ASSERT_EQ(reader.open(file_path), E_OK);
+            ResultSet* result_set = nullptr;
+            vector<unique_ptr<Filter>> filters;
+            ASSERT_EQ(harness::query_with_values(reader, device_id, measurements, predicates,
+                                                 result_set, filters), E_OK);
+            int64_t rows = 0;
+            int64_t last_time = INT64_MIN;
+            bool has_next = false;
+            while (result_set->next(has_next) == E_OK && has_next) {
+                int64_t timestamp = result_set->get_value<int64_t>(1);
+                int64_t s0 = result_set->get_value<int64_t>(2);
+                ASSERT_GT(timestamp, last_time);
+                ASSERT_EQ(s0, harness::tree_value(config, multiplier, 1, 0, timestamp));
+                ASSERT_EQ(result_set->get_value<int64_t>(3), s0 + 1);
+                ASSERT_EQ(result_set->get_value<int64_t>(4), s0 + 2);
+                for (const harness::ValuePredicate& predicate : predicates) {
+                    ASSERT_TRUE(predicate.matches(predicate.measurement == "s0" ? s0 : s0 + 1));
+                }
+                last_time = timestamp;
+                rows++;
+            }
+            ASSERT_EQ(rows, expected);
+            reader.destroy_query_data_set(result_set);
+            ASSERT_EQ(reader.close(), E_OK);
+        }
+        std::filesystem::remove(file_path);
+    }
+
+    // 条件中的测点不在查询的测点中
+    harness::ValueQueryResult result;
+    vector<harness::ValuePredicate> predicates = {harness::ValuePredicate::gt("s2", 0)};
+    string file_path = tree_file_path + ".value.tsfile";
+    harness::TreeDatasetStats write_stats;
+    ASSERT_EQ(harness::write_tree_dataset(file_path, config, write_stats), E_OK);
+    ASSERT_EQ(harness::run_value_query(file_path, harness::tree_device_id(config, 0), {"s0", "s1"},
+                                       predicates, false, result),
+              harness::kValueQueryError);
+    std::filesystem::remove(file_path);
+}
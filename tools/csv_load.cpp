@@ -0,0 +1,121 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "harness/bench_util.h"
+#include "harness/csv_load.h"
+
+using namespace common;
+using namespace std;
+
+/**
+ * CSV 批量导入工具：流式读取 CSV 文件，多线程解析并填充 tablet，按文件顺序写入 tsfile 的一张表，
+ * 输出推断的表结构和 rows/s、MB/s（按 CSV 字节数），以及解析、写入耗时和等待时间（判断瓶颈）。
+ *
+ * 参数：
+ *   --input=path                CSV 文件路径（必须指定），第一行为表头
+ *   --output=path               输出的 tsfile 路径，默认为输入路径去掉 .csv 后加 .tsfile
+ *   --table=csv_table           表名
+ *   --delimiter=,               分隔符，tab 表示制表符
+ *   --time-column=name          时间列（整数时间戳），默认为第一列
+ *   --schema=name:TYPE[:TAG],...   指定列的类型和类别，其余列按前 --sample-rows 行推断
+ *   --tags=a,b                  TAG 列，不指定时推断为 STRING 的列作为 TAG 列
+ *   --sample-rows=1000          推断表结构的行数
+ *   --block-kb=8192             每块读取的 KB 数
+ *   --tablet-rows=8192          每个 tablet 的最大行数
+ *   --threads=0                 解析线程数，0 表示 CPU 核数
+ *   --inflight=0                同时存在的块数上限（内存上限），0 表示 2 × 解析线程数 + 2
+ *   --memory-threshold=128      写入器缓存阈值（MB）
+ */
+
+// 解析 --schema 的一项：name:TYPE 或 name:TYPE:TAG / name:TYPE:FIELD
+bool parse_column_spec(const string& spec, harness::CsvColumn& column) {
+    size_t first = spec.find(':');
+    if (first == string::npos || first == 0) {
+        return false;
+    }
+    size_t second = spec.find(':', first + 1);
+    column.name = spec.substr(0, first);
+    string type_name = spec.substr(first + 1, second == string::npos ? string::npos : second - first - 1);
+    column.type = harness::string_to_datatype(type_name);
+    string category = second == string::npos ? "FIELD" : spec.substr(second + 1);
+    if (column.type == TSDataType::INVALID_DATATYPE || (category != "TAG" && category != "FIELD")) {
+        return false;
+    }
+    column.category = category == "TAG" ? ColumnCategory::TAG : ColumnCategory::FIELD;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    string input = args.get_string("input", "");
+    if (input.empty()) {
+        cerr << "usage: " << argv[0]
+             << " --input=file.csv [--output=file.tsfile] [--schema=name:TYPE[:TAG],...]"
+             << " [--tags=a,b] [--threads=N]" << endl;
+        return 1;
+    }
+    string output = args.get_string("output", "");
+    if (output.empty()) {
+        size_t dot = input.rfind(".csv");
+        output = (dot != string::npos && dot + 4 == input.size() ? input.substr(0, dot) : input) +
+                 ".tsfile";
+    }
+
+    harness::CsvLoadConfig config;
+    config.table_name = args.get_string("table", "csv_table");
+    string delimiter = args.get_string("delimiter", ",");
+    config.delimiter = delimiter == "tab" ? '\t' : delimiter.empty() ? ',' : delimiter[0];
+    config.time_column = args.get_string("time-column", "");
+    for (const string& spec : args.get_string_list("schema", {})) {
+        harness::CsvColumn column;
+        if (!parse_column_spec(spec, column)) {
+            cerr << "invalid column spec: " << spec << endl;
+            return 1;
+        }
+        config.columns.push_back(column);
+    }
+    config.tag_columns = args.get_string_list("tags", {});
+    config.sample_rows = args.get_int("sample-rows", 1000);
+    config.block_bytes = static_cast<size_t>(max<int64_t>(1, args.get_int("block-kb", 8192))) * 1024;
+    config.tablet_rows = max<int64_t>(1, args.get_int("tablet-rows", 8192));
+    config.threads = static_cast<int>(args.get_int("threads", 0));
+    config.max_inflight_blocks = static_cast<int>(args.get_int("inflight", 0));
+    config.memory_threshold = args.get_int("memory-threshold", 128) * 1024 * 1024;
+
+    storage::libtsfile_init();
+    harness::CsvLoader loader(config);
+    int ret = loader.open(input);
+    if (ret != E_OK) {
+        cerr << "open " << input << " failed: " << loader.error() << endl;
+        return 1;
+    }
+    printf("input=%s output=%s table=%s\n", input.c_str(), output.c_str(),
+           config.table_name.c_str());
+    for (const harness::CsvColumn& column : loader.columns()) {
+        printf("  column %-24s %-10s %s\n", column.name.c_str(),
+               harness::datatype_to_string(column.type).c_str(),
+               column.category == ColumnCategory::TAG ? "TAG" : "FIELD");
+    }
+
+    harness::CsvLoadStats stats;
+    ret = loader.load(output, stats);
+    if (ret != E_OK) {
+        cerr << "load failed, error code: " << ret << ": " << loader.error() << endl;
+        return 1;
+    }
+    printf("%-12s %-8s %-10s %10s %14s %10s %10s %10s %10s %12s %12s %10s\n", "rows", "threads",
+           "inflight", "total_s", "rows/s", "MB/s", "parse_s", "write_s", "flush_s",
+           "write_wait_s", "read_wait_s", "out_MB");
+    printf("%-12lld %-8d %-10d %10.3f %14.0f %10.2f %10.3f %10.3f %10.3f %12.3f %12.3f %10.2f\n",
+           (long long)stats.rows, stats.threads, stats.max_inflight_blocks, stats.total_s,
+           harness::per_second(stats.rows, stats.total_s),
+           harness::per_second(harness::to_mb(stats.input_bytes), stats.total_s), stats.parse_s,
+           stats.write_s, stats.flush_close_s, stats.write_wait_s, stats.read_wait_s,
+           harness::to_mb(stats.file_bytes));
+    return 0;
+}
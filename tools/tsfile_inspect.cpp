@@ -0,0 +1,256 @@
+#include "common/db_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+
+#include "harness/bench_util.h"
+#include "harness/tsfile_layout.h"
+
+using namespace common;
+using namespace std;
+
+/**
+ * TsFile 物理结构检查工具：顺序解析文件中的 chunk group、chunk、page，
+ * 逐条输出偏移、大小、编码、压缩比和统计信息，最后输出按列汇总、page 大小分布和索引区大小。
+ * 只读取各级头部，内存占用与文件大小无关（按列汇总与列数成正比）。
+ *
+ * 参数：
+ *   --file=path                 tsfile 路径（必须指定）
+ *   --level=chunk               输出明细的级别：summary（只输出汇总）、group、chunk、page
+ */
+
+// 按列汇总
+struct ColumnSummary {
+    string data_type;
+    set<string> encodings;
+    set<string> compressions;
+    uint64_t chunks = 0;
+    uint64_t pages = 0;
+    uint64_t points = 0;
+    uint64_t uncompressed_bytes = 0;
+    uint64_t compressed_bytes = 0;
+    uint64_t header_bytes = 0;   // chunk 头部和已解析 page 的头部
+    uint64_t unparsed_bytes = 0; // 未解析的 page（头部和数据），不计入 bytes/pt
+};
+
+string type_name(uint8_t type) {
+    if (type == TSDataType::VECTOR) {
+        return "VECTOR";
+    }
+    return harness::datatype_to_string(static_cast<TSDataType>(type));
+}
+
+double compression_ratio(uint64_t uncompressed, uint64_t compressed) {
+    return compressed > 0 ? static_cast<double>(uncompressed) / compressed : 0;
+}
+
+double percent(uint64_t part, uint64_t total) {
+    return total > 0 ? 100.0 * part / total : 0;
+}
+
+class InspectVisitor : public harness::LayoutVisitor {
+   public:
+    explicit InspectVisitor(int level) : level_(level) {}
+
+    int on_chunk_group(const harness::LayoutChunkGroup& group) override {
+        chunk_groups_++;
+        tables_.insert(group.table_name);
+        if (level_ >= 1) {
+            printf("chunk_group offset=%llu device=%s\n", (unsigned long long)group.offset,
+                   group.device.c_str());
+        }
+        return E_OK;
+    }
+
+    int on_page(const harness::LayoutChunkGroup&, const harness::LayoutChunk&,
+                const harness::LayoutPage& page) override {
+        page_bytes_[size_bucket(page.compressed_size)]++;
+        page_headers_ += page.header_size;
+        chunk_page_headers_ += page.header_size;
+        if (level_ < 3) {
+            return E_OK;
+        }
+        printf("    page offset=%llu header=%llu uncompressed=%llu compressed=%llu ratio=%.2f",
+               (unsigned long long)page.offset, (unsigned long long)page.header_size,
+               (unsigned long long)page.uncompressed_size, (unsigned long long)page.compressed_size,
+               compression_ratio(page.uncompressed_size, page.compressed_size));
+        if (page.empty) {
+            printf(" empty");
+        }
+        const harness::LayoutStatistics& stats = page.statistics;
+        if (stats.present) {
+            printf(" count=%llu time=[%lld,%lld]", (unsigned long long)stats.count,
+                   (long long)stats.start_time, (long long)stats.end_time);
+            print_value("min", stats.min_value);
+            print_value("max", stats.max_value);
+            print_value("first", stats.first_value);
+            print_value("last", stats.last_value);
+            print_value("sum", stats.sum_value);
+        }
+        printf("\n");
+        return E_OK;
+    }
+
+    int on_chunk(const harness::LayoutChunkGroup& group,
+                 const harness::LayoutChunk& chunk) override {
+        chunks_++;
+        pages_ += chunk.page_count;
+        if (!chunk.pages_parsed) {
+            unparsed_chunks_++;
+        }
+        string column = group.table_name + "." + (chunk.aligned_time ? "(time)" : chunk.measurement);
+        ColumnSummary& summary = columns_[column];
+        summary.data_type = type_name(chunk.data_type);
+        summary.encodings.insert(harness::encoding_to_string(static_cast<TSEncoding>(chunk.encoding)));
+        summary.compressions.insert(
+            harness::compression_to_string(static_cast<CompressionType>(chunk.compression)));
+        summary.chunks++;
+        summary.pages += chunk.page_count;
+        summary.points += chunk.point_count;
+        summary.uncompressed_bytes += chunk.uncompressed_bytes;
+        summary.compressed_bytes += chunk.compressed_bytes;
+        // 已解析 page 的头部和数据之外的部分为未解析的 page，其点数未知，单独统计
+        uint64_t parsed_bytes = chunk_page_headers_ + chunk.compressed_bytes;
+        summary.header_bytes += chunk.header_size + chunk_page_headers_;
+        summary.unparsed_bytes += chunk.data_size > parsed_bytes ? chunk.data_size - parsed_bytes : 0;
+        chunk_page_headers_ = 0;
+        if (level_ >= 2) {
+            printf("  chunk offset=%llu size=%llu measurement=%s type=%s encoding=%s "
+                   "compression=%s pages=%llu points=%llu uncompressed=%llu compressed=%llu "
+                   "ratio=%.2f%s%s%s\n",
+                   (unsigned long long)chunk.offset,
+                   (unsigned long long)(chunk.header_size + chunk.data_size),
+                   chunk.aligned_time ? "(time)" : chunk.measurement.c_str(),
+                   summary.data_type.c_str(),
+                   harness::encoding_to_string(static_cast<TSEncoding>(chunk.encoding)).c_str(),
+                   harness::compression_to_string(static_cast<CompressionType>(chunk.compression))
+                       .c_str(),
+                   (unsigned long long)chunk.page_count, (unsigned long long)chunk.point_count,
+                   (unsigned long long)chunk.uncompressed_bytes,
+                   (unsigned long long)chunk.compressed_bytes,
+                   compression_ratio(chunk.uncompressed_bytes, chunk.compressed_bytes),
+                   chunk.aligned_time ? " aligned_time" : "",
+                   chunk.aligned_value ? " aligned_value" : "",
+                   chunk.pages_parsed ? "" : " pages_unparsed");
+        }
+        return E_OK;
+    }
+
+    int on_metadata(const harness::LayoutMetadata& metadata) override {
+        metadata_ = metadata;
+        return E_OK;
+    }
+
+    void print_summary() const {
+        uint64_t file_size = metadata_.file_size;
+        printf("\n== summary ==\n");
+        printf("tables=%zu chunk_groups=%llu chunks=%llu pages=%llu unparsed_chunks=%llu\n",
+               tables_.size(), (unsigned long long)chunk_groups_, (unsigned long long)chunks_,
+               (unsigned long long)pages_, (unsigned long long)unparsed_chunks_);
+        printf("data=%llu (%.1f%%) index=%llu (%.1f%%) tsfile_metadata=%llu (%.1f%%) file=%llu\n",
+               (unsigned long long)metadata_.data_end, percent(metadata_.data_end, file_size),
+               (unsigned long long)metadata_.index_size, percent(metadata_.index_size, file_size),
+               (unsigned long long)metadata_.tsfile_metadata_size,
+               percent(metadata_.tsfile_metadata_size, file_size), (unsigned long long)file_size);
+
+        printf("\n== columns ==\n");
+        printf("%-32s %-10s %-12s %-14s %8s %8s %12s %14s %14s %8s %10s %12s\n", "column", "type",
+               "encoding", "compression", "chunks", "pages", "points", "uncompressed",
+               "compressed", "ratio", "bytes/pt", "unparsed_B");
+        for (const auto& entry : columns_) {
+            const ColumnSummary& s = entry.second;
+            printf("%-32s %-10s %-12s %-14s %8llu %8llu %12llu %14llu %14llu %8.2f %10.3f %12llu\n",
+                   entry.first.c_str(), s.data_type.c_str(), join(s.encodings).c_str(),
+                   join(s.compressions).c_str(), (unsigned long long)s.chunks,
+                   (unsigned long long)s.pages, (unsigned long long)s.points,
+                   (unsigned long long)s.uncompressed_bytes,
+                   (unsigned long long)s.compressed_bytes,
+                   compression_ratio(s.uncompressed_bytes, s.compressed_bytes),
+                   s.points > 0 ? static_cast<double>(s.compressed_bytes + s.header_bytes) / s.points
+                                : 0,
+                   (unsigned long long)s.unparsed_bytes);
+        }
+
+        printf("\n== page size (compressed) ==\n");
+        for (const auto& bucket : page_bytes_) {
+            if (bucket.first == 0) {
+                printf("empty: %llu\n", (unsigned long long)bucket.second);
+                continue;
+            }
+            printf("[%lluB,%lluB): %llu\n", (unsigned long long)bucket.first,
+                   (unsigned long long)bucket.first * 2, (unsigned long long)bucket.second);
+        }
+        printf("page_header_bytes=%llu\n", (unsigned long long)page_headers_);
+    }
+
+   private:
+    static void print_value(const char* name, const string& value) {
+        if (!value.empty()) {
+            printf(" %s=%s", name, value.c_str());
+        }
+    }
+
+    // 所在的 2 的幂区间的下界，0 字节（全空的 page）为 0
+    static uint64_t size_bucket(uint64_t size) {
+        if (size == 0) {
+            return 0;
+        }
+        uint64_t bucket = 1;
+        while (bucket * 2 <= size) {
+            bucket *= 2;
+        }
+        return bucket;
+    }
+
+    static string join(const set<string>& values) {
+        string result;
+        for (const auto& value : values) {
+            result += (result.empty() ? "" : "|") + value;
+        }
+        return result;
+    }
+
+    int level_;
+    uint64_t chunk_groups_ = 0;
+    uint64_t chunks_ = 0;
+    uint64_t pages_ = 0;
+    uint64_t unparsed_chunks_ = 0;
+    uint64_t page_headers_ = 0;
+    uint64_t chunk_page_headers_ = 0;   // 当前 chunk 已解析 page 的头部大小（on_page 在 on_chunk 之前调用）
+    set<string> tables_;
+    map<string, ColumnSummary> columns_;
+    map<uint64_t, uint64_t> page_bytes_;
+    harness::LayoutMetadata metadata_;
+};
+
+int main(int argc, char** argv) {
+    harness::BenchArgs args(argc, argv);
+    string file_path = args.get_string("file", "");
+    string level_name = args.get_string("level", "chunk");
+    const map<string, int> levels = {{"summary", 0}, {"group", 1}, {"chunk", 2}, {"page", 3}};
+    if (file_path.empty() || levels.count(level_name) == 0) {
+        cerr << "usage: " << argv[0] << " --file=path [--level=summary|group|chunk|page]" << endl;
+        return 1;
+    }
+
+    harness::TsFileLayoutReader reader;
+    int ret = reader.open(file_path);
+    if (ret != E_OK) {
+        cerr << "open " << file_path << " failed, error code: " << ret << endl;
+        return 1;
+    }
+    printf("file=%s size=%llu version=%u\n", file_path.c_str(),
+           (unsigned long long)reader.file_size(), (unsigned)reader.version());
+    InspectVisitor visitor(levels.at(level_name));
+    ret = reader.scan(visitor);
+    if (ret != E_OK) {
+        cerr << "parse failed: " << reader.error_message() << endl;
+        return 1;
+    }
+    visitor.print_summary();
+    return 0;
+}